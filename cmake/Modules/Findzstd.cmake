@@ -0,0 +1,6 @@
+include(ToolchainLibraryFinder)
+ToolchainLibraryFinder(
+  NAME zstd
+  HEADER zstd.h
+  LIBRARY zstd
+)
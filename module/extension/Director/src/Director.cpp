@@ -27,8 +27,12 @@
 
 #include "Director.hpp"
 
+#include <fmt/format.h>
+
 #include "extension/Configuration.hpp"
 
+#include "message/support/nuclear/DirectorStats.hpp"
+
 namespace module::extension {
 
     using component::DirectorTask;
@@ -42,6 +46,7 @@ namespace module::extension {
     using ::extension::behaviour::commands::ProviderDone;
     using ::extension::behaviour::commands::ProvideReaction;
     using ::extension::behaviour::commands::WhenExpression;
+    using message::support::nuclear::DirectorStats;
     using Unbind = NUClear::dsl::operation::Unbind<ProvideReaction>;
 
 
@@ -64,6 +69,9 @@ namespace module::extension {
         int state;
     };
 
+    /// This message gets emitted when a task pack is pushed onto an empty queue to have the queue drained as a batch
+    struct RunTaskPacks {};
+
     void Director::add_provider(const ProvideReaction& provide) {
 
         // Create if it doesn't already exist
@@ -282,7 +290,7 @@ namespace module::extension {
                 // Modify the task we received to look like it came from this provider
                 task->requester_id = root_provider->id;
 
-                emit(std::make_unique<TaskPack>(TaskPack(root_provider, {task})));
+                queue_task_pack(TaskPack(root_provider, {task}));
             }
             else {
                 auto& p = providers.at(task->requester_id);
@@ -312,21 +320,21 @@ namespace module::extension {
         on<Trigger<ProviderDone>>().then("Package Tasks", [this](const ProviderDone& done) {
             std::lock_guard<std::recursive_mutex> lock(director_mutex);
             // Get all the tasks that were emitted by this provider and send it as a task pack
-            auto range  = pack_builder.equal_range(done.requester_task_id);
-            auto pack   = std::make_unique<TaskPack>();
-            pack->first = providers.at(done.requester_id);
+            auto range = pack_builder.equal_range(done.requester_task_id);
+            TaskPack pack;
+            pack.first = providers.at(done.requester_id);
             for (auto it = range.first; it != range.second; ++it) {
-                pack->second.push_back(it->second);
+                pack.second.push_back(it->second);
             }
 
             // Sort the task pack so highest priority tasks come first
             // We sort by direct priority not challenge priority since they're all the same pack
-            std::stable_sort(pack->second.rbegin(), pack->second.rend(), [](const auto& a, const auto& b) {
+            std::stable_sort(pack.second.rbegin(), pack.second.rend(), [](const auto& a, const auto& b) {
                 return direct_priority(a, b);
             });
 
-            // Emit the task pack
-            emit(pack);
+            // Queue the task pack to be run in the next batch
+            queue_task_pack(pack);
 
             // Erase the task pack builder for this id
             pack_builder.erase(done.requester_task_id);
@@ -343,13 +351,53 @@ namespace module::extension {
             reevaluate_group(g);
         });
 
-        // We have a new task pack to run
-        on<Trigger<TaskPack>>().then("Run Task Pack", [this](const TaskPack& pack) {  //
+        // There are task packs on the queue, run everything that has been queued since the last batch
+        on<Trigger<RunTaskPacks>>().then("Run Task Packs", [this] {
             std::lock_guard<std::recursive_mutex> lock(director_mutex);
-            run_task_pack(pack);
+            run_task_packs();
+        });
+
+        on<Every<1, std::chrono::seconds>>().then("Queue Stats", [this] {
+            std::lock_guard<std::recursive_mutex> director_lock(director_mutex);
+            std::lock_guard<std::mutex> queue_lock(pack_queue_mutex);
+
+            if (queue_stats.queued > 0) {
+                log<NUClear::DEBUG>(fmt::format("Queued {}/s, Coalesced {}/s, Batches {}/s, Max Depth {}, Max Batch {}",
+                                                queue_stats.queued,
+                                                queue_stats.coalesced,
+                                                queue_stats.batches,
+                                                queue_stats.max_depth,
+                                                queue_stats.max_batch));
+
+                auto stats       = std::make_unique<DirectorStats>();
+                stats->queued    = queue_stats.queued;
+                stats->coalesced = queue_stats.coalesced;
+                stats->batches   = queue_stats.batches;
+                stats->max_depth = queue_stats.max_depth;
+                stats->max_batch = queue_stats.max_batch;
+                emit(stats);
+            }
+            queue_stats = {};
         });
     }
 
+    void Director::queue_task_pack(const TaskPack& pack) {
+        bool first = false;
+        /* Mutex Scope */ {
+            std::lock_guard<std::mutex> lock(pack_queue_mutex);
+            first = pack_queue.empty();
+            pack_queue.push_back(pack);
+            ++queue_stats.queued;
+            queue_stats.max_depth = std::max(queue_stats.max_depth, int(pack_queue.size()));
+        }
+
+        // Only the first pack onto an empty queue needs to ask for a batch to be run, packs that arrive before that
+        // batch starts will be run as a part of it
+        if (first) {
+            emit(std::make_unique<RunTaskPacks>());
+        }
+    }
+
     Director::~Director() {
         // Remove this director as the information source
         source = nullptr;
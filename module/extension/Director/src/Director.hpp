@@ -407,6 +407,32 @@ namespace module::extension {
          */
         void run_task_pack(const TaskPack& pack);
 
+        /**
+         * Pushes a task pack onto the queue to be run in the next batch.
+         *
+         * If the queue was empty this will emit a message to have the queue drained. Any packs that are queued before
+         * that runs will be drained in the same batch.
+         *
+         * @param pack the task pack to queue
+         */
+        void queue_task_pack(const TaskPack& pack);
+
+        /**
+         * Drains the queue of pending task packs and runs them as a single batch.
+         *
+         * Any thread can push a task pack onto the queue, but only the thread that holds the director mutex will drain
+         * it. Threads that arrive while another thread is draining will find their pack has already been run once they
+         * acquire the mutex. Within a batch, if a provider has emitted a newer pack of regular tasks then its older
+         * packs are dropped as they would immediately be replaced. Packs containing `Idle` or `Done` are never
+         * coalesced as they change the state of the provider group rather than replacing its tasks.
+         *
+         * When more than one pack runs in a batch, the groups whose tasks were displaced are reevaluated once at the
+         * end of the batch rather than after each pack.
+         *
+         * Must be called while holding the director mutex.
+         */
+        void run_task_packs();
+
         /**
          * A RunReasonLock instance will reset the current_run_reason back to OTHER_TRIGGER when it is destroyed.
          *
@@ -480,6 +506,30 @@ namespace module::extension {
         /// all these as a pack so that the director can work out when Providers change which subtasks they emit
         std::multimap<uint64_t, std::shared_ptr<component::DirectorTask>> pack_builder;
 
+        /// Task packs that are waiting to be run. Any reaction can push to this while holding only the queue mutex,
+        /// and it is drained by whichever reaction holds the director mutex
+        std::mutex pack_queue_mutex{};
+        std::vector<TaskPack> pack_queue;
+
+        /// True while a batch of more than one task pack is running, so displaced tasks are reevaluated at its end
+        bool batching = false;
+        /// Tasks that were displaced while running the current batch and need their groups reevaluated
+        TaskList batch_displaced;
+
+        /// Statistics about how the task pack queue is being used, reset each time they are logged
+        struct {
+            /// Number of task packs that have been pushed onto the queue
+            int queued = 0;
+            /// Number of task packs that were dropped as a newer pack from the same provider was in the same batch
+            int coalesced = 0;
+            /// Number of batches that have been drained from the queue
+            int batches = 0;
+            /// The largest depth the queue has reached
+            int max_depth = 0;
+            /// The largest number of packs that were run in a single batch
+            int max_batch = 0;
+        } queue_stats;
+
     public:
         friend class InformationSource;
     };
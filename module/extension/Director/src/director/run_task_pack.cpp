@@ -130,14 +130,20 @@ namespace module::extension {
                     }
                 }
 
-                // Sort the tasks so we reevaluate them in priority order
-                std::sort(displaced_tasks.begin(), displaced_tasks.end(), [this](const auto& a, const auto& b) {
-                    return !challenge_priority(a, b);
-                });
-
-                for (const auto& t : displaced_tasks) {
-                    // Everyone we displaced needs to be reevaluated
-                    reevaluate_group(providers.at(t->requester_id)->group);
+                // If we are part of a batch, the displaced groups are reevaluated once the whole batch has run
+                if (batching) {
+                    batch_displaced.insert(batch_displaced.end(), displaced_tasks.begin(), displaced_tasks.end());
+                }
+                else {
+                    // Sort the tasks so we reevaluate them in priority order
+                    std::sort(displaced_tasks.begin(), displaced_tasks.end(), [this](const auto& a, const auto& b) {
+                        return !challenge_priority(a, b);
+                    });
+
+                    for (const auto& t : displaced_tasks) {
+                        // Everyone we displaced needs to be reevaluated
+                        reevaluate_group(providers.at(t->requester_id)->group);
+                    }
                 }
 
                 // Accumulate all the used types
@@ -0,0 +1,108 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <set>
+#include <typeindex>
+
+#include "Director.hpp"
+
+#include "extension/Behaviour.hpp"
+
+namespace module::extension {
+
+    void Director::run_task_packs() {
+
+        // Keep going until nothing new has been queued while we were running the last batch
+        while (true) {
+            std::vector<TaskPack> batch;
+            /* Mutex Scope */ {
+                std::lock_guard<std::mutex> lock(pack_queue_mutex);
+                std::swap(batch, pack_queue);
+            }
+
+            if (batch.empty()) {
+                return;
+            }
+
+            // A regular pack is one which replaces the tasks of the provider, rather than changing its state
+            auto regular = [](const TaskPack& pack) {
+                return std::none_of(pack.second.begin(), pack.second.end(), [](const auto& t) {
+                    return t->type == typeid(::extension::behaviour::Idle)
+                           || t->type == typeid(::extension::behaviour::Done);
+                });
+            };
+
+            // Walk backwards through the batch to find packs that are superseded by a later regular pack from the same
+            // provider. If the next pack from a provider is a regular pack then this pack would be replaced straight
+            // away, so there is no point reevaluating the tree for it
+            std::vector<bool> superseded(batch.size(), false);
+            std::map<uint64_t, bool> next_regular;
+            for (int i = int(batch.size()) - 1; i >= 0; --i) {
+                const auto& pack = batch[i];
+                bool is_regular  = regular(pack);
+                auto it          = next_regular.find(pack.first->id);
+                superseded[i]    = is_regular && it != next_regular.end() && it->second;
+                next_regular[pack.first->id] = is_regular;
+            }
+
+            // Run the surviving packs in the order they arrived
+            // If there is more than one, hold off reevaluating displaced groups until they have all run
+            int ran  = 0;
+            batching = std::count(superseded.begin(), superseded.end(), false) > 1;
+            for (int i = 0; i < int(batch.size()); ++i) {
+                if (!superseded[i]) {
+                    run_task_pack(batch[i]);
+                    ++ran;
+                }
+            }
+            batching = false;
+
+            // Reevaluate each of the displaced groups once, in priority order
+            TaskList displaced;
+            std::swap(displaced, batch_displaced);
+            std::sort(displaced.begin(), displaced.end(), [this](const auto& a, const auto& b) {
+                return !challenge_priority(a, b);
+            });
+            std::set<std::type_index> reevaluated;
+            for (const auto& t : displaced) {
+                // The provider that requested this task may have been removed while the batch was running
+                auto it = providers.find(t->requester_id);
+                if (it != providers.end() && reevaluated.insert(it->second->group.type).second) {
+                    reevaluate_group(it->second->group);
+                }
+            }
+
+            ++queue_stats.batches;
+            queue_stats.coalesced += int(batch.size()) - ran;
+            queue_stats.max_batch = std::max(queue_stats.max_batch, ran);
+        }
+    }
+
+}  // namespace module::extension
@@ -0,0 +1,109 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <nuclear>
+
+#include "Director.hpp"
+#include "TestBase.hpp"
+#include "util/diff_string.hpp"
+
+// Anonymous namespace to avoid name collisions
+namespace {
+
+    template <int N>
+    struct SimpleTask {
+        SimpleTask(const std::string& msg_) : msg(msg_) {}
+        std::string msg;
+    };
+
+    std::vector<std::string> events;
+
+    class TestReactor : public TestBase<TestReactor> {
+    public:
+        explicit TestReactor(std::unique_ptr<NUClear::Environment> environment)
+            : TestBase<TestReactor>(std::move(environment)) {
+
+            on<Provide<SimpleTask<1>>>().then([this](const SimpleTask<1>& t) {  //
+                events.push_back("task 1 " + t.msg);
+            });
+
+            on<Provide<SimpleTask<2>>>().then([this](const SimpleTask<2>& t) {  //
+                events.push_back("task 2 " + t.msg);
+            });
+
+            /**************
+             * TEST STEPS *
+             **************/
+            on<Trigger<Step<1>>, Priority::LOW>().then([this] {
+                // Both of these packs come from the same root provider and are queued together, so the first is
+                // replaced before it is ever run
+                events.push_back("emitting task 1 twice");
+                emit<Task>(std::make_unique<SimpleTask<1>>("first"));
+                emit<Task>(std::make_unique<SimpleTask<1>>("second"));
+            });
+
+            on<Trigger<Step<2>>, Priority::LOW>().then([this] {
+                // These packs come from different root providers so while they are run in one batch neither replaces
+                // the other
+                events.push_back("emitting task 1 and task 2");
+                emit<Task>(std::make_unique<SimpleTask<1>>("third"));
+                emit<Task>(std::make_unique<SimpleTask<2>>("fourth"));
+            });
+
+            on<Startup>().then([this] {
+                emit(std::make_unique<Step<1>>());
+                emit(std::make_unique<Step<2>>());
+            });
+        }
+    };
+}  // namespace
+
+TEST_CASE("Test that only the latest task pack from a provider is run when packs are queued together",
+          "[director][coalesce]") {
+
+    NUClear::Configuration config;
+    config.thread_count = 1;
+    NUClear::PowerPlant powerplant(config);
+    powerplant.install<module::extension::Director>();
+    powerplant.install<TestReactor>();
+    powerplant.start();
+
+    std::vector<std::string> expected = {
+        "emitting task 1 twice",
+        "task 1 second",
+        "emitting task 1 and task 2",
+        "task 1 third",
+        "task 2 fourth",
+    };
+
+    // Make an info print the diff in an easy to read way if we fail
+    INFO(util::diff_string(expected, events));
+
+    // Check the events fired in order and only those events
+    REQUIRE(events == expected);
+}
@@ -26,18 +26,22 @@
  */
 #include "ImageDecompressor.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <fmt/format.h>
 
 #include "decompressor/turbojpeg/Factory.hpp"
 
 #include "extension/Configuration.hpp"
 
+#include "message/input/DecompressionStats.hpp"
 #include "message/input/Image.hpp"
 #include "message/output/CompressedImage.hpp"
 
 namespace module::input {
 
     using extension::Configuration;
+    using message::input::DecompressionStats;
     using message::input::Image;
     using message::output::CompressedImage;
 
@@ -58,6 +62,15 @@ namespace module::input {
                                                   c["concurrent"].as<int>());
                 }
             }
+
+            config.outputs.clear();
+            for (const auto& o : cfg["outputs"].config) {
+                const int scale = o["scale"].as<int>();
+                if (scale != 1 && scale != 2 && scale != 4 && scale != 8) {
+                    throw std::runtime_error(fmt::format("Output scale {} is not one of 1, 2, 4 or 8", scale));
+                }
+                config.outputs.push_back(Output{scale, o["cameras"].as<std::vector<std::string>>()});
+            }
         });
 
         on<Trigger<CompressedImage>>().then("Decompress Image", [this](const CompressedImage& image) {
@@ -94,46 +107,103 @@ namespace module::input {
                 // Attempt to acquire a lock on the mutex, if this succeeds then the context wasn't being used
                 std::unique_lock lock(*ctx.mutex, std::try_to_lock);
                 if (lock) {
+                    int decompressed  = 0;
+                    double decode_sum = 0.0;
+                    double decode_max = 0.0;
+
+                    // Decode the image once for each output that wants this camera
+                    for (const auto& output : config.outputs) {
+                        if (!output.cameras.empty()
+                            && std::find(output.cameras.begin(), output.cameras.end(), image.name)
+                                   == output.cameras.end()) {
+                            continue;
+                        }
 
-                    auto msg = std::make_unique<Image>();
-
-                    // Compress the data
-                    auto result = ctx.decompressor->decompress(image.data);
-                    msg->data   = result.first;
-                    msg->format = result.second;
-
-                    // Copy across the other attributes
-                    msg->dimensions        = image.dimensions;
-                    msg->id                = image.id;
-                    msg->name              = image.name;
-                    msg->timestamp         = image.timestamp;
-                    msg->Hcw               = image.Hcw;
-                    msg->lens.projection   = int(image.lens.projection);
-                    msg->lens.focal_length = image.lens.focal_length;
-                    msg->lens.fov          = image.lens.fov;
-                    msg->lens.centre       = image.lens.centre;
-                    msg->lens.k            = image.lens.k;
-
-                    // Emit the compressed image
-                    emit(msg);
+                        auto msg = std::make_unique<Image>();
+
+                        // Decompress the data straight into the message
+                        const auto start  = NUClear::clock::now();
+                        const auto result = ctx.decompressor->decompress(image.data, output.scale, msg->data);
+                        const double decode_time =
+                            std::chrono::duration<double, std::milli>(NUClear::clock::now() - start).count();
+                        msg->format     = result.format;
+                        msg->dimensions = Eigen::Matrix<unsigned int, 2, 1>(result.width, result.height);
+
+                        // Copy across the other attributes, the lens is normalised to the image width so it holds
+                        // for every scale
+                        msg->id                = image.id;
+                        msg->name              = image.name;
+                        msg->timestamp         = image.timestamp;
+                        msg->Hcw               = image.Hcw;
+                        msg->lens.projection   = int(image.lens.projection);
+                        msg->lens.focal_length = image.lens.focal_length;
+                        msg->lens.fov          = image.lens.fov;
+                        msg->lens.centre       = image.lens.centre;
+                        msg->lens.k            = image.lens.k;
+
+                        // Emit the decompressed image
+                        emit(msg);
+
+                        ++decompressed;
+                        decode_sum += decode_time;
+                        decode_max = std::max(decode_max, decode_time);
+                    }
 
                     // Successful decompression!
-                    ++decompressed;
+                    std::lock_guard<std::mutex> stats_lock(stats_mutex);
+                    CameraStats& camera = stats[image.id];
+                    camera.name         = image.name;
+                    ++camera.received;
+                    camera.decompressed += decompressed;
+                    camera.decode_sum += decode_sum;
+                    camera.decode_max = std::max(camera.decode_max, decode_max);
+                    camera.bytes += image.data.size();
                     return;
                 }
             }
+
             // We failed to decompress this image
-            ++dropped;
+            std::lock_guard<std::mutex> stats_lock(stats_mutex);
+            CameraStats& camera = stats[image.id];
+            camera.name         = image.name;
+            ++camera.received;
+            ++camera.dropped;
+            camera.bytes += image.data.size();
         });
 
         on<Every<1, std::chrono::seconds>>().then("Stats", [this] {
-            log<NUClear::DEBUG>(fmt::format("Receiving {}/s, Decompressing {}/s,  Dropping {}/s ({}%)",
-                                            decompressed + dropped,
-                                            decompressed,
-                                            dropped,
-                                            100 * double(decompressed) / double(decompressed + dropped)));
-            decompressed = 0;
-            dropped      = 0;
+            auto msg    = std::make_unique<DecompressionStats>();
+            msg->period = 1.0;
+
+            /* Mutex Scope */ {
+                std::lock_guard<std::mutex> lock(stats_mutex);
+                for (auto& [id, camera] : stats) {
+                    DecompressionStats::Camera s;
+                    s.id               = id;
+                    s.name             = camera.name;
+                    s.received         = camera.received;
+                    s.decompressed     = camera.decompressed;
+                    s.dropped          = camera.dropped;
+                    s.mean_decode_time = camera.decompressed > 0 ? camera.decode_sum / camera.decompressed : 0.0;
+                    s.max_decode_time  = camera.decode_max;
+                    s.bytes            = camera.bytes;
+                    msg->cameras.push_back(s);
+
+                    log<NUClear::DEBUG>(fmt::format("{}: Receiving {}/s, Decompressing {}/s, Dropping {}/s, "
+                                                    "Decode time {:.2f}ms (max {:.2f}ms)",
+                                                    camera.name,
+                                                    camera.received,
+                                                    camera.decompressed,
+                                                    camera.dropped,
+                                                    s.mean_decode_time,
+                                                    s.max_decode_time));
+
+                    // Reset for the next period
+                    camera = CameraStats{camera.name};
+                }
+            }
+
+            emit(msg);
         });
     }
 
@@ -28,9 +28,12 @@
 #define MODULE_INPUT_IMAGEDECOMPRESSOR_HPP
 
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <nuclear>
+#include <string>
+#include <vector>
 
 #include "decompressor/DecompressorFactory.hpp"
 
@@ -55,6 +58,25 @@ namespace module::input {
             uint32_t format{};
         };
 
+        /// An image stream to produce from the compressed images
+        struct Output {
+            /// The images are decoded at 1/scale of their width and height, one of 1, 2, 4 or 8
+            int scale = 1;
+            /// Names of the cameras this output is made for, all cameras if empty
+            std::vector<std::string> cameras;
+        };
+
+        /// Statistics for one camera since the last report
+        struct CameraStats {
+            std::string name;
+            int received      = 0;
+            int decompressed  = 0;
+            int dropped       = 0;
+            double decode_sum = 0.0;
+            double decode_max = 0.0;
+            uint64_t bytes    = 0;
+        };
+
     public:
         /// @brief Called by the powerplant to build and setup the ImageDecompressor reactor.
         explicit ImageDecompressor(std::unique_ptr<NUClear::Environment> environment);
@@ -63,16 +85,17 @@ namespace module::input {
         struct {
             /// The decompressor factories that will be used to create a decompression context
             std::vector<std::pair<std::shared_ptr<decompressor::DecompressorFactory>, int>> factories;
+            /// The image streams to produce from each compressed image
+            std::vector<Output> outputs;
         } config;
 
         /// The decompressors that are available for use
         std::mutex decompressor_mutex;
         std::map<uint32_t, std::shared_ptr<DecompressorContext>> decompressors;
 
-        /// Number of images that have been decompressed since this was last reset
-        int decompressed = 0;
-        /// Number of images that have been dropped since this was last reset
-        int dropped = 0;
+        /// Statistics for each camera id since they were last reported
+        std::mutex stats_mutex;
+        std::map<uint32_t, CameraStats> stats;
     };
 
 }  // namespace module::input
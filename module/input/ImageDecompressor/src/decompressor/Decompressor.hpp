@@ -32,6 +32,16 @@
 
 namespace module::input::decompressor {
 
+    /// The shape of a decompressed image
+    struct Result {
+        /// Width of the decompressed image in pixels
+        uint32_t width;
+        /// Height of the decompressed image in pixels
+        uint32_t height;
+        /// The fourcc code of the decompressed image
+        uint32_t format;
+    };
+
     class Decompressor {
     public:
         Decompressor()                                   = default;
@@ -41,7 +51,16 @@ namespace module::input::decompressor {
         Decompressor& operator=(const Decompressor&)     = default;
         Decompressor& operator=(Decompressor&&) noexcept = default;
 
-        virtual std::pair<std::vector<uint8_t>, int> decompress(const std::vector<uint8_t>& data) = 0;
+        /**
+         * @brief Decompresses an image into the given buffer, which is resized to fit it
+         *
+         * @param data   the compressed image
+         * @param scale  the image is decoded at 1/scale of its width and height, one of 1, 2, 4 or 8
+         * @param output the buffer to decode into
+         *
+         * @return the size and format of the decompressed image
+         */
+        virtual Result decompress(const std::vector<uint8_t>& data, int scale, std::vector<uint8_t>& output) = 0;
     };
 
 }  // namespace module::input::decompressor
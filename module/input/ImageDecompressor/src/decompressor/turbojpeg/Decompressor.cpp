@@ -58,13 +58,13 @@ namespace module::input::decompressor::turbojpeg {
     Decompressor::Decompressor(const uint32_t& width, const uint32_t& height, const uint32_t& format)
         : output_fourcc(decompressed_format(format)) {
 
-        // If this is a mosaic format, build a mosaic table
+        // If this is a mosaic format, build a mosaic table for full resolution, other scales are built when needed
         if (utility::vision::Mosaic::size(output_fourcc) > 1) {
-            mosaic = utility::vision::Mosaic(width, height, output_fourcc);
+            mosaics.emplace(1, utility::vision::Mosaic(width, height, output_fourcc));
         }
     }
 
-    std::pair<std::vector<uint8_t>, int> Decompressor::decompress(const std::vector<uint8_t>& data) {
+    Result Decompressor::decompress(const std::vector<uint8_t>& data, int scale, std::vector<uint8_t>& output) {
 
         static thread_local tjhandle decompressor = tjInitDecompress();
 
@@ -78,24 +78,44 @@ namespace module::input::decompressor::turbojpeg {
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
         tjDecompressHeader2(decompressor, const_cast<uint8_t*>(data.data()), data.size(), &width, &height, &subsamp);
 
+        // Each separated part of a mosaic must shrink to a whole number of pixels, so halve the scale until it does
+        const bool mosaic = !mosaics.empty();
+        const int factor  = utility::vision::Mosaic::size(output_fourcc);
+        while (scale > 1 && ((width / factor) % scale != 0 || (height / factor) % scale != 0)) {
+            scale /= 2;
+        }
+
+        // Turbojpeg scales in the DCT domain, so a smaller image is also a cheaper one to decode
+        const tjscalingfactor scaling{1, scale};
+        const int scaled_width  = TJSCALED(width, scaling);
+        const int scaled_height = TJSCALED(height, scaling);
+
         // Work out what we decode as
-        TJPF code = mosaic || subsamp == TJSAMP::TJSAMP_GRAY ? TJPF::TJPF_GRAY : TJPF::TJPF_RGB;
+        TJPF code         = mosaic || subsamp == TJSAMP::TJSAMP_GRAY ? TJPF::TJPF_GRAY : TJPF::TJPF_RGB;
+        const size_t size = size_t(scaled_width) * size_t(scaled_height) * (code == TJPF::TJPF_GRAY ? 1 : 3);
 
-        // Decode the image
-        std::vector<uint8_t> output(width * height * (code == TJPF::TJPF_GRAY ? 1 : 3));
+        // A mosaic is decoded into the scratch buffer so it can be unpermuted into the output in one pass, anything
+        // else is decoded straight into the output
+        std::vector<uint8_t>& target = mosaic ? scratch : output;
+        target.resize(size);
         tjDecompress2(decompressor,
                       data.data(),
                       data.size(),
-                      output.data(),
-                      width,
+                      target.data(),
+                      scaled_width,
                       0 /*pitch*/,
-                      height,
+                      scaled_height,
                       code,
                       TJFLAG_FASTDCT);
 
         // If we were a mosaic then permute it back
         if (mosaic) {
-            output = mosaic.unpermute(output);
+            auto it = mosaics.find(scale);
+            if (it == mosaics.end()) {
+                it = mosaics.emplace(scale, utility::vision::Mosaic(scaled_width, scaled_height, output_fourcc)).first;
+            }
+            output.resize(size);
+            it->second.unpermute(scratch.data(), output.data());
         }
 
         // Work out what the fourcc of the image should be
@@ -104,7 +124,7 @@ namespace module::input::decompressor::turbojpeg {
                 ? subsamp == TJSAMP::TJSAMP_GRAY ? utility::vision::fourcc("GREY") : utility::vision::fourcc("RGB3")
                 : output_fourcc;
 
-        return std::make_pair(output, fourcc);
+        return Result{uint32_t(scaled_width), uint32_t(scaled_height), fourcc};
     }
 
 }  // namespace module::input::decompressor::turbojpeg
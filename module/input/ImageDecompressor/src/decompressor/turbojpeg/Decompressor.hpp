@@ -26,6 +26,8 @@
  */
 #ifndef MODULE_INPUT_IMAGEDECOMPRESSOR_DECOMPRESSOR_TURBOJPEG_DECOMPRESSOR_HPP
 #define MODULE_INPUT_IMAGEDECOMPRESSOR_DECOMPRESSOR_TURBOJPEG_DECOMPRESSOR_HPP
+#include <map>
+
 #include "../Decompressor.hpp"
 
 #include "utility/vision/mosaic.hpp"
@@ -35,11 +37,14 @@ namespace module::input::decompressor::turbojpeg {
     class Decompressor : public decompressor::Decompressor {
     public:
         Decompressor(const uint32_t& width, const uint32_t& height, const uint32_t& format);
-        std::pair<std::vector<uint8_t>, int> decompress(const std::vector<uint8_t>& data) override;
+        Result decompress(const std::vector<uint8_t>& data, int scale, std::vector<uint8_t>& output) override;
 
     private:
-        /// Either a mosaic permutation table if this is a mosaic pattern, or an empty list
-        utility::vision::Mosaic mosaic;
+        /// The mosaic permutation table for each scale that has been decoded, empty if this is not a mosaic pattern
+        std::map<int, utility::vision::Mosaic> mosaics;
+
+        /// Buffer that mosaic images are decoded into before being unpermuted, reused between images
+        std::vector<uint8_t> scratch;
 
         /// The fourcc code we output
         uint32_t output_fourcc;
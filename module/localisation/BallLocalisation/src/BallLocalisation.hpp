@@ -35,7 +35,7 @@
 #include "message/input/Sensors.hpp"
 #include "message/vision/Ball.hpp"
 
-#include "utility/math/filter/UKF.hpp"
+#include "utility/math/filter/SquareRootUKF.hpp"
 
 namespace module::localisation {
 
@@ -79,8 +79,8 @@ namespace module::localisation {
         /// @brief The time of the last time update
         NUClear::clock::time_point last_time_update;
 
-        /// @brief Unscented Kalman Filter for ball filtering
-        utility::math::filter::UKF<double, BallModel> ukf{};
+        /// @brief Square-root Unscented Kalman Filter for ball filtering
+        utility::math::filter::SquareRootUKF<double, BallModel> ukf{};
 
     public:
         /// @brief Called by the powerplant to build and setup the BallLocalisation reactor.
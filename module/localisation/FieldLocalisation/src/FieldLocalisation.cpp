@@ -67,6 +67,13 @@ namespace module::localisation {
             cfg.use_ground_truth_localisation   = config["use_ground_truth_localisation"].as<bool>();
             filter.model.process_noise_diagonal = config["process_noise"].as<Expression>();
             filter.model.n_particles            = config["n_particles"].as<int>();
+            filter.resample_threshold           = config["resample_threshold"].as<double>();
+            filter.kld.enabled                  = config["kld"]["enabled"].as<bool>();
+            filter.kld.bin_size                 = Eigen::Vector3d(config["kld"]["bin_size"].as<Expression>());
+            filter.kld.epsilon                  = config["kld"]["epsilon"].as<double>();
+            filter.kld.z                        = config["kld"]["z"].as<double>();
+            filter.kld.min_particles            = config["kld"]["min_particles"].as<int>();
+            filter.kld.max_particles            = config["kld"]["max_particles"].as<int>();
         });
 
         on<Startup, Trigger<FieldDescription>>().then("Update Field Line Map", [this](const FieldDescription& fd) {
@@ -127,12 +134,13 @@ namespace module::localisation {
                     && time_since_startup > cfg.start_time_delay) {
 
                     // Measurement update (using field line observations)
-                    for (int i = 0; i < cfg.n_particles; i++) {
+                    // The weights accumulate until the filter decides to resample
+                    for (int i = 0; i < filter.particle_count(); i++) {
                         auto weight = calculate_weight(filter.get_particle(i), field_lines.rPWw);
-                        filter.set_particle_weight(weight, i);
+                        filter.update_particle_weight(weight, i);
                     }
 
-                    // Time update (includes resampling)
+                    // Time update (includes resampling when the effective sample size is low)
                     const double dt =
                         duration_cast<duration<double>>(NUClear::clock::now() - last_time_update_time).count();
                     last_time_update_time = NUClear::clock::now();
@@ -143,9 +151,11 @@ namespace module::localisation {
                     if (log_level <= NUClear::DEBUG && raw_sensors.localisation_ground_truth.exists) {
                         debug_field_localisation(field->Hfw, raw_sensors);
                     }
-                    field->covariance = filter.get_covariance();
+                    field->covariance  = filter.get_covariance();
+                    field->n_particles = filter.particle_count();
                     if (log_level <= NUClear::DEBUG) {
                         field->particles = filter.get_particles_as_vector();
+                        emit(graph("Particle count", field->n_particles));
                     }
                     emit(field);
                 }
@@ -31,11 +31,22 @@
 
 #include "extension/Configuration.hpp"
 
+#include "message/eye/DataPoint.hpp"
+
+#include "utility/nusight/NUhelpers.hpp"
 #include "utility/support/math_string.hpp"
 
 namespace module::network {
 
     using extension::Configuration;
+    using utility::nusight::graph;
+
+    namespace {
+        /// @brief Seconds between two time points
+        double seconds(const NUClear::clock::time_point& from, const NUClear::clock::time_point& to) {
+            return std::chrono::duration_cast<std::chrono::duration<double>>(to - from).count();
+        }
+    }  // namespace
 
     NetworkForwarder::NetworkForwarder(std::unique_ptr<NUClear::Environment> environment)
         : Reactor(std::move(environment)) {
@@ -82,10 +93,13 @@ namespace module::network {
                     // Message if we have enabled/disabled a particular message type
                     if (handles.contains(name)) {
                         auto& handle = handles[name];
-                        bool active  = handle->targets.contains(target);
+                        const std::lock_guard<std::mutex> lock(handle->mutex);
+                        bool active = handle->targets.contains(target);
 
-                        if (enabled && !active) {
-                            log<NUClear::INFO>("Forwarding", name, "to", target);
+                        if (enabled) {
+                            if (!active) {
+                                log<NUClear::INFO>("Forwarding", name, "to", target);
+                            }
                             handle->targets[target].period = period;
                         }
                         else if (!enabled && active) {
@@ -102,6 +116,105 @@ namespace module::network {
                 }
             }
         });
+
+        // Send the latest values that were held back once their period has elapsed, so that the last value before a
+        // quiet period still reaches the target
+        on<Every<100, Per<std::chrono::seconds>>, Single, Priority::LOW>().then("Flush", [this] { flush(); });
+
+        on<Every<1, std::chrono::seconds>, Single>().then("Report", [this] {
+            std::map<std::string, Statistics> current;
+            {
+                const std::lock_guard<std::mutex> lock(statistics_mutex);
+                std::swap(current, statistics);
+            }
+            const auto now       = NUClear::clock::now();
+            const double elapsed = seconds(last_report, now);
+            last_report          = now;
+
+            for (const auto& [target, stats] : current) {
+                const double bytes_per_second    = double(stats.bytes) / elapsed;
+                const double messages_per_second = double(stats.messages) / elapsed;
+                log<NUClear::DEBUG>("Sending", bytes_per_second, "B/s", messages_per_second, "msg/s to", target);
+                if (log_level <= NUClear::DEBUG) {
+                    emit(graph("NetworkForwarder " + target, bytes_per_second, messages_per_second));
+                }
+            }
+        });
+    }
+
+    void NetworkForwarder::offer(Handle& handle, uint32_t id, const std::shared_ptr<Message>& message) {
+        std::vector<Send> sends;
+        {
+            const std::lock_guard<std::mutex> lock(handle.mutex);
+            const auto now = NUClear::clock::now();
+
+            for (auto& [target, target_handle] : handle.targets) {
+                auto& slot = target_handle.slots[id];
+                if (!slot.last_sent.has_value() || seconds(*slot.last_sent, now) >= target_handle.period) {
+                    slot.last_sent = now;
+                    slot.pending.reset();
+                    sends.push_back(Send{target, message});
+                }
+                else {
+                    // Replace whatever was waiting, only the latest value matters
+                    slot.pending   = message;
+                    handle.pending = true;
+                }
+            }
+        }
+        send(handle, sends);
+    }
+
+    void NetworkForwarder::flush() {
+        for (const auto& [type, handle] : handles) {
+            std::vector<Send> sends;
+            {
+                const std::lock_guard<std::mutex> lock(handle->mutex);
+                if (!handle->pending) {
+                    continue;
+                }
+
+                const auto now = NUClear::clock::now();
+                bool remaining = false;
+                for (auto& [target, target_handle] : handle->targets) {
+                    for (auto& [id, slot] : target_handle.slots) {
+                        if (slot.pending == nullptr) {
+                            continue;
+                        }
+                        if (seconds(*slot.last_sent, now) >= target_handle.period) {
+                            slot.last_sent = now;
+                            sends.push_back(Send{target, std::move(slot.pending)});
+                        }
+                        else {
+                            remaining = true;
+                        }
+                    }
+                }
+                handle->pending = remaining;
+            }
+            send(*handle, sends);
+        }
+    }
+
+    void NetworkForwarder::send(const Handle& handle, const std::vector<Send>& sends) {
+        for (const auto& s : sends) {
+            // Each message is only serialised for the first target it goes to
+            auto e      = std::make_unique<NUClear::dsl::word::emit::NetworkEmit>();
+            e->target   = s.target;
+            e->hash     = handle.hash;
+            e->payload  = s.message->payload();
+            e->reliable = false;
+
+            {
+                const std::lock_guard<std::mutex> lock(statistics_mutex);
+                auto& stats = statistics[s.target];
+                stats.bytes += e->payload.size();
+                stats.messages++;
+            }
+
+            log<NUClear::TRACE>("Forwarding", handle.type, "to", s.target);
+            emit<Scope::DIRECT>(e);
+        }
     }
 
 }  // namespace module::network
@@ -27,9 +27,14 @@
 #ifndef MODULE_NETWORK_NETWORKFORWARDER_HPP
 #define MODULE_NETWORK_NETWORKFORWARDER_HPP
 
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <nuclear>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include "utility/type_traits/has_id.hpp"
 
@@ -55,20 +60,66 @@ namespace module::network {
         explicit NetworkForwarder(std::unique_ptr<NUClear::Environment> environment);
 
     private:
+        /// @brief A message waiting to be forwarded, serialised at most once however many targets it is sent to
+        class Message {
+        public:
+            explicit Message(std::function<std::vector<uint8_t>()> serialise) : serialise(std::move(serialise)) {}
+
+            /// @brief The serialised message, serialising it on first use
+            const std::vector<uint8_t>& payload() {
+                std::call_once(serialised, [this] { data = serialise(); });
+                return data;
+            }
+
+        private:
+            std::function<std::vector<uint8_t>()> serialise;
+            std::once_flag serialised;
+            std::vector<uint8_t> data;
+        };
+
         struct Handle {
+            /// @brief The latest value of one (type, id, target)
+            struct Slot {
+                /// @brief When this slot last sent to its target, empty if it never has
+                std::optional<NUClear::clock::time_point> last_sent;
+                /// @brief The newest message that was held back by the period, null if there is none
+                std::shared_ptr<Message> pending;
+            };
+
             struct TargetHandle {
                 double period = std::numeric_limits<double>::max();
-                std::map<int, NUClear::clock::time_point> last_message;
+                std::map<uint32_t, Slot> slots;
             };
 
+            /// @brief Guards targets, which the message reaction, the flush timer and configuration all touch
+            std::mutex mutex;
             std::map<std::string, TargetHandle> targets;
+            /// @brief True if any slot may be holding a pending message for the flush timer
+            bool pending = false;
+            /// @brief The name of the type and its NUClear network hash
+            std::string type;
+            uint64_t hash = 0;
             ReactionHandle reaction;
         };
 
+        /// @brief A message that is due to be sent to a target
+        struct Send {
+            std::string target;
+            std::shared_ptr<Message> message;
+        };
+
+        /// @brief Bandwidth used for a target since the last report
+        struct Statistics {
+            uint64_t bytes    = 0;
+            uint64_t messages = 0;
+        };
+
         template <typename T>
         void add_handle(const std::string& type) {
 
-            auto handle = std::make_shared<Handle>();
+            auto handle  = std::make_shared<Handle>();
+            handle->type = type;
+            handle->hash = NUClear::util::serialise::Serialise<T>::hash();
 
             // We put a buffer here so that under normal operation this reaction isn't impeded.
             // However if because of the low priority other modules are taking all the thread time this module won't
@@ -77,24 +128,10 @@ namespace module::network {
                 on<Trigger<T>, Single, Priority::LOW>()
                     .then(
                         type,
-                        [this, type, handle](std::shared_ptr<const T> msg) {
-                            using namespace std::chrono;  // NOLINT(google-build-using-namespace) fine in function scope
-                            int id = id::get(*msg);
-
-                            auto now = NUClear::clock::now();
-
-                            // Loop through all the targets that are interested in this type
-                            for (auto& target_handle : handle->targets) {
-                                const auto& target = target_handle.first;
-                                auto& h            = target_handle.second;
-
-                                if (!h.last_message.contains(id)
-                                    || duration_cast<duration<double>>(now - h.last_message[id]).count() > h.period) {
-                                    powerplant.emit_shared<Scope::NETWORK>(std::move(msg), target, false);
-                                    h.last_message[id] = now;
-                                    log<NUClear::TRACE>("Forwarding", type, "to", target);
-                                }
-                            }
+                        [this, handle](std::shared_ptr<const T> msg) {
+                            auto message = std::make_shared<Message>(
+                                [msg] { return NUClear::util::serialise::Serialise<T>::serialise(*msg); });
+                            offer(*handle, id::get(*msg), message);
                         })
                     .disable();
 
@@ -103,7 +140,30 @@ namespace module::network {
 
         void register_handles();
 
+        /**
+         * @brief Make message the latest value of its id for every target of handle and send it to the targets whose
+         *        period has elapsed. The other targets keep it until the flush timer finds their period has elapsed.
+         *
+         * @param handle  the handle of the message type
+         * @param id      the id of the message
+         * @param message the message to forward
+         */
+        void offer(Handle& handle, uint32_t id, const std::shared_ptr<Message>& message);
+
+        /// @brief Send the pending messages of every slot whose period has elapsed
+        void flush();
+
+        /// @brief Serialise (once) and emit each message to its target, outside of the handle lock
+        void send(const Handle& handle, const std::vector<Send>& sends);
+
         std::map<std::string, std::shared_ptr<Handle>> handles;
+
+        /// @brief Guards statistics, which both the message reactions and the flush timer update
+        std::mutex statistics_mutex;
+        /// @brief Bytes and messages sent to each target since the last report
+        std::map<std::string, Statistics> statistics;
+        /// @brief When the statistics were last reported
+        NUClear::clock::time_point last_report = NUClear::clock::now();
     };
 
 }  // namespace module::network
@@ -26,6 +26,7 @@
  */
 #include "ImageCompressor.hpp"
 
+#include <algorithm>
 #include <fmt/format.h>
 
 #include "compressor/turbojpeg/Factory.hpp"
@@ -35,7 +36,9 @@
 
 #include "message/input/Image.hpp"
 #include "message/output/CompressedImage.hpp"
+#include "message/output/CompressionStats.hpp"
 
+#include "utility/support/yaml_expression.hpp"
 #include "utility/vision/fourcc.hpp"
 
 namespace module::output {
@@ -43,6 +46,8 @@ namespace module::output {
     using extension::Configuration;
     using message::input::Image;
     using message::output::CompressedImage;
+    using message::output::CompressionStats;
+    using utility::support::Expression;
 
     /**
      * Get the new fourcc code that we will use to describe this image after it has been compressed
@@ -83,10 +88,41 @@ namespace module::output {
         on<Configuration>("ImageCompressor.yaml").then("Configure Compressors", [this](const Configuration& cfg) {
             this->log_level = cfg["log_level"].as<NUClear::LogLevel>();
 
-            // Clear the compressors and factories
-            std::lock_guard<std::mutex> lock(compressor_mutex);
+            Policy policy          = Policy::DROP_OLDEST;
+            const auto policy_name = cfg["queue"]["policy"].as<std::string>();
+            if (policy_name == "drop_oldest") {
+                policy = Policy::DROP_OLDEST;
+            }
+            else if (policy_name == "drop_newest") {
+                policy = Policy::DROP_NEWEST;
+            }
+            else if (policy_name == "block") {
+                policy = Policy::BLOCK;
+            }
+            else {
+                throw std::runtime_error(fmt::format("Unknown queue policy {}", policy_name));
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            // Clear the compressors and factories, images that are queued or compressing keep their old compressors
             compressors.clear();
             config.factories.clear();
+            config.workers        = std::max(1, cfg["workers"].as<int>());
+            config.queue_size     = std::max(1, cfg["queue"]["size"].as<int>());
+            config.policy         = policy;
+            config.unused_timeout = std::chrono::duration_cast<NUClear::clock::duration>(
+                std::chrono::duration<double>(cfg["unused_timeout"].as<double>()));
+
+            config.rate.target          = cfg["rate"]["target"].as<Expression>();
+            config.rate.min_quality     = cfg["rate"]["min_quality"].as<int>();
+            config.rate.max_quality     = cfg["rate"]["max_quality"].as<int>();
+            config.rate.gain            = cfg["rate"]["gain"].as<double>();
+            config.rate.max_subsampling = cfg["rate"]["max_subsampling"].as<int>();
+            config.rate.encode_fraction = cfg["rate"]["encode_fraction"].as<double>();
+            for (auto& [id, camera] : cameras) {
+                camera.rate = RateController(config.rate);
+            }
 
             for (const auto& c : cfg["compressors"].config) {
                 if (c["name"].as<std::string>() == "vaapi") {
@@ -104,82 +140,255 @@ namespace module::output {
             }
         });
 
-        on<Trigger<Image>>().then("Compress Image", [this](const Image& image) {
-            // Find our list of compressors, and if needed recreate it
-            std::shared_ptr<CompressorContext> ctx;
+        on<Trigger<Image>>().then("Queue Image", [this](const std::shared_ptr<const Image>& image) {
+            std::unique_lock<std::mutex> lock(mutex);
 
-            /* Mutex Scope */ {
-                std::lock_guard<std::mutex> lock(compressor_mutex);
-                auto it = compressors.find(image.id);
-                if (it == compressors.end() || it->second->width != image.dimensions[0]
-                    || it->second->height != image.dimensions[1] || it->second->format != image.format) {
-                    log<NUClear::INFO>("Rebuilding compressors for", image.name, "camera");
-
-                    // Replace the existing one with a new one
-                    it = compressors.insert(std::make_pair(image.id, std::make_shared<CompressorContext>())).first;
-                    it->second->width  = image.dimensions[0];
-                    it->second->height = image.dimensions[1];
-                    it->second->format = image.format;
-
-                    for (auto& f : config.factories) {
-                        for (int i = 0; i < f.second; ++i) {
-                            it->second->compressors.emplace_back(CompressorContext::Compressor{
-                                std::make_unique<std::mutex>(),
-                                f.first->make_compressor(image.dimensions[0], image.dimensions[1], image.format),
-                            });
-                        }
+            // Find the compressors for this image size and format, and if needed create them
+            auto key = std::make_tuple(image->dimensions[0], image->dimensions[1], image->format);
+            auto it  = compressors.find(key);
+            if (it == compressors.end()) {
+                log<NUClear::INFO>("Building compressors for", image->name, "camera");
+
+                it = compressors.emplace(key, std::make_shared<CompressorContext>()).first;
+                for (auto& f : config.factories) {
+                    for (int i = 0; i < f.second; ++i) {
+                        it->second->idle.push_back(
+                            f.first->make_compressor(image->dimensions[0], image->dimensions[1], image->format));
                     }
                 }
-                ctx = it->second;
             }
+            auto context       = it->second;
+            context->last_used = NUClear::clock::now();
 
-            // Look through our compressors and try to find the first free one
-            for (auto& ctx : ctx->compressors) {
-                // Attempt to acquire a lock on the mutex, if this succeeds then the context wasn't being used
-                std::unique_lock lock(*ctx.mutex, std::try_to_lock);
-                if (lock) {
-
-                    auto msg = std::make_unique<CompressedImage>();
-
-                    // Compress the data
-                    msg->data = ctx.compressor->compress(image.data);
-
-                    // The format depends on what kind of data we took in
-                    msg->format = compressed_fourcc(image.format);
-
-                    // Copy across the other attributes
-                    msg->dimensions        = image.dimensions;
-                    msg->id                = image.id;
-                    msg->name              = image.name;
-                    msg->timestamp         = image.timestamp;
-                    msg->Hcw               = image.Hcw;
-                    msg->lens.projection   = int(image.lens.projection);
-                    msg->lens.focal_length = image.lens.focal_length;
-                    msg->lens.fov          = image.lens.fov;
-                    msg->lens.centre       = image.lens.centre;
-                    msg->lens.k            = image.lens.k;
-
-                    // Emit the compressed image
-                    emit(msg);
-
-                    // Successful compression!
-                    ++compressed;
-                    return;
+            // A camera seen for the first time starts with a fresh rate controller
+            auto [camera_it, inserted] = cameras.try_emplace(image->id);
+            Camera& camera             = camera_it->second;
+            if (inserted) {
+                camera.rate = RateController(config.rate);
+            }
+            camera.name = image->name;
+            ++camera.received;
+
+            // Apply the policy if this camera already has as many images waiting as it is allowed
+            if (camera.queue.size() >= config.queue_size) {
+                switch (config.policy) {
+                    case Policy::DROP_OLDEST:
+                        camera.queue.pop_front();
+                        ++camera.dropped;
+                        break;
+                    case Policy::DROP_NEWEST: ++camera.dropped; return;
+                    case Policy::BLOCK:
+                        // Make room by compressing this camera's oldest images on this thread rather than sleeping
+                        // until a compression task gets to them, so no thread sits idle while work is waiting. We
+                        // only wait when every compressor for the image is busy, and those are always compressing.
+                        while (camera.queue.size() >= config.queue_size) {
+                            auto& idle = camera.queue.front().context->idle;
+                            if (idle.empty()) {
+                                compressor_available.wait(lock);
+                                continue;
+                            }
+                            Job job = std::move(camera.queue.front());
+                            camera.queue.pop_front();
+                            auto compressor = std::move(idle.back());
+                            idle.pop_back();
+                            compress(lock, std::move(job), std::move(compressor));
+                        }
+                        break;
                 }
             }
-            // We failed to compress this image
-            ++dropped;
+
+            camera.queue.push_back(Job{image, context, NUClear::clock::now()});
+            camera.max_depth = std::max(camera.max_depth, camera.queue.size());
+
+            // Start another compression task if there is room for one, otherwise a running task will get to it
+            if (active < config.workers) {
+                emit(std::make_unique<CompressQueued>());
+            }
         });
 
+        on<Trigger<CompressQueued>>().then("Compress Images", [this] { compress_queued(); });
+
         on<Every<1, std::chrono::seconds>>().then("Stats", [this] {
-            log<NUClear::DEBUG>(fmt::format("Receiving {}/s, Compressing {}/s,  Dropping {}/s ({}%)",
-                                            compressed + dropped,
-                                            compressed,
-                                            dropped,
-                                            100 * double(compressed) / double(compressed + dropped)));
-            compressed = 0;
-            dropped    = 0;
+            auto msg    = std::make_unique<CompressionStats>();
+            msg->period = 1.0;
+
+            /* Mutex Scope */ {
+                std::lock_guard<std::mutex> lock(mutex);
+                msg->workers = config.workers;
+
+                for (auto& [id, camera] : cameras) {
+                    CompressionStats::Camera stats;
+                    stats.id              = id;
+                    stats.name            = camera.name;
+                    stats.received        = camera.received;
+                    stats.compressed      = camera.compressed;
+                    stats.dropped         = camera.dropped;
+                    stats.queue_depth     = camera.queue.size();
+                    stats.max_queue_depth = camera.max_depth;
+                    stats.mean_latency    = camera.compressed > 0 ? camera.latency_sum / camera.compressed : 0.0;
+                    stats.max_latency     = camera.latency_max;
+                    stats.mean_quality    = camera.controlled > 0 ? camera.quality_sum / camera.controlled : 0.0;
+                    stats.mean_size       = camera.compressed > 0 ? double(camera.bytes) / camera.compressed : 0.0;
+                    stats.bytes           = camera.bytes;
+                    stats.target          = config.rate.target;
+                    stats.subsampling     = camera.rate.settings().subsampling;
+                    msg->cameras.push_back(stats);
+
+                    log<NUClear::DEBUG>(
+                        fmt::format("{}: Receiving {}/s, Compressing {}/s, Dropping {}/s, Queue {} (max {}), "
+                                    "Latency {:.1f}ms (max {:.1f}ms), {}B/s at quality {:.0f}",
+                                    camera.name,
+                                    camera.received,
+                                    camera.compressed,
+                                    camera.dropped,
+                                    camera.queue.size(),
+                                    camera.max_depth,
+                                    stats.mean_latency,
+                                    stats.max_latency,
+                                    camera.bytes,
+                                    stats.mean_quality));
+
+                    // Reset for the next period
+                    camera.received    = 0;
+                    camera.compressed  = 0;
+                    camera.dropped     = 0;
+                    camera.max_depth   = camera.queue.size();
+                    camera.latency_sum = 0.0;
+                    camera.latency_max = 0.0;
+                    camera.bytes       = 0;
+                    camera.controlled  = 0;
+                    camera.quality_sum = 0.0;
+                }
+
+                // Free the compressors for image sizes and formats we have stopped receiving. A context that a queued
+                // or compressing image still holds is kept until that image is done with it.
+                const auto now = NUClear::clock::now();
+                for (auto it = compressors.begin(); it != compressors.end();) {
+                    if (it->second.use_count() == 1 && now - it->second->last_used > config.unused_timeout) {
+                        const auto& [width, height, format] = it->first;
+                        log<NUClear::INFO>("Removing unused compressors for", width, "x", height, "images");
+                        it = compressors.erase(it);
+                    }
+                    else {
+                        ++it;
+                    }
+                }
+            }
+
+            emit(msg);
         });
     }
 
+    void ImageCompressor::compress_queued() {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (active >= config.workers) {
+            return;
+        }
+
+        // Keep going while there is work so a burst of images doesn't need a new task for each one
+        ++active;
+        Job job;
+        std::shared_ptr<compressor::Compressor> compressor;
+        while (next_job(job, compressor)) {
+            compress(lock, std::move(job), std::move(compressor));
+        }
+        --active;
+    }
+
+    bool ImageCompressor::next_job(Job& job, std::shared_ptr<compressor::Compressor>& compressor) {
+        // Start from the camera after the one that was served last and wrap around so every camera gets a turn
+        auto it = cameras.upper_bound(last_camera);
+        for (size_t i = 0; i < cameras.size(); ++i, ++it) {
+            if (it == cameras.end()) {
+                it = cameras.begin();
+            }
+            auto& [id, camera] = *it;
+            if (!camera.queue.empty() && !camera.queue.front().context->idle.empty()) {
+                job = std::move(camera.queue.front());
+                camera.queue.pop_front();
+                compressor = std::move(job.context->idle.back());
+                job.context->idle.pop_back();
+                last_camera = id;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ImageCompressor::compress(std::unique_lock<std::mutex>& lock,
+                                   Job job,
+                                   std::shared_ptr<compressor::Compressor> compressor) {
+        // Only compressors that use the settings can be steered by the rate controller, and only when it has a target
+        const RateController& rate          = cameras[job.image->id].rate;
+        const bool controlled               = compressor->supports_settings() && rate.enabled();
+        const compressor::Settings settings = controlled ? rate.settings() : compressor::Settings{};
+        lock.unlock();
+
+        const Image& image = *job.image;
+        bool success       = false;
+        size_t bytes       = 0;
+        double encode_time = 0.0;
+        try {
+            auto msg = std::make_unique<CompressedImage>();
+
+            // Compress the data
+            const auto start = NUClear::clock::now();
+            msg->data        = compressor->compress(image.data, settings);
+            encode_time      = std::chrono::duration<double>(NUClear::clock::now() - start).count();
+            bytes            = msg->data.size();
+
+            // The format depends on what kind of data we took in
+            msg->format = compressed_fourcc(image.format);
+
+            // Copy across the other attributes
+            msg->dimensions        = image.dimensions;
+            msg->id                = image.id;
+            msg->name              = image.name;
+            msg->timestamp         = image.timestamp;
+            msg->Hcw               = image.Hcw;
+            msg->lens.projection   = int(image.lens.projection);
+            msg->lens.focal_length = image.lens.focal_length;
+            msg->lens.fov          = image.lens.fov;
+            msg->lens.centre       = image.lens.centre;
+            msg->lens.k            = image.lens.k;
+
+            // Emit the compressed image
+            emit(msg);
+            success = true;
+        }
+        catch (const std::exception& e) {
+            log<NUClear::ERROR>("Failed to compress image from", image.name, "camera:", e.what());
+        }
+        const auto now       = NUClear::clock::now();
+        const double latency = std::chrono::duration<double, std::milli>(now - job.queued).count();
+
+        lock.lock();
+
+        // Give the compressor back, which may let a blocked camera make room in its queue
+        job.context->idle.push_back(std::move(compressor));
+        compressor_available.notify_all();
+
+        Camera& camera = cameras[image.id];
+        if (success) {
+            ++camera.compressed;
+            camera.latency_sum += latency;
+            camera.latency_max = std::max(camera.latency_max, latency);
+            camera.bytes += bytes;
+
+            // Feed the result back so the next image from this camera lands closer to its budget
+            if (controlled) {
+                ++camera.controlled;
+                camera.quality_sum += settings.quality;
+                if (camera.last_compressed != NUClear::clock::time_point{}) {
+                    const double interval = std::chrono::duration<double>(now - camera.last_compressed).count();
+                    camera.rate.update(bytes, encode_time, interval);
+                }
+            }
+            camera.last_compressed = now;
+        }
+        else {
+            ++camera.dropped;
+        }
+    }
+
 }  // namespace module::output
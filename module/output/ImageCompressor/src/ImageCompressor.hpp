@@ -27,52 +27,133 @@
 #ifndef MODULE_OUTPUT_IMAGECOMPRESSOR_HPP
 #define MODULE_OUTPUT_IMAGECOMPRESSOR_HPP
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <nuclear>
+#include <tuple>
+#include <vector>
 
+#include "RateController.hpp"
 #include "compressor/CompressorFactory.hpp"
 
+#include "message/input/Image.hpp"
+
 namespace module::output {
 
     class ImageCompressor : public NUClear::Reactor {
     private:
+        /// What to do with a new image when its camera's queue is already full
+        enum class Policy { DROP_OLDEST, DROP_NEWEST, BLOCK };
+
+        /// A set of compressors for one image size and format, shared by every camera that produces it
         struct CompressorContext {
-            struct Compressor {
-                /// Mutex controlling access to this compressor instance
-                std::unique_ptr<std::mutex> mutex;
-                /// The actual compressor that will convert the image to jpeg format
-                std::shared_ptr<compressor::Compressor> compressor;
-            };
-
-            /// A list of compressors that can be used
-            std::vector<Compressor> compressors;
-
-            /// The width height and format so that if these change we can regenerate the compressors
-            uint32_t width{};
-            uint32_t height{};
-            uint32_t format{};
+            /// The compressors that are not currently compressing an image
+            std::vector<std::shared_ptr<compressor::Compressor>> idle;
+            /// When an image that uses these compressors last arrived, so unused ones can be removed
+            NUClear::clock::time_point last_used;
+        };
+
+        /// An image waiting to be compressed
+        struct Job {
+            /// The image to compress
+            std::shared_ptr<const message::input::Image> image;
+            /// The compressors that can compress this image
+            std::shared_ptr<CompressorContext> context;
+            /// When the image was queued, used to measure the latency
+            NUClear::clock::time_point queued;
+        };
+
+        /// The queue and statistics for one camera
+        struct Camera {
+            /// Name of the camera
+            std::string name;
+            /// Images from this camera waiting for a free compressor
+            std::deque<Job> queue;
+            /// Chooses the quality for this camera's images to keep within its byte rate
+            RateController rate;
+            /// When the last image from this camera finished compressing
+            NUClear::clock::time_point last_compressed{};
+
+            /// Statistics since the last report
+            int received       = 0;
+            int compressed     = 0;
+            int dropped        = 0;
+            size_t max_depth   = 0;
+            double latency_sum = 0.0;
+            double latency_max = 0.0;
+            size_t bytes       = 0;
+            int controlled     = 0;
+            double quality_sum = 0.0;
         };
 
+        /// Emitted to start a task that compresses queued images
+        struct CompressQueued {};
+
     public:
         /// @brief Called by the powerplant to build and setup the ImageCompressor reactor.
         explicit ImageCompressor(std::unique_ptr<NUClear::Environment> environment);
 
     private:
+        /**
+         * @brief Compresses queued images until there are none that can be compressed right now. Returns straight away
+         * if as many images as there are workers are already being compressed.
+         */
+        void compress_queued();
+
+        /**
+         * @brief Takes the next image that can be compressed right now, visiting the cameras in turn so a busy camera
+         * can't starve the others. Must be called with the mutex held.
+         *
+         * @param job        set to the image to compress
+         * @param compressor set to an idle compressor for that image, which is given back by compress
+         *
+         * @return true if there was an image and a free compressor for it
+         */
+        bool next_job(Job& job, std::shared_ptr<compressor::Compressor>& compressor);
+
+        /**
+         * @brief Compresses an image, emits it, gives the compressor back and records the result
+         *
+         * @param lock       a lock on the mutex, which is released while the image is being compressed
+         * @param job        the image to compress
+         * @param compressor an idle compressor for the image that was taken from the job's context
+         */
+        void compress(std::unique_lock<std::mutex>& lock, Job job, std::shared_ptr<compressor::Compressor> compressor);
+
         struct {
             /// The compressor factories that will be used to create a compression context
             std::vector<std::pair<std::shared_ptr<compressor::CompressorFactory>, int>> factories;
+            /// Most images that are compressed at once by compression tasks
+            int workers = 1;
+            /// Number of images each camera can have waiting before the policy applies
+            size_t queue_size = 2;
+            /// What to do with a new image when its camera's queue is full
+            Policy policy = Policy::DROP_OLDEST;
+            /// How long the compressors for an image size and format are kept once no images use them
+            NUClear::clock::duration unused_timeout = std::chrono::seconds(10);
+            /// The rate control settings for every camera
+            RateController::Config rate;
         } config;
 
-        /// The compressors that are available for use
-        std::mutex compressor_mutex;
-        std::map<uint32_t, std::shared_ptr<CompressorContext>> compressors;
+        /// Protects everything below
+        std::mutex mutex;
+        /// Signalled when a compressor is given back, for the blocking policy
+        std::condition_variable compressor_available;
+
+        /// The compressors for each image width, height and format
+        std::map<std::tuple<uint32_t, uint32_t, uint32_t>, std::shared_ptr<CompressorContext>> compressors;
+        /// The queue for each camera id
+        std::map<uint32_t, Camera> cameras;
+        /// The id of the camera that was last given to a compression task
+        uint32_t last_camera = 0;
 
-        /// Number of images that have been compressed since this was last reset
-        int compressed = 0;
-        /// Number of images that have been dropped since this was last reset
-        int dropped = 0;
+        /// Number of compression tasks that are running
+        int active = 0;
     };
 
 }  // namespace module::output
@@ -0,0 +1,77 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "RateController.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace module::output {
+
+    /// Weight given to each new interval when smoothing the time between images
+    constexpr double PERIOD_SMOOTHING = 0.1;
+
+    RateController::RateController() : RateController(Config{}) {}
+
+    RateController::RateController(const Config& config) : config(config), quality(config.max_quality) {}
+
+    bool RateController::enabled() const {
+        return config.target > 0.0;
+    }
+
+    compressor::Settings RateController::settings() const {
+        if (!enabled()) {
+            return compressor::Settings{};
+        }
+        return compressor::Settings{int(std::lround(quality)), subsampling};
+    }
+
+    void RateController::update(size_t bytes, double encode_time, double interval) {
+        if (!enabled() || bytes == 0 || interval <= 0.0) {
+            return;
+        }
+
+        // Smooth the time between images so one late image doesn't swing the budget
+        period = period > 0.0 ? period + PERIOD_SMOOTHING * (interval - period) : interval;
+
+        // How far off budget this image was, in log space, taking whichever of size or encode time is worse
+        double error = std::log(config.target * period / double(bytes));
+        if (encode_time > 0.0) {
+            error = std::min(error, std::log(config.encode_fraction * period / encode_time));
+        }
+
+        quality = std::clamp(quality + config.gain * error, double(config.min_quality), double(config.max_quality));
+
+        // Trade chroma for bytes once quality has nowhere left to go, and give it back once quality has recovered
+        if (quality <= config.min_quality && error < 0.0 && subsampling < config.max_subsampling) {
+            ++subsampling;
+        }
+        else if (quality >= config.max_quality && error > 0.0 && subsampling > 0) {
+            --subsampling;
+        }
+    }
+
+}  // namespace module::output
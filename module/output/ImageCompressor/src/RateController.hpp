@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MODULE_OUTPUT_IMAGECOMPRESSOR_RATECONTROLLER_HPP
+#define MODULE_OUTPUT_IMAGECOMPRESSOR_RATECONTROLLER_HPP
+
+#include <cstddef>
+
+#include "compressor/Compressor.hpp"
+
+namespace module::output {
+
+    /**
+     * Chooses the JPEG quality and chroma subsampling for each image from one camera so that its compressed images
+     * stay within a byte rate
+     *
+     * After each image the quality is moved by the log of the ratio between the per image budget and the size that
+     * image came out at, so being twice over budget costs the same number of quality steps at any quality. If encoding
+     * takes longer than its share of the time between images the quality is lowered as well. Once the quality is at
+     * its minimum the chroma is subsampled further, and that is undone once the quality is back at its maximum.
+     */
+    class RateController {
+    public:
+        struct Config {
+            /// Target compressed bytes per second, 0 to always use the compressor's configured quality
+            double target = 0.0;
+            /// Lowest quality the controller will use
+            int min_quality = 30;
+            /// Highest quality the controller will use
+            int max_quality = 95;
+            /// Quality steps for each factor of e the image was off its budget
+            double gain = 20.0;
+            /// Most chroma subsampling the controller will use, 0 for 4:4:4, 1 for 4:2:2 and 2 for 4:2:0
+            int max_subsampling = 0;
+            /// Fraction of the time between images that encoding one image may take
+            double encode_fraction = 0.5;
+        };
+
+        RateController();
+        explicit RateController(const Config& config);
+
+        /// @brief If this controller has a target, otherwise it leaves the quality to the compressor
+        [[nodiscard]] bool enabled() const;
+
+        /// @brief The settings to compress the next image with
+        [[nodiscard]] compressor::Settings settings() const;
+
+        /**
+         * @brief Updates the quality from an image that was just compressed
+         *
+         * @param bytes       the size of the compressed image
+         * @param encode_time how long the image took to compress, in seconds
+         * @param interval    the time since the previous image from this camera was compressed, in seconds
+         */
+        void update(size_t bytes, double encode_time, double interval);
+
+    private:
+        /// The configuration for this controller
+        Config config;
+        /// Current quality, kept fractional so small corrections accumulate
+        double quality;
+        /// Current extra chroma subsampling
+        int subsampling = 0;
+        /// Smoothed time between images, in seconds
+        double period = 0.0;
+    };
+
+}  // namespace module::output
+
+#endif  // MODULE_OUTPUT_IMAGECOMPRESSOR_RATECONTROLLER_HPP
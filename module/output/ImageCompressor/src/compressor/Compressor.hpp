@@ -32,6 +32,14 @@
 
 namespace module::output::compressor {
 
+    /// Per image settings that a compressor may use in place of the ones it was configured with
+    struct Settings {
+        /// The JPEG quality to compress with, 0 to use the configured quality
+        int quality = 0;
+        /// Extra chroma subsampling for colour images, 0 for 4:4:4, 1 for 4:2:2 and 2 for 4:2:0
+        int subsampling = 0;
+    };
+
     class Compressor {
     public:
         Compressor()                                 = default;
@@ -41,7 +49,12 @@ namespace module::output::compressor {
         Compressor& operator=(const Compressor&)     = default;
         Compressor& operator=(Compressor&&) noexcept = default;
 
-        virtual std::vector<uint8_t> compress(const std::vector<uint8_t>& data) = 0;
+        virtual std::vector<uint8_t> compress(const std::vector<uint8_t>& data, const Settings& settings) = 0;
+
+        /// @brief If this compressor uses the Settings given to compress, rather than only its configured quality
+        [[nodiscard]] virtual bool supports_settings() const {
+            return false;
+        }
     };
 
 }  // namespace module::output::compressor
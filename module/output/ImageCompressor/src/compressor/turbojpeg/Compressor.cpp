@@ -42,7 +42,7 @@ namespace module::output::compressor::turbojpeg {
         }
     }
 
-    std::vector<uint8_t> Compressor::compress(const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> Compressor::compress(const std::vector<uint8_t>& data, const Settings& settings) {
         TJSAMP tj_sampling = TJSAMP_444;
         TJPF tj_format     = TJPF_RGB;
 
@@ -86,6 +86,15 @@ namespace module::output::compressor::turbojpeg {
                                                      utility::vision::fourcc(format)));
         }
 
+        // Use the per image quality and subsample the chroma further if asked, greyscale images have no chroma
+        const int quality = settings.quality > 0 ? settings.quality : this->quality;
+        if (tj_sampling == TJSAMP_444 && settings.subsampling == 1) {
+            tj_sampling = TJSAMP_422;
+        }
+        else if (tj_sampling == TJSAMP_444 && settings.subsampling >= 2) {
+            tj_sampling = TJSAMP_420;
+        }
+
         // A compressor per thread
         // tjInitCompress returns and allocated tjHandle (which is a void*)
         auto deleter = [](void* ptr) {
@@ -36,7 +36,10 @@ namespace module::output::compressor::turbojpeg {
     class Compressor : public compressor::Compressor {
     public:
         Compressor(const int& quality, const uint32_t& width, const uint32_t& height, const uint32_t& format);
-        std::vector<uint8_t> compress(const std::vector<uint8_t>& data) override;
+        std::vector<uint8_t> compress(const std::vector<uint8_t>& data, const Settings& settings) override;
+        [[nodiscard]] bool supports_settings() const override {
+            return true;
+        }
 
     private:
         /// The JPEG quality to compress with
@@ -147,7 +147,9 @@ namespace module::output::compressor::vaapi {
         vaDestroyContext(cctx.va.dpy, context);
     }
 
-    std::vector<uint8_t> Compressor::compress(const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> Compressor::compress(const std::vector<uint8_t>& data, const Settings& /*settings*/) {
+        // The quality is baked into the quantisation tables and header built with the context, so per image settings
+        // are ignored and this compressor always uses its configured quality
 
         if (utility::vision::Mosaic::size(format) > 1) {
             // Use OpenCL to permute the mosaic into the surface
@@ -50,7 +50,7 @@ namespace module::output::compressor::vaapi {
         Compressor& operator=(Compressor&&)      = default;
         virtual ~Compressor();
 
-        std::vector<uint8_t> compress(const std::vector<uint8_t>& data) override;
+        std::vector<uint8_t> compress(const std::vector<uint8_t>& data, const Settings& settings) override;
 
         // Contexts and buffers used for compressing images
         CompressionContext cctx;
@@ -0,0 +1,125 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+
+#include "RateController.hpp"
+
+using module::output::RateController;
+
+namespace {
+
+    /// A camera at 10 frames per second with a budget of 10kB per image
+    RateController::Config make_config() {
+        RateController::Config config;
+        config.target          = 100000.0;
+        config.min_quality     = 30;
+        config.max_quality     = 90;
+        config.gain            = 20.0;
+        config.max_subsampling = 2;
+        config.encode_fraction = 0.5;
+        return config;
+    }
+
+}  // namespace
+
+TEST_CASE("RateController uses the compressor's quality when it has no target", "[ImageCompressor][RateController]") {
+    RateController rate;
+    rate.update(1000000, 1.0, 0.1);
+    REQUIRE_FALSE(rate.enabled());
+    REQUIRE(rate.settings().quality == 0);
+    REQUIRE(rate.settings().subsampling == 0);
+}
+
+TEST_CASE("RateController starts at its highest quality", "[ImageCompressor][RateController]") {
+    const RateController rate(make_config());
+    REQUIRE(rate.enabled());
+    REQUIRE(rate.settings().quality == 90);
+    REQUIRE(rate.settings().subsampling == 0);
+}
+
+TEST_CASE("RateController lowers the quality when images are over budget", "[ImageCompressor][RateController]") {
+    RateController rate(make_config());
+
+    // Twice the budget costs gain * log(2) quality steps
+    rate.update(20000, 0.0, 0.1);
+    REQUIRE(rate.settings().quality == std::lround(90 - 20.0 * std::log(2.0)));
+
+    // And it comes back up once images are under budget, but no higher than the maximum
+    for (int i = 0; i < 10; ++i) {
+        rate.update(5000, 0.0, 0.1);
+    }
+    REQUIRE(rate.settings().quality == 90);
+}
+
+TEST_CASE("RateController never goes below its lowest quality", "[ImageCompressor][RateController]") {
+    auto config            = make_config();
+    config.max_subsampling = 0;
+    RateController rate(config);
+
+    for (int i = 0; i < 100; ++i) {
+        rate.update(1000000, 0.0, 0.1);
+    }
+    REQUIRE(rate.settings().quality == 30);
+    REQUIRE(rate.settings().subsampling == 0);
+}
+
+TEST_CASE("RateController lowers the quality when encoding can't keep up", "[ImageCompressor][RateController]") {
+    RateController rate(make_config());
+
+    // Within the byte budget, but taking the whole time between images to encode
+    rate.update(5000, 0.1, 0.1);
+    REQUIRE(rate.settings().quality < 90);
+}
+
+TEST_CASE("RateController subsamples chroma once quality is at its lowest", "[ImageCompressor][RateController]") {
+    RateController rate(make_config());
+
+    // Far over budget drives the quality down and then takes the chroma one step at a time
+    for (int i = 0; i < 100; ++i) {
+        rate.update(1000000, 0.0, 0.1);
+    }
+    REQUIRE(rate.settings().quality == 30);
+    REQUIRE(rate.settings().subsampling == 2);
+
+    // Chroma is only given back once the quality has recovered
+    rate.update(1000, 0.0, 0.1);
+    REQUIRE(rate.settings().subsampling == 2);
+    for (int i = 0; i < 100; ++i) {
+        rate.update(1000, 0.0, 0.1);
+    }
+    REQUIRE(rate.settings().quality == 90);
+    REQUIRE(rate.settings().subsampling == 0);
+}
+
+TEST_CASE("RateController ignores images it can't measure", "[ImageCompressor][RateController]") {
+    RateController rate(make_config());
+    rate.update(0, 0.0, 0.1);
+    rate.update(1000000, 0.0, 0.0);
+    REQUIRE(rate.settings().quality == 90);
+}
@@ -33,6 +33,7 @@
 #include <limits>
 #include <mutex>
 
+#include "clock/clock.hpp"
 #include "extension/Configuration.hpp"
 
 #include "message/actuation/ServoTarget.hpp"
@@ -160,67 +161,64 @@ namespace module::platform {
                 noise.accelerometer = config["noise"]["accelerometer"].as<Expression>();
                 noise.gyroscope     = config["noise"]["gyroscope"].as<Expression>();
                 bodyTilt            = config["body_tilt"].as<Expression>();
-            });
+                rng.seed(config["noise"]["seed"].as<uint32_t>());
 
-        on<Every<UPDATE_FREQUENCY, Per<std::chrono::seconds>>, Optional<With<Sensors>>, Single>().then(
-            [this](const std::shared_ptr<const Sensors>& previousSensors) {
-                if (previousSensors) {
-                    Eigen::Isometry3d Hf_rt(previousSensors->Htx[FrameID::R_ANKLE_ROLL]);
-                    Eigen::Isometry3d Hf_lt(previousSensors->Htx[FrameID::L_ANKLE_ROLL]);
-                    Eigen::Vector3d torsoFromRightFoot = -Hf_rt.rotation().transpose() * Hf_rt.translation();
-                    Eigen::Vector3d torsoFromLeftFoot  = -Hf_lt.rotation().transpose() * Hf_lt.translation();
-
-                    if (torsoFromRightFoot.z() > torsoFromLeftFoot.z()) {
-                        setLeftFootDown(false);
-                        setRightFootDown(true);
-                    }
-                    else if (torsoFromRightFoot.z() < torsoFromLeftFoot.z()) {
-                        setLeftFootDown(true);
-                        setRightFootDown(false);
-                    }
-                    else {
-                        setLeftFootDown(true);
-                        setRightFootDown(true);
-                    }
+                const bool was_stepped = stepped;
+                stepped                = config["stepped"].as<bool>();
+
+                // With more than one thread a reaction from the last tick can still be running when the step fires
+                if (stepped && powerplant.configuration.thread_count != 1) {
+                    log<NUClear::ERROR>("Stepped mode needs a power plant with a single thread (set NUCLEAR_THREADS=1),"
+                                        " carrying on in real time");
+                    stepped = false;
+                }
+
+                if (stepped && !was_stepped) {
+                    // Hold the clock where it is, it only moves when we step it
+                    virtual_time = NUClear::clock::now();
+                    utility::clock::set_time(virtual_time, 0.0);
+                    step_at(virtual_time);
+                }
+                else if (!stepped && was_stepped) {
+                    // Carry on in real time from wherever the virtual clock got to
+                    utility::clock::set_time(powerplant, virtual_time, 1.0);
                 }
+            });
 
-                for (int i = 0; i < 20; ++i) {
-                    auto& servo       = utility::platform::get_raw_servo(i, sensors);
-                    float movingSpeed = servo.profile_velocity == 0 ? 0.1 : servo.profile_velocity / UPDATE_FREQUENCY;
-                    movingSpeed       = movingSpeed > 0.1 ? 0.1 : movingSpeed;
-
-
-                    if (std::abs(servo.present_position - servo.goal_position) < movingSpeed) {
-                        servo.present_position = servo.goal_position;
-                    }
-                    else {
-                        Eigen::Vector3d present(std::cos(servo.present_position),
-                                                std::sin(servo.present_position),
-                                                0.0);
-                        Eigen::Vector3d goal(std::cos(servo.goal_position), std::sin(servo.goal_position), 0.0);
-
-                        Eigen::Vector3d cross = present.cross(goal);
-                        if (cross.z() > 0) {
-                            servo.present_position =
-                                utility::math::angle::normalizeAngle(servo.present_position + movingSpeed);
-                        }
-                        else {
-                            servo.present_position =
-                                utility::math::angle::normalizeAngle(servo.present_position - movingSpeed);
-                        }
-                    }
+        on<Every<UPDATE_FREQUENCY, Per<std::chrono::seconds>>, Optional<With<Sensors>>, Single>().then(
+            [this](const std::shared_ptr<const Sensors>& previous_sensors) {
+                if (!stepped) {
+                    tick(previous_sensors);
                 }
+            });
 
-                sensors.gyroscope     = Eigen::Vector3f(0.0f, 0.0f, imu_drift_rate);
-                sensors.accelerometer = Eigen::Vector3f(-9.8 * std::sin(bodyTilt), 0.0, 9.8 * std::cos(bodyTilt));
-                sensors.timestamp     = NUClear::clock::now();
+        // With a single thread, idle priority only runs once nothing else is queued or running. This was queued by the
+        // chrono controller when it reached the current time, but it may have still been queueing the timers that were
+        // due at the same time. Going through the chrono controller again waits for it to finish doing that, after
+        // which those timers are queued ahead of the Advance
+        on<Trigger<Step>, Priority::IDLE>().then([this] {
+            if (stepped) {
+                powerplant.emit<NUClear::dsl::word::emit::Direct>(std::make_unique<NUClear::dsl::operation::ChronoTask>(
+                    [this](NUClear::clock::time_point& /*time*/) {
+                        emit(std::make_unique<Advance>());
+                        return false;
+                    },
+                    virtual_time,
+                    0));
+            }
+        });
 
-                // Add some noise so that sensor fusion doesnt converge to a singularity
-                auto sensors_message = std::make_unique<RawSensors>(sensors);
-                addNoise(sensors_message);
+        // Everything from the last tick, including any timers that were due, has finished so move the clock on
+        on<Trigger<Advance>, Optional<With<Sensors>>, Priority::IDLE>().then(
+            [this](const std::shared_ptr<const Sensors>& previous_sensors) {
+                if (!stepped) {
+                    return;
+                }
 
-                // Send our nicely computed sensor data out to the world
-                emit(std::move(sensors_message));
+                virtual_time += NUClear::clock::duration(std::chrono::seconds(1)) / UPDATE_FREQUENCY;
+                utility::clock::set_time(virtual_time, 0.0);
+                tick(previous_sensors);
+                step_at(virtual_time);
             });
 
         // This trigger writes the servo positions to the hardware
@@ -254,12 +252,78 @@ namespace module::platform {
         });
     }
 
-    float centered_noise() {
-        return rand() / float(RAND_MAX) - 0.5f;
+    void HardwareSimulator::step_at(const NUClear::clock::time_point& time) {
+        // A task that is already due wakes the chrono controller, which runs the timers that are due by the new time
+        // before it runs this and queues the next step
+        powerplant.emit<NUClear::dsl::word::emit::Direct>(std::make_unique<NUClear::dsl::operation::ChronoTask>(
+            [this](NUClear::clock::time_point& /*time*/) {
+                emit(std::make_unique<Step>());
+                return false;
+            },
+            time,
+            0));
+    }
+
+    void HardwareSimulator::tick(const std::shared_ptr<const Sensors>& previous_sensors) {
+        if (previous_sensors) {
+            Eigen::Isometry3d Hf_rt(previous_sensors->Htx[FrameID::R_ANKLE_ROLL]);
+            Eigen::Isometry3d Hf_lt(previous_sensors->Htx[FrameID::L_ANKLE_ROLL]);
+            Eigen::Vector3d torsoFromRightFoot = -Hf_rt.rotation().transpose() * Hf_rt.translation();
+            Eigen::Vector3d torsoFromLeftFoot  = -Hf_lt.rotation().transpose() * Hf_lt.translation();
+
+            if (torsoFromRightFoot.z() > torsoFromLeftFoot.z()) {
+                setLeftFootDown(false);
+                setRightFootDown(true);
+            }
+            else if (torsoFromRightFoot.z() < torsoFromLeftFoot.z()) {
+                setLeftFootDown(true);
+                setRightFootDown(false);
+            }
+            else {
+                setLeftFootDown(true);
+                setRightFootDown(true);
+            }
+        }
+
+        for (int i = 0; i < 20; ++i) {
+            auto& servo       = utility::platform::get_raw_servo(i, sensors);
+            float movingSpeed = servo.profile_velocity == 0 ? 0.1 : servo.profile_velocity / UPDATE_FREQUENCY;
+            movingSpeed       = movingSpeed > 0.1 ? 0.1 : movingSpeed;
+
+
+            if (std::abs(servo.present_position - servo.goal_position) < movingSpeed) {
+                servo.present_position = servo.goal_position;
+            }
+            else {
+                Eigen::Vector3d present(std::cos(servo.present_position), std::sin(servo.present_position), 0.0);
+                Eigen::Vector3d goal(std::cos(servo.goal_position), std::sin(servo.goal_position), 0.0);
+
+                Eigen::Vector3d cross = present.cross(goal);
+                if (cross.z() > 0) {
+                    servo.present_position = utility::math::angle::normalizeAngle(servo.present_position + movingSpeed);
+                }
+                else {
+                    servo.present_position = utility::math::angle::normalizeAngle(servo.present_position - movingSpeed);
+                }
+            }
+        }
+
+        sensors.gyroscope     = Eigen::Vector3f(0.0f, 0.0f, imu_drift_rate);
+        sensors.accelerometer = Eigen::Vector3f(-9.8 * std::sin(bodyTilt), 0.0, 9.8 * std::cos(bodyTilt));
+        sensors.timestamp     = NUClear::clock::now();
+
+        // Add some noise so that sensor fusion doesnt converge to a singularity
+        auto sensors_message = std::make_unique<RawSensors>(sensors);
+        addNoise(sensors_message);
+
+        // Send our nicely computed sensor data out to the world
+        emit(std::move(sensors_message));
     }
 
-    void HardwareSimulator::addNoise(std::unique_ptr<RawSensors>& sensors) const {
-        // TODO(HardwareTeam,DevOpsTeam): Use a more standard c++ random generator.
+    void HardwareSimulator::addNoise(std::unique_ptr<RawSensors>& sensors) {
+        // Scaled by hand rather than with a std distribution, as those can give different values on different
+        // standard libraries and runs with the same seed should match everywhere
+        const auto centered_noise = [this] { return float(rng() - rng.min()) / float(rng.max() - rng.min()) - 0.5f; };
         sensors->accelerometer += noise.accelerometer * centered_noise();
         sensors->gyroscope += noise.gyroscope * centered_noise();
     }
@@ -31,7 +31,9 @@
 #include <Eigen/Core>
 #include <mutex>
 #include <nuclear>
+#include <random>
 
+#include "message/input/Sensors.hpp"
 #include "message/platform/RawSensors.hpp"
 
 namespace module::platform {
@@ -48,12 +50,37 @@ namespace module::platform {
 
         float imu_drift_rate                     = 0.0f;
         static constexpr size_t UPDATE_FREQUENCY = 90;
-        void addNoise(std::unique_ptr<message::platform::RawSensors>& sensors) const;
+        void addNoise(std::unique_ptr<message::platform::RawSensors>& sensors);
         struct NoiseConfig {
             NoiseConfig() = default;
             Eigen::Vector3f accelerometer{0.001, 0.001, 0.001};
             Eigen::Vector3f gyroscope{0.001, 0.001, 0.001};
         } noise;
+        /// Generator for the sensor noise, seeded from the config so runs can be repeated exactly
+        std::mt19937 rng{};
+
+        /// Emitted by the chrono controller once it has reached the current step in stepped mode
+        struct Step {};
+        /// Emitted to move the virtual clock forward one tick in stepped mode once the current step has finished
+        struct Advance {};
+        /// If the simulator is holding the clock still and stepping it forward one tick at a time
+        bool stepped = false;
+        /// The time on the virtual clock in stepped mode
+        NUClear::clock::time_point virtual_time{};
+
+        /**
+         * @brief Has the chrono controller emit the next Step once it has run everything that is due by time
+         *
+         * @param time the time on the virtual clock the step is for
+         */
+        void step_at(const NUClear::clock::time_point& time);
+
+        /**
+         * @brief Moves the servos towards their goals by one tick and emits the new RawSensors
+         *
+         * @param previous_sensors the last Sensors message, used to work out which feet are on the ground
+         */
+        void tick(const std::shared_ptr<const message::input::Sensors>& previous_sensors);
         double bodyTilt                      = 0;
         Eigen::Vector3d integrated_gyroscope = Eigen::Vector3d::Zero();
         void setRightFootDown(bool down);
@@ -0,0 +1,169 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "BudgetTable.hpp"
+
+#include <string>
+
+namespace module::support {
+
+    using message::support::nuclear::ReactionOverrun;
+
+    namespace {
+        /// Converts a clock duration to milliseconds
+        double ms(const NUClear::clock::duration& d) {
+            return std::chrono::duration<double, std::milli>(d).count();
+        }
+    }  // namespace
+
+    BudgetTable::BudgetTable() {
+        configs.push_back(std::make_unique<const Config>());
+        config.store(configs.back().get(), std::memory_order_release);
+    }
+
+    void BudgetTable::configure(const NUClear::clock::duration& report_period, std::vector<Budget> budgets) {
+        const std::lock_guard<std::mutex> lock(configure_mutex);
+
+        auto next           = std::make_unique<Config>();
+        next->generation    = configs.back()->generation + 1;
+        next->report_period = report_period;
+        next->budgets       = std::move(budgets);
+
+        configs.push_back(std::move(next));
+        config.store(configs.back().get(), std::memory_order_release);
+    }
+
+    std::unique_ptr<ReactionOverrun> BudgetTable::record(const Task& task) {
+        const Config& cfg = *config.load(std::memory_order_acquire);
+
+        // Remember this task so later overruns can see what was running alongside them
+        auto& slot = (*recent)[next_recent.fetch_add(1, std::memory_order_relaxed) % RECENT_TASKS];
+        slot.started.store(task.started.time_since_epoch().count(), std::memory_order_relaxed);
+        slot.finished.store(task.finished.time_since_epoch().count(), std::memory_order_relaxed);
+
+        Counters* c = find(task.reaction_id);
+        if (c == nullptr) {
+            return nullptr;
+        }
+        c->count.fetch_add(1, std::memory_order_relaxed);
+
+        const Budget* b = budget(*c, cfg, task);
+        if (b == nullptr) {
+            return nullptr;
+        }
+
+        const auto latency   = task.finished - task.emitted;
+        const auto execution = task.finished - task.started;
+        if (latency <= b->latency && execution <= b->execution) {
+            return nullptr;
+        }
+        c->overruns.fetch_add(1, std::memory_order_relaxed);
+
+        // Only one report per reaction per report period, whoever wins the exchange makes it
+        const int64_t now = task.finished.time_since_epoch().count();
+        int64_t last      = c->last_report.load(std::memory_order_relaxed);
+        if (last != std::numeric_limits<int64_t>::min() && now - last < cfg.report_period.count()) {
+            c->suppressed.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        if (!c->last_report.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+            c->suppressed.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        // Count the recent tasks whose run overlapped this one
+        uint32_t concurrent    = 0;
+        const int64_t started  = task.started.time_since_epoch().count();
+        const int64_t finished = task.finished.time_since_epoch().count();
+        for (const auto& r : *recent) {
+            const int64_t s = r.started.load(std::memory_order_relaxed);
+            const int64_t f = r.finished.load(std::memory_order_relaxed);
+            if (s < finished && f > started && !(s == started && f == finished)) {
+                ++concurrent;
+            }
+        }
+
+        auto msg              = std::make_unique<ReactionOverrun>();
+        msg->name             = std::string(task.name);
+        msg->reactor          = std::string(task.reactor);
+        msg->reaction_id      = task.reaction_id;
+        msg->task_id          = task.task_id;
+        msg->queue_delay      = ms(task.started - task.emitted);
+        msg->execution        = ms(execution);
+        msg->latency          = ms(latency);
+        msg->latency_budget   = ms(b->latency);
+        msg->execution_budget = ms(b->execution);
+        msg->concurrent       = concurrent;
+        msg->count            = c->count.load(std::memory_order_relaxed);
+        msg->overruns         = c->overruns.load(std::memory_order_relaxed);
+        msg->suppressed       = c->suppressed.exchange(0, std::memory_order_relaxed);
+        return msg;
+    }
+
+    BudgetTable::Counters* BudgetTable::find(const uint64_t& reaction_id) {
+        // Reaction ids are handed out in order so a multiplicative hash spreads them over the table
+        const size_t start = (reaction_id * 0x9E3779B97F4A7C15ULL) >> 52;
+        for (size_t i = 0; i < MAX_REACTIONS; ++i) {
+            auto& c = (*counters)[(start + i) & (MAX_REACTIONS - 1)];
+
+            uint64_t id = c.reaction_id.load(std::memory_order_acquire);
+            if (id == reaction_id) {
+                return &c;
+            }
+            if (id == 0) {
+                // Claim the free slot, unless another thread claimed it first for a different reaction
+                if (c.reaction_id.compare_exchange_strong(id, reaction_id, std::memory_order_acq_rel)
+                    || id == reaction_id) {
+                    return &c;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    const BudgetTable::Budget* BudgetTable::budget(Counters& c, const Config& cfg, const Task& task) {
+        uint64_t packed = c.budget.load(std::memory_order_relaxed);
+        auto index      = uint32_t(packed);
+
+        // Look the budget up again if it was never looked up or the config has changed since
+        if (index == UNRESOLVED || uint32_t(packed >> 32) != cfg.generation) {
+            const std::string name = std::string(task.reactor) + " " + std::string(task.name);
+
+            index = NO_BUDGET;
+            for (size_t i = 0; i < cfg.budgets.size(); ++i) {
+                if (std::regex_match(name, cfg.budgets[i].pattern)) {
+                    index = uint32_t(i);
+                    break;
+                }
+            }
+            c.budget.store(uint64_t(cfg.generation) << 32 | index, std::memory_order_relaxed);
+        }
+
+        return index == NO_BUDGET ? nullptr : &cfg.budgets[index];
+    }
+
+}  // namespace module::support
@@ -0,0 +1,173 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MODULE_SUPPORT_REACTIONTIMER_BUDGETTABLE_HPP
+#define MODULE_SUPPORT_REACTIONTIMER_BUDGETTABLE_HPP
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <nuclear>
+#include <regex>
+#include <string_view>
+#include <vector>
+
+#include "message/support/nuclear/ReactionOverrun.hpp"
+
+namespace module::support {
+
+    /**
+     * @brief Latency and execution budgets for reactions, and the counters used to report when they are overrun.
+     *
+     * Recording a task never takes a lock. Counters live in an open addressed table of atomics, and the budgets are
+     * published by swapping an atomic pointer. Budgets that have been replaced are kept until the table is destroyed
+     * as a recording thread may still be reading them, which is cheap since they only change when the config does.
+     */
+    class BudgetTable {
+    public:
+        struct Budget {
+            /// Matched against "Reactor name" for each reaction
+            std::regex pattern;
+            /// Longest time from the task being emitted to it finishing
+            NUClear::clock::duration latency;
+            /// Longest time the task can spend running
+            NUClear::clock::duration execution;
+        };
+
+        /// A task that has finished running
+        struct Task {
+            uint64_t reaction_id;
+            uint64_t task_id;
+            std::string_view reactor;
+            std::string_view name;
+            NUClear::clock::time_point emitted;
+            NUClear::clock::time_point started;
+            NUClear::clock::time_point finished;
+        };
+
+        BudgetTable();
+
+        /**
+         * @brief Replaces the budgets, reactions look their budget up again the next time they run
+         *
+         * @param report_period shortest time between two reports for one reaction
+         * @param budgets       budgets in the order they are matched
+         */
+        void configure(const NUClear::clock::duration& report_period, std::vector<Budget> budgets);
+
+        /**
+         * @brief Counts a finished task and checks it against its budget
+         *
+         * @param task the task that finished
+         *
+         * @return a report if the task overran and its reaction has not been reported within the report period,
+         *         otherwise nullptr
+         */
+        std::unique_ptr<message::support::nuclear::ReactionOverrun> record(const Task& task);
+
+    private:
+        /// The most reactions we keep counters for, must be a power of two
+        static constexpr size_t MAX_REACTIONS = 4096;
+        /// The number of recently finished tasks kept to work out what was running alongside an overrun
+        static constexpr size_t RECENT_TASKS = 256;
+        /// Marks a reaction whose budget has not been looked up since the budgets were last configured
+        static constexpr uint32_t UNRESOLVED = 0xFFFFFFFF;
+        /// Marks a reaction that doesn't match any budget
+        static constexpr uint32_t NO_BUDGET = 0xFFFFFFFE;
+
+        struct Config {
+            /// Incremented each time the config changes so counters know to look their budget up again
+            uint32_t generation = 0;
+            /// Shortest time between two reports for one reaction
+            NUClear::clock::duration report_period{};
+            /// Budgets in the order they are matched
+            std::vector<Budget> budgets;
+        };
+
+        /// Counters for one reaction, updated without locks by whichever thread the statistics arrive on
+        struct Counters {
+            /// The reaction these counters are for, 0 while the slot is free
+            std::atomic<uint64_t> reaction_id{0};
+            /// The config generation in the top 32 bits and the index of the matching budget in the bottom 32
+            std::atomic<uint64_t> budget{UNRESOLVED};
+            /// Number of times the reaction has run
+            std::atomic<uint64_t> count{0};
+            /// Number of times the reaction has overrun
+            std::atomic<uint64_t> overruns{0};
+            /// Overruns since the last report that were not reported
+            std::atomic<uint64_t> suppressed{0};
+            /// When the last overrun report was made, in clock ticks
+            std::atomic<int64_t> last_report{std::numeric_limits<int64_t>::min()};
+        };
+
+        /// A task that finished recently, in clock ticks
+        struct RecentTask {
+            std::atomic<int64_t> started{0};
+            std::atomic<int64_t> finished{0};
+        };
+
+        /// Serialises configure calls, recording never takes it
+        std::mutex configure_mutex;
+        /// Every config that has been published, so the ones being read stay alive
+        std::vector<std::unique_ptr<const Config>> configs;
+        /// The current config
+        std::atomic<const Config*> config{nullptr};
+        /// Open addressed table of counters keyed by reaction id
+        std::unique_ptr<std::array<Counters, MAX_REACTIONS>> counters =
+            std::make_unique<std::array<Counters, MAX_REACTIONS>>();
+        /// Ring buffer of recently finished tasks
+        std::unique_ptr<std::array<RecentTask, RECENT_TASKS>> recent =
+            std::make_unique<std::array<RecentTask, RECENT_TASKS>>();
+        /// Where the next finished task goes in recent
+        std::atomic<uint64_t> next_recent{0};
+
+        /**
+         * @brief Finds or claims the counters for a reaction
+         *
+         * @param reaction_id the reaction to find the counters for
+         *
+         * @return the counters, or nullptr if the table is full
+         */
+        Counters* find(const uint64_t& reaction_id);
+
+        /**
+         * @brief Gets the budget for a reaction, matching its name against the patterns the first time it is seen
+         *
+         * @param c    the counters for the reaction
+         * @param cfg  the current config
+         * @param task the task that just finished
+         *
+         * @return the budget, or nullptr if no pattern matches the reaction
+         */
+        static const Budget* budget(Counters& c, const Config& cfg, const Task& task);
+    };
+
+}  // namespace module::support
+
+#endif  // MODULE_SUPPORT_REACTIONTIMER_BUDGETTABLE_HPP
@@ -26,25 +26,65 @@
  */
 #include "ReactionTimer.hpp"
 
+#include <fmt/format.h>
+
 #include "extension/Configuration.hpp"
 
+#include "message/support/nuclear/ReactionOverrun.hpp"
+
 namespace module::support {
 
     using extension::Configuration;
+    using message::support::nuclear::ReactionOverrun;
     using NUClear::message::ReactionStatistics;
 
     ReactionTimer::ReactionTimer(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
 
-        on<Configuration>("ReactionTimer.yaml").then([this](const Configuration& config) {
-            // Use configuration here from file ReactionTimer.yaml
+        on<Configuration>("ReactionTimer.yaml").then([this](const Configuration& cfg) {
+            log_level = cfg["log_level"].as<NUClear::LogLevel>();
+
+            std::vector<BudgetTable::Budget> budgets;
+            for (const auto& b : cfg["budgets"].config) {
+                budgets.push_back(BudgetTable::Budget{
+                    std::regex(b["pattern"].as<std::string>(), std::regex::optimize),
+                    std::chrono::duration_cast<NUClear::clock::duration>(
+                        std::chrono::duration<double, std::milli>(b["latency"].as<double>())),
+                    std::chrono::duration_cast<NUClear::clock::duration>(
+                        std::chrono::duration<double, std::milli>(b["execution"].as<double>())),
+                });
+            }
+            table.configure(std::chrono::duration_cast<NUClear::clock::duration>(
+                                std::chrono::duration<double>(cfg["report_period"].as<double>())),
+                            std::move(budgets));
         });
 
-        on<Trigger<ReactionStatistics>>().then([this](const ReactionStatistics& stats) {
-            log(stats.identifiers.name,
-                1000.0
-                    * (double((stats.finished - stats.started).count())
-                       / double(NUClear::clock::duration::period::den)),
-                "ms");
+        on<Trigger<ReactionStatistics>>().then("Reaction Timer", [this](const ReactionStatistics& stats) {
+            auto msg = table.record(BudgetTable::Task{stats.reaction_id,
+                                                      stats.task_id,
+                                                      stats.identifiers.reactor,
+                                                      stats.identifiers.name,
+                                                      stats.emitted,
+                                                      stats.started,
+                                                      stats.finished});
+            if (msg == nullptr) {
+                return;
+            }
+
+            log<NUClear::WARN>(fmt::format("{} {} overran: latency {:.3f}/{:.3f} ms, execution {:.3f}/{:.3f} ms, "
+                                           "queued {:.3f} ms, {} concurrent, {} of {} runs overran, {} not reported",
+                                           msg->reactor,
+                                           msg->name,
+                                           msg->latency,
+                                           msg->latency_budget,
+                                           msg->execution,
+                                           msg->execution_budget,
+                                           msg->queue_delay,
+                                           msg->concurrent,
+                                           msg->overruns,
+                                           msg->count,
+                                           msg->suppressed));
+            emit(msg);
         });
     }
+
 }  // namespace module::support
@@ -29,9 +29,14 @@
 
 #include <nuclear>
 
+#include "BudgetTable.hpp"
+
 namespace module::support {
 
     class ReactionTimer : public NUClear::Reactor {
+    private:
+        /// The budgets and the counters of every reaction
+        BudgetTable table;
 
     public:
         /// @brief Called by the powerplant to build and setup the ReactionTimer reactor.
@@ -0,0 +1,138 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <regex>
+#include <vector>
+
+#include "BudgetTable.hpp"
+
+using module::support::BudgetTable;
+using namespace std::chrono_literals;  // NOLINT(google-build-using-namespace) fine in tests
+
+namespace {
+
+    /// Budgets where the platform is tight and everything else is loose
+    std::vector<BudgetTable::Budget> budgets() {
+        return {
+            BudgetTable::Budget{std::regex("module::platform::.*"), 5ms, 2ms},
+            BudgetTable::Budget{std::regex("module::support::.*"), 100ms, 50ms},
+        };
+    }
+
+    /// A platform task that was emitted at start, queued for queue and then ran for run
+    BudgetTable::Task task(const uint64_t& reaction_id,
+                           const NUClear::clock::duration& start,
+                           const NUClear::clock::duration& queue,
+                           const NUClear::clock::duration& run,
+                           const char* reactor = "module::platform::Webots") {
+        const NUClear::clock::time_point emitted(start);
+        return BudgetTable::Task{reaction_id, 1, reactor, "Send IO", emitted, emitted + queue, emitted + queue + run};
+    }
+
+}  // namespace
+
+TEST_CASE("Tasks within their budget are only counted", "[module][support][ReactionTimer]") {
+    BudgetTable table;
+    table.configure(1s, budgets());
+
+    REQUIRE(table.record(task(1, 0s, 1ms, 1ms)) == nullptr);
+    REQUIRE(table.record(task(1, 1s, 2ms, 2ms)) == nullptr);
+
+    // Reactions no pattern matches never report
+    REQUIRE(table.record(task(2, 2s, 1s, 1s, "module::vision::Yolo")) == nullptr);
+}
+
+TEST_CASE("An overrun emits a report describing it", "[module][support][ReactionTimer]") {
+    BudgetTable table;
+    table.configure(1s, budgets());
+
+    REQUIRE(table.record(task(1, 0s, 1ms, 1ms)) == nullptr);
+
+    // Three milliseconds of execution is over the two millisecond execution budget
+    const auto overrun = table.record(task(1, 1s, 1ms, 3ms));
+    REQUIRE(overrun != nullptr);
+    CHECK(overrun->reactor == "module::platform::Webots");
+    CHECK(overrun->name == "Send IO");
+    CHECK(overrun->reaction_id == 1);
+    CHECK(overrun->queue_delay == 1.0);
+    CHECK(overrun->execution == 3.0);
+    CHECK(overrun->latency == 4.0);
+    CHECK(overrun->latency_budget == 5.0);
+    CHECK(overrun->execution_budget == 2.0);
+    CHECK(overrun->count == 2);
+    CHECK(overrun->overruns == 1);
+    CHECK(overrun->suppressed == 0);
+
+    // Queueing alone can also blow the latency budget
+    REQUIRE(table.record(task(3, 2s, 10ms, 1ms)) != nullptr);
+}
+
+TEST_CASE("Overrun reports are rate limited per reaction", "[module][support][ReactionTimer]") {
+    BudgetTable table;
+    table.configure(1s, budgets());
+
+    REQUIRE(table.record(task(1, 0s, 0ms, 3ms)) != nullptr);
+
+    // Further overruns within the report period are counted but not reported
+    REQUIRE(table.record(task(1, 100ms, 0ms, 3ms)) == nullptr);
+    REQUIRE(table.record(task(1, 200ms, 0ms, 3ms)) == nullptr);
+
+    // Other reactions have their own period
+    REQUIRE(table.record(task(2, 300ms, 0ms, 3ms)) != nullptr);
+
+    const auto overrun = table.record(task(1, 2s, 0ms, 3ms));
+    REQUIRE(overrun != nullptr);
+    CHECK(overrun->overruns == 4);
+    CHECK(overrun->suppressed == 2);
+}
+
+TEST_CASE("Reconfiguring the budgets applies them to known reactions", "[module][support][ReactionTimer]") {
+    BudgetTable table;
+    table.configure(0s, budgets());
+    REQUIRE(table.record(task(1, 0s, 0ms, 3ms)) != nullptr);
+
+    // The reaction's budget is looked up again, so the looser budget now covers it
+    table.configure(0s, {BudgetTable::Budget{std::regex("module::platform::.*"), 50ms, 20ms}});
+    REQUIRE(table.record(task(1, 1s, 0ms, 3ms)) == nullptr);
+    REQUIRE(table.record(task(1, 2s, 0ms, 30ms)) != nullptr);
+}
+
+TEST_CASE("Overrun reports count the tasks that ran alongside them", "[module][support][ReactionTimer]") {
+    BudgetTable table;
+    table.configure(1s, budgets());
+
+    // Two tasks that overlap the overrunning one and one that finished before it started
+    REQUIRE(table.record(task(10, 10s, 0ms, 4ms, "module::support::A")) == nullptr);
+    REQUIRE(table.record(task(11, 10s + 2ms, 0ms, 4ms, "module::support::B")) == nullptr);
+    REQUIRE(table.record(task(12, 9s, 0ms, 1ms, "module::support::C")) == nullptr);
+
+    const auto overrun = table.record(task(1, 10s + 1ms, 0ms, 3ms));
+    REQUIRE(overrun != nullptr);
+    CHECK(overrun->concurrent == 2);
+}
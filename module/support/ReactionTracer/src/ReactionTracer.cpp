@@ -0,0 +1,179 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "ReactionTracer.hpp"
+
+#include <csignal>
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <fstream>
+#include <unistd.h>
+
+#include "extension/Configuration.hpp"
+
+#include "message/support/nuclear/DumpTrace.hpp"
+#include "message/support/nuclear/ReactionOverrun.hpp"
+
+namespace module::support {
+
+    using extension::Configuration;
+    using message::support::nuclear::DumpTrace;
+    using message::support::nuclear::ReactionOverrun;
+    using NUClear::message::ReactionStatistics;
+
+    namespace {
+        /// The write end of the pipe that SIGUSR1 pokes, the handler can only use async signal safe calls
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+        volatile int signal_fd = -1;
+
+        void sigusr1(int /*signal*/) {
+            const char poke = 1;
+            // Nothing useful can be done in a signal handler if this fails
+            [[maybe_unused]] auto n = ::write(signal_fd, &poke, 1);
+        }
+    }  // namespace
+
+    ReactionTracer::ReactionTracer(std::unique_ptr<NUClear::Environment> environment)
+        : Reactor(std::move(environment)) {
+
+        on<Configuration>("ReactionTracer.yaml").then([this](const Configuration& config) {
+            log_level = config["log_level"].as<NUClear::LogLevel>();
+
+            cfg.directory      = config["directory"].as<std::string>();
+            cfg.overrun_period = std::chrono::duration_cast<NUClear::clock::duration>(
+                std::chrono::duration<double>(config["overrun_period"].as<double>()));
+
+            // The buffer is written to without locks so it can't be swapped once it exists
+            const auto size = config["buffer_size"].as<uint64_t>();
+            if (buffer.load() == nullptr) {
+                storage = std::make_unique<TraceBuffer>(size);
+                buffer.store(storage.get(), std::memory_order_release);
+            }
+            else if (size > buffer.load()->capacity()) {
+                log<NUClear::WARN>("The trace buffer size only changes when the role is restarted");
+            }
+        });
+
+        on<Trigger<ReactionStatistics>>().then("Reaction Tracer", [this](const ReactionStatistics& stats) {
+            TraceBuffer* ring = buffer.load(std::memory_order_acquire);
+            if (ring == nullptr) {
+                return;
+            }
+
+            // Keep the names of the reaction the first time we see it, so the hot path stays lock free
+            const uint64_t id  = stats.reaction_id;
+            const uint64_t bit = uint64_t(1) << (id % 64);
+            if (id >= NAMED_BITMAP_SIZE || (named[id / 64].load(std::memory_order_relaxed) & bit) == 0) {
+                std::lock_guard<std::mutex> lock(names_mutex);
+                names.try_emplace(id, stats.identifiers.reactor, stats.identifiers.name);
+                if (id < NAMED_BITMAP_SIZE) {
+                    named[id / 64].fetch_or(bit, std::memory_order_relaxed);
+                }
+            }
+
+            ring->record(TraceBuffer::Span{stats.reaction_id,
+                                           stats.task_id,
+                                           stats.cause_reaction_id,
+                                           stats.cause_task_id,
+                                           stats.emitted.time_since_epoch().count(),
+                                           stats.started.time_since_epoch().count(),
+                                           stats.finished.time_since_epoch().count()});
+        });
+
+        on<Trigger<DumpTrace>>().then("Dump Trace", [this](const DumpTrace& request) { dump(request.path); });
+
+        on<Trigger<ReactionOverrun>, Single>().then("Dump Trace On Overrun", [this](const ReactionOverrun& overrun) {
+            const auto now = NUClear::clock::now();
+            if (cfg.overrun_period.count() > 0 && now - last_overrun_dump >= cfg.overrun_period) {
+                last_overrun_dump = now;
+                log<NUClear::INFO>("Writing a trace because", overrun.reactor, overrun.name, "overran");
+                dump({});
+            }
+        });
+
+        // SIGUSR1 writes to a pipe, which wakes this reaction up to write a trace outside of the signal handler
+        std::array<int, 2> fds{};
+        if (::pipe2(fds.data(), O_CLOEXEC | O_NONBLOCK) == 0) {
+            signal_pipe_read  = fds[0];
+            signal_pipe_write = fds[1];
+            signal_fd         = signal_pipe_write;
+
+            struct sigaction action {};
+            action.sa_handler = sigusr1;
+            action.sa_flags   = SA_RESTART;
+            sigaction(SIGUSR1, &action, nullptr);
+
+            on<IO>(signal_pipe_read, IO::READ).then("Dump Trace On Signal", [this] {
+                std::array<char, 64> buffer{};
+                while (::read(signal_pipe_read, buffer.data(), buffer.size()) > 0) {
+                }
+                dump({});
+            });
+        }
+        else {
+            log<NUClear::WARN>("Could not create the pipe for SIGUSR1, traces can only be written on request");
+        }
+    }
+
+    ReactionTracer::~ReactionTracer() {
+        if (signal_pipe_read != -1) {
+            std::signal(SIGUSR1, SIG_DFL);
+            signal_fd = -1;
+            ::close(signal_pipe_read);
+            ::close(signal_pipe_write);
+        }
+    }
+
+    void ReactionTracer::dump(std::filesystem::path path) {
+        const TraceBuffer* ring = buffer.load(std::memory_order_acquire);
+        const std::vector<TraceBuffer::Span> spans =
+            ring != nullptr ? ring->snapshot() : std::vector<TraceBuffer::Span>{};
+        if (spans.empty()) {
+            log<NUClear::WARN>("There are no reactions to write a trace of");
+            return;
+        }
+
+        if (path.empty()) {
+            std::filesystem::create_directories(cfg.directory);
+            const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 std::chrono::system_clock::now().time_since_epoch())
+                                 .count();
+            path = cfg.directory / fmt::format("trace_{}.json", now);
+        }
+
+        TraceBuffer::Names reaction_names;
+        /* Mutex Scope */ {
+            std::lock_guard<std::mutex> lock(names_mutex);
+            reaction_names = names;
+        }
+
+        std::ofstream out(path);
+        TraceBuffer::write(out, spans, reaction_names);
+
+        log<NUClear::INFO>("Wrote", spans.size(), "reactions to", path.string());
+    }
+
+}  // namespace module::support
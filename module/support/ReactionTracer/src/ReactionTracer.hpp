@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MODULE_SUPPORT_REACTIONTRACER_HPP
+#define MODULE_SUPPORT_REACTIONTRACER_HPP
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <nuclear>
+
+#include "TraceBuffer.hpp"
+
+namespace module::support {
+
+    class ReactionTracer : public NUClear::Reactor {
+    private:
+        /// Reaction ids below this are marked as named in a bitmap, so only the first task of a reaction takes a lock
+        static constexpr uint64_t NAMED_BITMAP_SIZE = 65536;
+
+        /// Owns the ring buffer, which is allocated once with the first configuration
+        std::unique_ptr<TraceBuffer> storage;
+        /// The ring buffer of tasks, null until it is allocated
+        std::atomic<TraceBuffer*> buffer{nullptr};
+
+        /// Which reaction ids already have their names stored
+        std::array<std::atomic<uint64_t>, NAMED_BITMAP_SIZE / 64> named{};
+        /// Guards names
+        std::mutex names_mutex;
+        /// The reactor and name of each reaction that has been seen
+        TraceBuffer::Names names;
+
+        struct {
+            /// The directory trace files are written to
+            std::filesystem::path directory;
+            /// The shortest time between two traces written because of overruns, zero to not write them
+            NUClear::clock::duration overrun_period{};
+        } cfg;
+
+        /// When the last trace because of an overrun was written
+        NUClear::clock::time_point last_overrun_dump{};
+
+        /// Read end of the pipe the signal handler writes to
+        int signal_pipe_read = -1;
+        /// Write end of the pipe the signal handler writes to
+        int signal_pipe_write = -1;
+
+        /**
+         * @brief Writes the spans in the ring buffer to a Chrome trace file
+         *
+         * @param path the file to write, or empty for a timestamped file in the configured directory
+         */
+        void dump(std::filesystem::path path);
+
+    public:
+        /// @brief Called by the powerplant to build and setup the ReactionTracer reactor.
+        explicit ReactionTracer(std::unique_ptr<NUClear::Environment> environment);
+        ReactionTracer(const ReactionTracer&)            = delete;
+        ReactionTracer(ReactionTracer&&)                 = delete;
+        ReactionTracer& operator=(const ReactionTracer&) = delete;
+        ReactionTracer& operator=(ReactionTracer&&)      = delete;
+        ~ReactionTracer() override;
+    };
+
+}  // namespace module::support
+
+#endif  // MODULE_SUPPORT_REACTIONTRACER_HPP
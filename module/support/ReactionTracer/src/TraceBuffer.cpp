@@ -0,0 +1,192 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "TraceBuffer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fmt/format.h>
+#include <nuclear>
+
+namespace module::support {
+
+    namespace {
+        /// Escapes a string for a json string literal
+        std::string escape(const std::string& in) {
+            std::string out;
+            out.reserve(in.size());
+            for (const char c : in) {
+                switch (c) {
+                    case '"': out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\n': out += "\\n"; break;
+                    case '\t': out += "\\t"; break;
+                    default:
+                        if (uint8_t(c) < 0x20) {
+                            out += fmt::format("\\u{:04x}", int(c));
+                        }
+                        else {
+                            out += c;
+                        }
+                }
+            }
+            return out;
+        }
+
+        /// Converts clock ticks to the microseconds chrome traces use
+        double us(const int64_t& ticks) {
+            return std::chrono::duration<double, std::micro>(NUClear::clock::duration(ticks)).count();
+        }
+    }  // namespace
+
+    TraceBuffer::TraceBuffer(const uint64_t& size) {
+        uint64_t capacity = 1;
+        while (capacity < size) {
+            capacity <<= 1;
+        }
+        slots = std::make_unique<Slot[]>(capacity);  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+        mask  = capacity - 1;
+    }
+
+    void TraceBuffer::record(const Span& span) {
+        // Claim the next slot, marking it as being written until all the fields are in
+        const uint64_t index = head.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot           = slots[index & mask];
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.reaction_id.store(span.reaction_id, std::memory_order_relaxed);
+        slot.task_id.store(span.task_id, std::memory_order_relaxed);
+        slot.cause_reaction_id.store(span.cause_reaction_id, std::memory_order_relaxed);
+        slot.cause_task_id.store(span.cause_task_id, std::memory_order_relaxed);
+        slot.emitted.store(span.emitted, std::memory_order_relaxed);
+        slot.started.store(span.started, std::memory_order_relaxed);
+        slot.finished.store(span.finished, std::memory_order_relaxed);
+
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+    }
+
+    std::vector<TraceBuffer::Span> TraceBuffer::snapshot() const {
+        std::vector<Span> spans;
+        spans.reserve(mask + 1);
+        for (uint64_t i = 0; i <= mask; ++i) {
+            const Slot& slot        = slots[i];
+            const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+            // Skip slots that were never written or are being written right now
+            if (sequence == 0 || sequence % 2 == 1) {
+                continue;
+            }
+
+            Span span;
+            span.reaction_id       = slot.reaction_id.load(std::memory_order_relaxed);
+            span.task_id           = slot.task_id.load(std::memory_order_relaxed);
+            span.cause_reaction_id = slot.cause_reaction_id.load(std::memory_order_relaxed);
+            span.cause_task_id     = slot.cause_task_id.load(std::memory_order_relaxed);
+            span.emitted           = slot.emitted.load(std::memory_order_relaxed);
+            span.started           = slot.started.load(std::memory_order_relaxed);
+            span.finished          = slot.finished.load(std::memory_order_relaxed);
+
+            // If a writer got to the slot while we were reading it the span is torn
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+                spans.push_back(span);
+            }
+        }
+
+        std::sort(spans.begin(), spans.end(), [](const Span& a, const Span& b) { return a.started < b.started; });
+        return spans;
+    }
+
+    void TraceBuffer::write(std::ostream& out, const std::vector<Span>& spans, const Names& names) {
+        // Put each task in the first lane that has finished its last task by the time this one starts
+        std::vector<int64_t> lane_free;
+        // The lane each task ran in, so cause links can start from the right row
+        std::map<uint64_t, int> task_tids;
+        for (const auto& span : spans) {
+            auto lane = std::find_if(lane_free.begin(), lane_free.end(), [&](const int64_t& t) {
+                return t <= span.started;
+            });
+            if (lane == lane_free.end()) {
+                lane = lane_free.insert(lane_free.end(), span.finished);
+            }
+            *lane                   = span.finished;
+            task_tids[span.task_id] = int(std::distance(lane_free.begin(), lane)) + 1;
+        }
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        for (int tid = 1; tid <= int(lane_free.size()); ++tid) {
+            out << fmt::format(R"({{"ph":"M","pid":1,"tid":{},"name":"thread_name","args":{{"name":"Lane {}"}}}},)",
+                               tid,
+                               tid)
+                << "\n";
+        }
+
+        bool first = true;
+        for (const auto& span : spans) {
+            const auto it             = names.find(span.reaction_id);
+            const std::string reactor = it != names.end() ? escape(it->second.first) : "";
+            const std::string name    = it != names.end() ? escape(it->second.second) : "";
+            const std::string label   = name.empty() ? fmt::format("{} #{}", reactor, span.reaction_id) : name;
+            const int tid             = task_tids[span.task_id];
+
+            out << (first ? "" : ",\n");
+            first = false;
+
+            // The task itself, with how long it waited in the queue
+            out << fmt::format(R"({{"ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f},"name":"{}","cat":"{}",)"
+                               R"("args":{{"reaction_id":{},"task_id":{},"cause_task_id":{},"queued_us":{:.3f}}}}})",
+                               tid,
+                               us(span.started),
+                               us(span.finished - span.started),
+                               label,
+                               reactor,
+                               span.reaction_id,
+                               span.task_id,
+                               span.cause_task_id,
+                               us(span.started - span.emitted));
+
+            // An arrow from where the cause emitted this task to where it started, if the cause is in the trace
+            auto cause = task_tids.find(span.cause_task_id);
+            if (span.cause_task_id != 0 && cause != task_tids.end()) {
+                out << fmt::format(",\n"
+                                   R"({{"ph":"s","pid":1,"tid":{},"ts":{:.3f},"id":{},"name":"cause","cat":"cause"}},)"
+                                   "\n"
+                                   R"({{"ph":"f","bp":"e","pid":1,"tid":{},"ts":{:.3f},"id":{},"name":"cause",)"
+                                   R"("cat":"cause"}})",
+                                   cause->second,
+                                   us(span.emitted),
+                                   span.task_id,
+                                   tid,
+                                   us(span.started),
+                                   span.task_id);
+            }
+        }
+        out << "\n]}\n";
+    }
+
+}  // namespace module::support
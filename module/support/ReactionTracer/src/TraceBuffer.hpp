@@ -0,0 +1,126 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MODULE_SUPPORT_REACTIONTRACER_TRACEBUFFER_HPP
+#define MODULE_SUPPORT_REACTIONTRACER_TRACEBUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace module::support {
+
+    /**
+     * @brief A fixed size ring buffer of finished tasks that can be written out as a Chrome trace.
+     *
+     * Recording a task never takes a lock. Each slot is guarded by a sequence number so a snapshot can skip slots that
+     * are being written while it reads them.
+     */
+    class TraceBuffer {
+    public:
+        /// One finished task, times are in clock ticks
+        struct Span {
+            uint64_t reaction_id       = 0;
+            uint64_t task_id           = 0;
+            uint64_t cause_reaction_id = 0;
+            uint64_t cause_task_id     = 0;
+            int64_t emitted            = 0;
+            int64_t started            = 0;
+            int64_t finished           = 0;
+        };
+
+        /// The reactor and reaction name for each reaction id
+        using Names = std::map<uint64_t, std::pair<std::string, std::string>>;
+
+        /**
+         * @brief Allocates the ring buffer
+         *
+         * @param size the least number of tasks to keep, rounded up to a power of two
+         */
+        explicit TraceBuffer(const uint64_t& size);
+
+        /// @brief The number of tasks the buffer keeps
+        [[nodiscard]] uint64_t capacity() const {
+            return mask + 1;
+        }
+
+        /**
+         * @brief Writes a finished task over the oldest one in the buffer
+         *
+         * @param span the task that finished
+         */
+        void record(const Span& span);
+
+        /**
+         * @brief Copies out the spans in the ring buffer that aren't being overwritten, in the order they started
+         *
+         * @return the spans
+         */
+        [[nodiscard]] std::vector<Span> snapshot() const;
+
+        /**
+         * @brief Writes spans in the Chrome trace event format, which Perfetto and chrome://tracing both open
+         *
+         * NUClear's statistics don't say which thread ran a task, so each row of the trace is a lane of tasks that
+         * didn't overlap. A task goes in the first lane that is free when it starts, so there are as many lanes as the
+         * most tasks that were running at once.
+         *
+         * @param out   the stream to write the trace to
+         * @param spans the spans to write, in the order they started
+         * @param names the reactor and name of the reactions in the spans
+         */
+        static void write(std::ostream& out, const std::vector<Span>& spans, const Names& names);
+
+    private:
+        /// A ring buffer slot, the sequence is odd while the slot is being written, otherwise 2 * (index written + 1)
+        struct Slot {
+            std::atomic<uint64_t> sequence{0};
+            std::atomic<uint64_t> reaction_id{0};
+            std::atomic<uint64_t> task_id{0};
+            std::atomic<uint64_t> cause_reaction_id{0};
+            std::atomic<uint64_t> cause_task_id{0};
+            std::atomic<int64_t> emitted{0};
+            std::atomic<int64_t> started{0};
+            std::atomic<int64_t> finished{0};
+        };
+
+        /// The ring buffer of spans
+        std::unique_ptr<Slot[]> slots;  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+        /// The number of slots in the ring buffer minus one, the size is a power of two
+        uint64_t mask = 0;
+        /// The total number of spans that have been written
+        std::atomic<uint64_t> head{0};
+    };
+
+}  // namespace module::support
+
+#endif  // MODULE_SUPPORT_REACTIONTRACER_TRACEBUFFER_HPP
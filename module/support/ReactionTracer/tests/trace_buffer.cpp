@@ -0,0 +1,151 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <nuclear>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "TraceBuffer.hpp"
+
+using module::support::TraceBuffer;
+using namespace std::chrono_literals;  // NOLINT(google-build-using-namespace) fine in tests
+
+namespace {
+
+    /// Converts a time from the start of the trace to clock ticks
+    int64_t ticks(const NUClear::clock::duration& t) {
+        return t.count();
+    }
+
+    /// A task that was emitted at emitted, then ran from started until finished
+    TraceBuffer::Span span(const uint64_t& reaction_id,
+                           const uint64_t& task_id,
+                           const uint64_t& cause_task_id,
+                           const NUClear::clock::duration& emitted,
+                           const NUClear::clock::duration& started,
+                           const NUClear::clock::duration& finished) {
+        return TraceBuffer::Span{reaction_id,
+                                 task_id,
+                                 0,
+                                 cause_task_id,
+                                 ticks(emitted),
+                                 ticks(started),
+                                 ticks(finished)};
+    }
+
+    std::vector<uint64_t> task_ids(const std::vector<TraceBuffer::Span>& spans) {
+        std::vector<uint64_t> ids;
+        for (const auto& s : spans) {
+            ids.push_back(s.task_id);
+        }
+        return ids;
+    }
+
+    std::vector<std::string> lines(const std::string& text) {
+        std::vector<std::string> out;
+        std::istringstream in(text);
+        for (std::string line; std::getline(in, line);) {
+            out.push_back(line);
+        }
+        return out;
+    }
+
+}  // namespace
+
+TEST_CASE("A snapshot has the recorded tasks in the order they started", "[module][support][ReactionTracer]") {
+    TraceBuffer buffer(8);
+    REQUIRE(buffer.capacity() == 8);
+    REQUIRE(buffer.snapshot().empty());
+
+    // Statistics arrive in the order tasks finish, not the order they started
+    buffer.record(span(1, 12, 0, 0ms, 2ms, 3ms));
+    buffer.record(span(1, 11, 0, 0ms, 1ms, 4ms));
+    buffer.record(span(2, 13, 11, 2ms, 5ms, 6ms));
+
+    const auto spans = buffer.snapshot();
+    REQUIRE(task_ids(spans) == std::vector<uint64_t>{11, 12, 13});
+    CHECK(spans[2].reaction_id == 2);
+    CHECK(spans[2].cause_task_id == 11);
+    CHECK(spans[2].emitted == ticks(2ms));
+    CHECK(spans[2].started == ticks(5ms));
+    CHECK(spans[2].finished == ticks(6ms));
+}
+
+TEST_CASE("The ring keeps the newest tasks once it is full", "[module][support][ReactionTracer]") {
+    // The size is rounded up to a power of two
+    TraceBuffer buffer(3);
+    REQUIRE(buffer.capacity() == 4);
+
+    for (int i = 1; i <= 6; ++i) {
+        buffer.record(span(1, i, 0, i * 1ms, i * 1ms, i * 1ms + 500us));
+    }
+    REQUIRE(task_ids(buffer.snapshot()) == std::vector<uint64_t>{3, 4, 5, 6});
+}
+
+TEST_CASE("Tasks are written as a Chrome trace with overlapping tasks in separate lanes",
+          "[module][support][ReactionTracer]") {
+    TraceBuffer buffer(8);
+
+    // A runs the whole time, B overlaps it so needs a second lane, C starts once A is done so goes back in the first
+    buffer.record(span(1, 11, 0, 0ms, 0ms, 10ms));
+    buffer.record(span(2, 12, 11, 1ms, 2ms, 5ms));
+    buffer.record(span(3, 13, 12, 4ms, 12ms, 14ms));
+    // The task that caused D is not in the trace, so it gets no arrow
+    buffer.record(span(2, 14, 99, 6ms, 6ms, 7ms));
+
+    const TraceBuffer::Names names = {
+        {1, {"module::A", "Run \"A\""}},
+        {2, {"module::B", "Run B"}},
+        {3, {"module::C", ""}},
+    };
+
+    std::ostringstream out;
+    TraceBuffer::write(out, buffer.snapshot(), names);
+
+    const std::vector<std::string> expected = {
+        R"({"displayTimeUnit":"ms","traceEvents":[)",
+        R"({"ph":"M","pid":1,"tid":1,"name":"thread_name","args":{"name":"Lane 1"}},)",
+        R"({"ph":"M","pid":1,"tid":2,"name":"thread_name","args":{"name":"Lane 2"}},)",
+        R"({"ph":"X","pid":1,"tid":1,"ts":0.000,"dur":10000.000,"name":"Run \"A\"","cat":"module::A",)"
+        R"("args":{"reaction_id":1,"task_id":11,"cause_task_id":0,"queued_us":0.000}},)",
+        R"({"ph":"X","pid":1,"tid":2,"ts":2000.000,"dur":3000.000,"name":"Run B","cat":"module::B",)"
+        R"("args":{"reaction_id":2,"task_id":12,"cause_task_id":11,"queued_us":1000.000}},)",
+        R"({"ph":"s","pid":1,"tid":1,"ts":1000.000,"id":12,"name":"cause","cat":"cause"},)",
+        R"({"ph":"f","bp":"e","pid":1,"tid":2,"ts":2000.000,"id":12,"name":"cause","cat":"cause"},)",
+        R"({"ph":"X","pid":1,"tid":2,"ts":6000.000,"dur":1000.000,"name":"Run B","cat":"module::B",)"
+        R"("args":{"reaction_id":2,"task_id":14,"cause_task_id":99,"queued_us":0.000}},)",
+        R"({"ph":"X","pid":1,"tid":1,"ts":12000.000,"dur":2000.000,"name":"module::C #3","cat":"module::C",)"
+        R"("args":{"reaction_id":3,"task_id":13,"cause_task_id":12,"queued_us":8000.000}},)",
+        R"({"ph":"s","pid":1,"tid":2,"ts":4000.000,"id":13,"name":"cause","cat":"cause"},)",
+        R"({"ph":"f","bp":"e","pid":1,"tid":1,"ts":12000.000,"id":13,"name":"cause","cat":"cause"})",
+        R"(]})",
+    };
+    REQUIRE(lines(out.str()) == expected);
+}
@@ -27,6 +27,9 @@
 
 #include "ConsoleLogHandler.hpp"
 
+#include <sstream>
+#include <unistd.h>
+
 #include "utility/strutil/ansi.hpp"
 #include "utility/support/evil/pure_evil.hpp"
 
@@ -37,11 +40,11 @@ namespace module::support::logging {
     using utility::strutil::Colour;
 
     ConsoleLogHandler::ConsoleLogHandler(std::unique_ptr<NUClear::Environment> environment)
-        : Reactor(std::move(environment)) {
+        : Reactor(std::move(environment)), sink(STDERR_FILENO, utility::io::LogSink::Config()) {
         on<Trigger<ReactionStatistics>>().then([this](const ReactionStatistics& stats) {
             if (stats.exception) {
 
-                std::lock_guard<std::mutex> lock(mutex);
+                std::ostringstream out;
 
                 // Get our reactor name
                 std::string reactor = stats.identifiers.reactor;
@@ -64,16 +67,16 @@ namespace module::support::logging {
                 }
 
                 // Print our exception details
-                std::cerr << reactor << " "
-                          << (stats.identifiers.name.empty() ? "" : "- " + stats.identifiers.name + " ")
-                          << Colour::brightred << "(╯°□°）╯︵ ┻━┻ "
-                          << " " << Colour::brightred << utility::support::evil::exception_name << " " << exception_what
-                          << std::endl;
+                out << reactor << " "
+                    << (stats.identifiers.name.empty() ? "" : "- " + stats.identifiers.name + " ")
+                    << Colour::brightred << "(╯°□°）╯︵ ┻━┻ "
+                    << " " << Colour::brightred << utility::support::evil::exception_name() << " "
+                    << exception_what << "\n";
 
                 // Print our stack trace
-                for (auto& s : utility::support::evil::stack) {
-                    std::cerr << "\t" << Colour::brightmagenta << s.file << ":" << Colour::brightmagenta << s.lineno
-                              << " " << s.function << std::endl;
+                for (auto& s : utility::support::evil::stack()) {
+                    out << "\t" << Colour::brightmagenta << s.file << ":" << Colour::brightmagenta << s.lineno
+                        << " " << s.function << "\n";
                 }
 #else
                 try {
@@ -83,19 +86,21 @@ namespace module::support::logging {
 
                     std::string exceptionName = NUClear::util::demangle(typeid(ex).name());
 
-                    std::cerr << reactor << " "
-                              << (stats.identifiers.name.empty() ? "" : "- " + stats.identifiers.name + " ")
-                              << Colour::brightred << "(╯°□°）╯︵ ┻━┻ "
-                              << " " << Colour::brightred << exceptionName << " " << ex.what() << std::endl;
+                    out << reactor << " "
+                        << (stats.identifiers.name.empty() ? "" : "- " + stats.identifiers.name + " ")
+                        << Colour::brightred << "(╯°□°）╯︵ ┻━┻ "
+                        << " " << Colour::brightred << exceptionName << " " << ex.what() << "\n";
                 }
                 // We don't actually want to crash
                 catch (...) {
 
-                    std::cerr << reactor << " "
-                              << (stats.identifiers.name.empty() ? "" : "- " + stats.identifiers.name + " ")
-                              << Colour::brightred << "(ノಠ益ಠ)ノ彡┻━┻" << std::endl;
+                    out << reactor << " "
+                        << (stats.identifiers.name.empty() ? "" : "- " + stats.identifiers.name + " ")
+                        << Colour::brightred << "(ノಠ益ಠ)ノ彡┻━┻\n";
                 }
 #endif
+
+                sink.write(out.str(), true);
             }
         });
 
@@ -105,7 +110,7 @@ namespace module::support::logging {
             if (message.level < message.display_level) {
                 return;
             };
-            std::lock_guard<std::mutex> lock(mutex);
+            std::ostringstream out;
 
             // Where this message came from
             std::string source = "";
@@ -126,17 +131,20 @@ namespace module::support::logging {
 
             // Output the level
             switch (message.level) {
-                case NUClear::TRACE: std::cerr << source << "TRACE: "; break;
-                case NUClear::DEBUG: std::cerr << source << Colour::green << "DEBUG: "; break;
-                case NUClear::INFO: std::cerr << source << Colour::brightblue << "INFO: "; break;
-                case NUClear::WARN: std::cerr << source << Colour::yellow << "WARN: "; break;
-                case NUClear::ERROR: std::cerr << source << Colour::brightred << "(╯°□°）╯︵ ┻━┻: "; break;
+                case NUClear::TRACE: out << source << "TRACE: "; break;
+                case NUClear::DEBUG: out << source << Colour::green << "DEBUG: "; break;
+                case NUClear::INFO: out << source << Colour::brightblue << "INFO: "; break;
+                case NUClear::WARN: out << source << Colour::yellow << "WARN: "; break;
+                case NUClear::ERROR: out << source << Colour::brightred << "(╯°□°）╯︵ ┻━┻: "; break;
                 case NUClear::UNKNOWN:;
-                case NUClear::FATAL: std::cerr << source << Colour::brightred << "(ノಠ益ಠ)ノ彡┻━┻: "; break;
+                case NUClear::FATAL: out << source << Colour::brightred << "(ノಠ益ಠ)ノ彡┻━┻: "; break;
             }
 
             // Output the message
-            std::cerr << message.message << std::endl;
+            out << message.message << "\n";
+
+            // Errors are written straight away so they aren't lost if we are about to crash
+            sink.write(out.str(), message.level >= NUClear::ERROR);
         });
     }
 
@@ -28,9 +28,10 @@
 #ifndef MODULES_SUPPORT_LOGGING_CONSOLELOGHANDLER_HPP
 #define MODULES_SUPPORT_LOGGING_CONSOLELOGHANDLER_HPP
 
-#include <mutex>
 #include <nuclear>
 
+#include "utility/io/LogSink.hpp"
+
 namespace module::support::logging {
 
     /**
@@ -40,7 +41,8 @@ namespace module::support::logging {
      */
     class ConsoleLogHandler : public NUClear::Reactor {
     private:
-        std::mutex mutex;
+        /// Writes to stderr on its own thread so logging threads never wait on the terminal
+        utility::io::LogSink sink;
 
     public:
         explicit ConsoleLogHandler(std::unique_ptr<NUClear::Environment> environment);
@@ -108,7 +108,9 @@ namespace module::support::logging {
                 index_file_path = output_file_path;
                 index_file_path += ".idx";
 
-                encoder = std::make_unique<utility::nbs::Encoder>(output_file_path, index_file_path);
+                encoder = std::make_unique<utility::nbs::Encoder>(output_file_path,
+                                                                  index_file_path,
+                                                                  config.output.frame_size);
             }
 
             encoder->write(data.timestamp, data.message_timestamp, data.hash, data.id, data.data);
@@ -143,6 +145,7 @@ namespace module::support::logging {
                 // Get the details we need to generate a log file name
                 config.output.directory  = cfg["output"]["directory"].as<std::string>();
                 config.output.split_size = cfg["output"]["split_size"].as<Expression>();
+                config.output.frame_size = cfg["output"]["frame_size"].as<Expression>();
 
                 // Get the name of the currently running binary
                 std::vector<uint8_t> data(argv[0].cbegin(), argv[0].cend());
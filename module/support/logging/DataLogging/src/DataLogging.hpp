@@ -67,6 +67,8 @@ namespace module::support::logging {
                 std::string binary;
                 /// The threshold of bytes where after this we split the file
                 uint64_t split_size{};
+                /// The uncompressed size of each zstd frame, or 0 to write plain nbs files
+                uint32_t frame_size{};
             } output;
         } config;
 
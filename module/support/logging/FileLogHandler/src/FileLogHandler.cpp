@@ -26,10 +26,13 @@
  */
 #include "FileLogHandler.hpp"
 
+#include <sstream>
+
 #include "extension/Configuration.hpp"
 
 #include "utility/strutil/ansi.hpp"
 #include "utility/support/evil/pure_evil.hpp"
+#include "utility/support/yaml_expression.hpp"
 
 namespace module::support::logging {
 
@@ -38,36 +41,37 @@ namespace module::support::logging {
 
     using extension::Configuration;
 
+    using utility::io::LogSink;
     using utility::strutil::Colour;
+    using utility::support::Expression;
 
     FileLogHandler::FileLogHandler(std::unique_ptr<NUClear::Environment> environment)
-        : Reactor(std::move(environment))
-        , log_file_name("/home/nubots/log")
-        , log_file(log_file_name, std::ios_base::out | std::ios_base::app | std::ios_base::ate) {
+        : Reactor(std::move(environment)) {
 
         on<Configuration>("FileLogHandler.yaml").then([this](const Configuration& config) {
             // Use configuration here from file FileLogHandler.yaml
-            log_file_name = config["log_file"].as<std::string>();
-
-            if (log_file.is_open()) {
-                log_file.close();
-            }
+            LogSink::Config cfg;
+            cfg.queue_size    = config["queue_size"].as<Expression>();
+            cfg.flush_size    = config["flush_size"].as<Expression>();
+            cfg.flush_period  = std::chrono::milliseconds(config["flush_period"].as<int>());
+            cfg.max_file_size = config["max_file_size"].as<Expression>();
+            cfg.max_files     = config["max_files"].as<int>();
 
-            log_file.open(log_file_name, std::ios_base::out | std::ios_base::app | std::ios_base::ate);
+            // The old sink finishes writing what it has queued once the last thread using it lets go
+            sink.store(std::make_shared<LogSink>(config["log_file"].as<std::string>(), cfg));
 
-            log_file << "\n*********************************************************************\n" << std::endl;
+            write("\n*********************************************************************\n\n", false);
         });
 
         on<Shutdown>().then([this] {
-            if (log_file.is_open()) {
-                log_file.close();
-            }
+            // Write out everything that is still queued
+            sink.store(nullptr);
         });
 
         on<Trigger<ReactionStatistics>>().then([this](const ReactionStatistics& stats) {
             if (stats.exception) {
 
-                std::lock_guard<std::mutex> lock(mutex);
+                std::ostringstream log_file;
 
                 // Get our reactor name
                 std::string reactor = stats.identifiers.reactor;
@@ -82,12 +86,12 @@ namespace module::support::logging {
                 log_file << reactor << " "
                          << (stats.identifiers.name.empty() ? "" : "- " + stats.identifiers.name + " ")
                          << Colour::brightred << "Exception:"
-                         << " " << Colour::brightred << utility::support::evil::exception_name << std::endl;
+                         << " " << Colour::brightred << utility::support::evil::exception_name() << "\n";
 
                 // Print our stack trace
-                for (auto& s : utility::support::evil::stack) {
+                for (auto& s : utility::support::evil::stack()) {
                     log_file << "\t" << Colour::brightmagenta << s.file << ":" << Colour::brightmagenta << s.lineno
-                             << " " << s.function << std::endl;
+                             << " " << s.function << "\n";
                 }
 #else
                 try {
@@ -100,21 +104,23 @@ namespace module::support::logging {
                     log_file << reactor << " "
                              << (stats.identifiers.name.empty() ? "" : "- " + stats.identifiers.name + " ")
                              << Colour::brightred << "Exception:"
-                             << " " << Colour::brightred << exception_name << " " << ex.what() << std::endl;
+                             << " " << Colour::brightred << exception_name << " " << ex.what() << "\n";
                 }
                 // We don't actually want to crash
                 catch (...) {
 
                     log_file << reactor << " "
                              << (stats.identifiers.name.empty() ? "" : "- " + stats.identifiers.name + " ")
-                             << Colour::brightred << "Exception of unkown type" << std::endl;
+                             << Colour::brightred << "Exception of unkown type\n";
                 }
 #endif
+
+                write(log_file.str(), true);
             }
         });
 
         on<Trigger<LogMessage>>().then([this](const LogMessage& message) {
-            std::lock_guard<std::mutex> lock(mutex);
+            std::ostringstream log_file;
 
             // Where this message came from
             std::string source = "";
@@ -145,7 +151,16 @@ namespace module::support::logging {
             }
 
             // Output the message
-            log_file << message.message << std::endl;
+            log_file << message.message << "\n";
+
+            // Errors are written straight away so they aren't lost if we are about to crash
+            write(log_file.str(), message.level >= NUClear::ERROR);
         });
     }
+
+    void FileLogHandler::write(std::string record, bool urgent) {
+        if (auto current = sink.load()) {
+            current->write(std::move(record), urgent);
+        }
+    }
 }  // namespace module::support::logging
@@ -27,11 +27,13 @@
 #ifndef MODULE_SUPPORT_LOGGING_FILELOGHANDLER_HPP
 #define MODULE_SUPPORT_LOGGING_FILELOGHANDLER_HPP
 
-#include <fstream>
-#include <mutex>
+#include <atomic>
+#include <memory>
 #include <nuclear>
 #include <string>
 
+#include "utility/io/LogSink.hpp"
+
 namespace module::support::logging {
 
     class FileLogHandler : public NUClear::Reactor {
@@ -41,10 +43,17 @@ namespace module::support::logging {
         explicit FileLogHandler(std::unique_ptr<NUClear::Environment> environment);
 
     private:
-        std::mutex mutex;
+        /**
+         * @brief Queues a formatted record on the current sink, if there is one
+         *
+         * @param record the text to write
+         * @param urgent if the record is an error that should be written straight away
+         */
+        void write(std::string record, bool urgent);
 
-        std::string log_file_name;
-        std::ofstream log_file;
+        /// The sink that writes our log file, atomic so it can be replaced on reconfiguration while other threads are
+        /// logging
+        std::atomic<std::shared_ptr<utility::io::LogSink>> sink;
     };
 }  // namespace module::support::logging
 
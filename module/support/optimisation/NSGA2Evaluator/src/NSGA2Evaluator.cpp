@@ -28,6 +28,7 @@
 
 #include <fmt/format.h>
 #include <fmt/ostream.h>
+#include <unistd.h>
 #include <yaml-cpp/yaml.h>
 
 #include "tasks/RotationEvaluator.hpp"
@@ -51,6 +52,7 @@
 
 #include "utility/input/LimbID.hpp"
 #include "utility/input/ServoID.hpp"
+#include "utility/support/hostname.hpp"
 #include "utility/support/yaml_expression.hpp"
 
 namespace module::support::optimisation {
@@ -79,7 +81,12 @@ namespace module::support::optimisation {
     using utility::support::Expression;
 
     NSGA2Evaluator::NSGA2Evaluator(std::unique_ptr<NUClear::Environment> environment)
-        : BehaviourReactor(std::move(environment)) {
+        : BehaviourReactor(std::move(environment))
+        , name(fmt::format("{}:{}", utility::support::getHostname(), ::getpid())) {
+
+        on<Configuration>("NSGA2Evaluator.yaml").then([this](const Configuration& config) {
+            cfg.network = config["network"].as<bool>();
+        });
 
         on<Startup>().then([this] {
             // When starting up have the robot stand
@@ -127,10 +134,18 @@ namespace module::support::optimisation {
         });
 
         on<Trigger<NSGA2EvaluationRequest>, Single>().then([this](const NSGA2EvaluationRequest& request) {
-            last_eval_request_msg = request;
-            emit(std::make_unique<Event>(Event(Event::Value::EVALUATE_REQUEST)));
+            if (!cfg.network) {
+                handle_request(request);
+            }
         });
 
+        on<Network<NSGA2EvaluationRequest>, Single>().then(
+            [this](const NUClear::dsl::word::NetworkSource& /*source*/, const NSGA2EvaluationRequest& request) {
+                if (cfg.network) {
+                    handle_request(request);
+                }
+            });
+
         on<Trigger<NSGA2TrialExpired>, Single>().then([this](const NSGA2TrialExpired& message) {
             // Only start terminating gracefully if the trial that just expired is the current one
             // (and not previous ones that have terminated early)
@@ -159,11 +174,25 @@ namespace module::support::optimisation {
             emit(std::make_unique<Event>(Event(Event::Value::TERMINATE_EVALUATION)));
         });
 
+        on<Network<NSGA2Terminate>, Single>().then([this]() {
+            if (cfg.network) {
+                emit(std::make_unique<Event>(Event(Event::Value::TERMINATE_EVALUATION)));
+                powerplant.shutdown();
+            }
+        });
+
         on<Trigger<NSGA2EvaluatorReadinessQuery>, Single>().then([this]() {
             // NSGA2EvaluatorReadinessQuery is the optimiser checking if we're ready
             emit(std::make_unique<Event>(Event(Event::Value::CHECK_READY)));
         });
 
+        on<Network<NSGA2EvaluatorReadinessQuery>, Single>().then([this]() {
+            // Only answer if we are idle, otherwise we will say we're ready once we have sent our scores
+            if (cfg.network && current_state.value == State::Value::WAITING_FOR_REQUEST) {
+                emit(std::make_unique<Event>(Event(Event::Value::CHECK_READY)));
+            }
+        });
+
         on<Trigger<OptimisationRobotPosition>, Single>().then([this](const OptimisationRobotPosition& position) {
             if (current_state.value == State::Value::EVALUATING) {
                 task->process_optimisation_robot_position(position);
@@ -192,6 +221,15 @@ namespace module::support::optimisation {
         }
     }
 
+    void NSGA2Evaluator::handle_request(const NSGA2EvaluationRequest& request) {
+        // When several evaluators share the network, requests are addressed to a single one of them
+        if (!request.evaluator.empty() && cfg.network && request.evaluator != name) {
+            return;
+        }
+        last_eval_request_msg = request;
+        emit(std::make_unique<Event>(Event(Event::Value::EVALUATE_REQUEST)));
+    }
+
     void NSGA2Evaluator::walk(Eigen::Vector3d vec3) {
         emit<Task>(std::make_unique<Walk>(vec3), 1);
     }
@@ -199,7 +237,10 @@ namespace module::support::optimisation {
     // Handle the WAITING_FOR_REQUEST state
     void NSGA2Evaluator::waiting_for_request() {
         log<NUClear::DEBUG>("Waiting For Request");
-        emit(std::make_unique<NSGA2EvaluatorReady>());  // Let the optimiser know we're ready
+        // Let the optimiser know we're ready
+        auto ready       = std::make_unique<NSGA2EvaluatorReady>();
+        ready->evaluator = name;
+        emit_to_optimiser(std::move(ready));
     }
 
     // Handle the SETTING_UP_TRIAL state
@@ -273,7 +314,7 @@ namespace module::support::optimisation {
         emit<Task>(std::make_unique<Walk>(Eigen::Vector3d::Zero()), 1);
         bool early_termination = true;
         auto fitness_scores    = task->calculate_fitness_scores(early_termination, generation, individual);
-        emit(fitness_scores);
+        emit_to_optimiser(std::move(fitness_scores));
 
         emit(std::make_unique<Event>(
             Event(Event::Value::FITNESS_SCORES_SENT)));  // Go back to waiting for the next request
@@ -287,7 +328,7 @@ namespace module::support::optimisation {
         emit<Task>(std::make_unique<Walk>(Eigen::Vector3d::Zero()), 1);
         bool early_termination = false;
         auto fitness_scores    = task->calculate_fitness_scores(early_termination, generation, individual);
-        emit(fitness_scores);
+        emit_to_optimiser(std::move(fitness_scores));
 
         emit(std::make_unique<Event>(
             Event(Event::Value::FITNESS_SCORES_SENT)));  // Go back to waiting for the next request
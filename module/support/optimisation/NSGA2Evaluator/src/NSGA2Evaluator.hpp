@@ -31,6 +31,7 @@
 #include <Eigen/Geometry>
 #include <iostream>
 #include <nuclear>
+#include <string>
 
 #include "tasks/EvaluatorTask.hpp"
 
@@ -149,6 +150,28 @@ namespace module::support::optimisation {
         /// @brief Keeps track of the last messages we received
         NSGA2EvaluationRequest last_eval_request_msg;
 
+        struct Config {
+            /// @brief If we talk to the optimiser over NUClearNet rather than in our own binary
+            bool network = false;
+        } cfg;
+
+        /// @brief The name of this evaluator, unique for each process so that several can run on one machine
+        std::string name;
+
+        /// @brief Sends a message to the optimiser, either locally or over the network depending on configuration
+        template <typename T>
+        void emit_to_optimiser(std::unique_ptr<T> msg) {
+            if (cfg.network) {
+                emit<Scope::NETWORK>(msg, "", true);
+            }
+            else {
+                emit(msg);
+            }
+        }
+
+        /// @brief Handles a request from the optimiser if it is addressed to us
+        void handle_request(const NSGA2EvaluationRequest& request);
+
         /// @brief Send the evaluated fitness scores
         /// @param scores The evaluated fitness scores for the current individual (sway, distance travelled)
         /// @param constraints A list of constraints for domination calculation. These can be used to encode one
@@ -0,0 +1,127 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "EvaluationScheduler.hpp"
+
+#include <algorithm>
+#include <optional>
+
+namespace module::support::optimisation {
+
+    void EvaluationScheduler::configure(const clock::duration& timeout_, const int& max_retries_) {
+        timeout     = timeout_;
+        max_retries = max_retries_;
+    }
+
+    void EvaluationScheduler::evaluator_ready(const std::string& evaluator) {
+        if (std::find(idle.begin(), idle.end(), evaluator) == idle.end()) {
+            idle.push_back(evaluator);
+        }
+    }
+
+    std::vector<EvaluationScheduler::Assignment> EvaluationScheduler::dispatch(nsga2::Population& population,
+                                                                               const clock::time_point& now) {
+        std::vector<Assignment> assignments;
+
+        while (!idle.empty()) {
+            std::optional<nsga2::Individual> next = std::nullopt;
+
+            // Prefer individuals that need to be retried, as they are holding up the generation
+            while (!next.has_value() && !retries.empty()) {
+                auto key = retries.front();
+                retries.pop_front();
+
+                // Only retry individuals from the population we are currently evaluating
+                if (population.initialised && key.second >= 0 && key.second < population.get_size()
+                    && population.inds[key.second].generation == key.first
+                    && !population.inds[key.second].evaluated) {
+                    next = population.inds[key.second];
+                }
+            }
+
+            if (!next.has_value()) {
+                next = population.get_next_individual();
+            }
+
+            // Nothing left to hand out
+            if (!next.has_value()) {
+                break;
+            }
+
+            Key key(next->generation, next->id);
+            in_flight[key] = InFlight{idle.front(), now + timeout};
+            ++attempts[key];
+
+            assignments.push_back(Assignment{idle.front(), next.value()});
+            idle.pop_front();
+        }
+
+        return assignments;
+    }
+
+    bool EvaluationScheduler::complete(const int& generation, const int& id) {
+        Key key(generation, id);
+
+        bool waiting  = in_flight.erase(key) > 0;
+        auto retry_it = std::find(retries.begin(), retries.end(), key);
+        if (retry_it != retries.end()) {
+            retries.erase(retry_it);
+            waiting = true;
+        }
+
+        // Forget about any previous generations now they can't be retried
+        attempts.erase(attempts.begin(), attempts.lower_bound(Key(generation, 0)));
+        attempts.erase(key);
+
+        return waiting;
+    }
+
+    std::vector<EvaluationScheduler::Expired> EvaluationScheduler::expire(const clock::time_point& now) {
+        std::vector<Expired> expired;
+
+        for (auto it = in_flight.begin(); it != in_flight.end();) {
+            if (it->second.deadline <= now) {
+                const auto& key = it->first;
+                bool retrying   = attempts[key] <= max_retries;
+                if (retrying) {
+                    retries.push_back(key);
+                }
+                else {
+                    attempts.erase(key);
+                }
+                expired.push_back(Expired{it->second.evaluator, key.first, key.second, retrying});
+                it = in_flight.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        return expired;
+    }
+
+}  // namespace module::support::optimisation
@@ -0,0 +1,157 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MODULE_SUPPORT_OPTIMISATION_EVALUATIONSCHEDULER_HPP
+#define MODULE_SUPPORT_OPTIMISATION_EVALUATIONSCHEDULER_HPP
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "nsga2/Population.hpp"
+
+namespace module::support::optimisation {
+
+    /**
+     * Hands out the individuals of a population to any number of evaluator instances.
+     *
+     * Each individual that has been sent to an evaluator is tracked until a result for it arrives. If no result arrives
+     * before the timeout the individual is sent to the next free evaluator, up to a maximum number of retries. Results
+     * can arrive in any order and from any evaluator, and the first result for an individual is the one that is used.
+     */
+    class EvaluationScheduler {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        /// An individual that has been handed to an evaluator
+        struct Assignment {
+            /// The name of the evaluator that should evaluate this individual
+            std::string evaluator;
+            /// The individual to evaluate
+            nsga2::Individual individual;
+        };
+
+        /// An individual whose evaluation timed out
+        struct Expired {
+            /// The evaluator that failed to evaluate the individual in time
+            std::string evaluator;
+            /// The generation of the individual
+            int generation;
+            /// The id of the individual
+            int id;
+            /// If the individual will be sent to another evaluator, or we have given up on it
+            bool retrying;
+        };
+
+        /**
+         * Sets how long to wait for an evaluation and how many times to retry it
+         *
+         * @param timeout_     how long an evaluator has to return a result before it is sent elsewhere
+         * @param max_retries_ how many times an individual will be resent before we give up on it
+         */
+        void configure(const clock::duration& timeout_, const int& max_retries_);
+
+        /**
+         * Records that an evaluator is free and can be given an individual
+         *
+         * @param evaluator the name of the evaluator
+         */
+        void evaluator_ready(const std::string& evaluator);
+
+        /**
+         * Gives each free evaluator an individual, preferring individuals that need to be retried
+         *
+         * @param population the population to take individuals from
+         * @param now        the current time, used to set the deadlines of the assignments
+         *
+         * @return the individuals to send and which evaluator to send each of them to
+         */
+        std::vector<Assignment> dispatch(nsga2::Population& population, const clock::time_point& now);
+
+        /**
+         * Records that a result has arrived for an individual
+         *
+         * @param generation the generation of the individual
+         * @param id         the id of the individual
+         *
+         * @return true if we were waiting on this result, false if it is a duplicate or stale result
+         */
+        bool complete(const int& generation, const int& id);
+
+        /**
+         * Finds the individuals whose evaluators have run out of time. These are queued to be retried unless they have
+         * run out of retries.
+         *
+         * @param now the current time
+         *
+         * @return the individuals that have timed out
+         */
+        std::vector<Expired> expire(const clock::time_point& now);
+
+        /// The number of individuals that are currently being evaluated
+        [[nodiscard]] int in_flight_count() const {
+            return int(in_flight.size());
+        }
+
+        /// The number of evaluators that are waiting for an individual
+        [[nodiscard]] int idle_count() const {
+            return int(idle.size());
+        }
+
+    private:
+        /// The key of an individual, its generation and its id
+        using Key = std::pair<int, int>;
+
+        /// An individual that is currently being evaluated
+        struct InFlight {
+            /// The evaluator that is evaluating it
+            std::string evaluator;
+            /// When we give up waiting for this evaluator
+            clock::time_point deadline;
+        };
+
+        /// How long to wait before we give up on an evaluator
+        clock::duration timeout = std::chrono::minutes(2);
+        /// How many times to resend an individual before we give up on it
+        int max_retries = 2;
+
+        /// The evaluators that are free, in the order they became free
+        std::deque<std::string> idle;
+        /// The individuals currently being evaluated
+        std::map<Key, InFlight> in_flight;
+        /// Individuals that timed out and need to be sent again
+        std::deque<Key> retries;
+        /// How many times each individual has been sent to an evaluator
+        std::map<Key, int> attempts;
+    };
+
+}  // namespace module::support::optimisation
+
+#endif  // MODULE_SUPPORT_OPTIMISATION_EVALUATIONSCHEDULER_HPP
@@ -44,6 +44,7 @@ namespace module::support::optimisation {
     using extension::Configuration;
 
     using message::support::optimisation::NSGA2EvaluationRequest;
+    using message::support::optimisation::NSGA2EvaluatorReadinessQuery;
     using message::support::optimisation::NSGA2EvaluatorReady;
     using message::support::optimisation::NSGA2FitnessScores;
     using message::support::optimisation::NSGA2Terminate;
@@ -72,6 +73,13 @@ namespace module::support::optimisation {
             nsga2_algorithm.set_eta_m(config["eta"]["M"].as<double>());
             nsga2_algorithm.set_seed(config["seed"].as<int>());
 
+            cfg.num_objectives  = config["num_objectives"].as<int>();
+            cfg.num_constraints = config["num_constraints"].as<int>();
+            cfg.network         = config["evaluation"]["network"].as<bool>();
+            scheduler.configure(std::chrono::duration_cast<EvaluationScheduler::clock::duration>(
+                                    std::chrono::duration<double>(config["evaluation"]["timeout"].as<double>())),
+                                config["evaluation"]["max_retries"].as<int>());
+
             auto task_type = config["task"].as<std::string>();
 
             if (task_type == "walk") {
@@ -97,71 +105,100 @@ namespace module::support::optimisation {
             task->setup_nsga2(config, nsga2_algorithm);
         });
 
-        on<Startup>().then([this]() {
+        on<Startup, Sync<NSGA2Optimiser>>().then([this]() {
             // Create a message to request an evaluation of an individual
             log<NUClear::INFO>("Starting up in 4 seconds");
             std::this_thread::sleep_for(std::chrono::seconds(4));
 
             log<NUClear::INFO>("Optimiser ready, starting first evaluation");
 
-            // If initialisation succeeded, evaluate the first individual of the first generation
-            // Subsequent individuals will be evaluated after we get the evaluation scores for this
-            // individual (from the NSGA2FitnessScores trigger)
+            // If initialisation succeeded, find evaluators for the first generation
+            // Subsequent individuals will be evaluated as evaluators tell us they are ready for more
             if (nsga2_algorithm.initialize_first_generation()) {
-                emit(std::make_unique<NSGA2EvaluatorReady>());
+                running = true;
+                if (cfg.network) {
+                    query_evaluators();
+                }
+                else {
+                    // The evaluator in our binary is waiting for a request already
+                    auto ready       = std::make_unique<NSGA2EvaluatorReady>();
+                    ready->evaluator = LOCAL_EVALUATOR;
+                    emit(ready);
+                }
             }
             else {
                 log<NUClear::ERROR>("Failed to initialise NSGA2");
             }
         });
 
-        on<Trigger<NSGA2EvaluatorReady>, Single>().then([this]() {
-            auto next_ind = nsga2_algorithm.get_current_pop()->get_next_individual();
-            if (next_ind.has_value()) {
-                auto ind = next_ind.value();
-                log<NUClear::INFO>("\n\nSending request to evaluator. Generation:",
-                                   ind.generation,
-                                   "individual",
-                                   ind.id);
-                // Create a message to request an evaluation of an individual
-                emit(task->make_evaluation_request(ind.id, ind.generation, ind.reals));
-            }
-            else {
-                log<NUClear::INFO>("Evaluator ready, but optimiser is not");
-                emit<Scope::DELAY>(std::make_unique<NSGA2EvaluatorReady>(),
-                                   std::chrono::seconds(1));  // Wait for a bit for us to become ready, then
-                                                              // ask the evaluator if it is ready
+        on<Trigger<NSGA2EvaluatorReady>, Sync<NSGA2Optimiser>>().then([this](const NSGA2EvaluatorReady& ready) {
+            if (!cfg.network) {
+                scheduler.evaluator_ready(ready.evaluator.empty() ? LOCAL_EVALUATOR : ready.evaluator);
+                dispatch_evaluations();
             }
         });
 
-        on<Trigger<NSGA2FitnessScores>, Single>().then([this](const NSGA2FitnessScores& scores) {
-            log<NUClear::DEBUG>("Got evaluation fitness scores", scores.obj_score[0], scores.obj_score[1]);
-
-            // Tell the algorithm the evaluation scores for this individual
-            nsga2_algorithm.get_current_pop()->set_evaluation_results(scores.id, scores.obj_score, scores.constraints);
+        on<Network<NSGA2EvaluatorReady>, Sync<NSGA2Optimiser>>().then(
+            [this](const NUClear::dsl::word::NetworkSource& source, const NSGA2EvaluatorReady& ready) {
+                if (cfg.network) {
+                    log<NUClear::DEBUG>("Evaluator", ready.evaluator, "on", source.name, "is ready");
+                    scheduler.evaluator_ready(ready.evaluator);
+                    dispatch_evaluations();
+                }
+            });
 
-            if (nsga2_algorithm.get_current_pop()->are_all_evaluated()) {
-                // End the generation and save its data
-                nsga2_algorithm.complete_generation_and_advance();
+        // Evaluators that start after us, or that missed our first query, won't know we exist until we ask again
+        on<Trigger<NUClear::message::NetworkJoin>, Sync<NSGA2Optimiser>>().then(
+            [this](const NUClear::message::NetworkJoin& join) {
+                if (cfg.network && running) {
+                    log<NUClear::DEBUG>("Asking", join.name, "if it has an evaluator that is ready");
+                    query_evaluators();
+                }
+            });
 
-                if (nsga2_algorithm.has_met_optimisation_terminal_condition()) {
-                    log<NUClear::INFO>("NSGA2 evaluation finished!");
+        on<Trigger<NSGA2FitnessScores>, Sync<NSGA2Optimiser>>().then([this](const NSGA2FitnessScores& scores) {
+            if (!cfg.network) {
+                record_scores(scores.generation, scores.id, scores.obj_score, scores.constraints);
+            }
+        });
 
-                    // Tell Webots to terminate
-                    std::unique_ptr<OptimisationCommand> msg = std::make_unique<OptimisationCommand>();
-                    msg->command                             = OptimisationCommand::CommandType::TERMINATE;
-                    emit(msg);
+        on<Network<NSGA2FitnessScores>, Sync<NSGA2Optimiser>>().then(
+            [this](const NUClear::dsl::word::NetworkSource& /*source*/, const NSGA2FitnessScores& scores) {
+                if (cfg.network) {
+                    record_scores(scores.generation, scores.id, scores.obj_score, scores.constraints);
+                }
+            });
 
-                    // Tell the NSGA2 components to finish up, but add a delay to give webots time to get
-                    // the terminate
-                    emit<Scope::DELAY>(std::make_unique<NSGA2Terminate>(), std::chrono::milliseconds(100));
+        // Look for evaluators that have taken too long and send their individuals somewhere else
+        on<Every<1, std::chrono::seconds>, Sync<NSGA2Optimiser>>().then([this] {
+            for (const auto& expired : scheduler.expire(EvaluationScheduler::clock::now())) {
+                if (expired.retrying) {
+                    log<NUClear::WARN>("Evaluator",
+                                       expired.evaluator,
+                                       "timed out evaluating generation",
+                                       expired.generation,
+                                       "individual",
+                                       expired.id,
+                                       "retrying");
                 }
                 else {
-                    log<NUClear::INFO>("Advanced to new generation", nsga2_algorithm.get_current_pop()->generation);
+                    log<NUClear::ERROR>("Giving up on generation",
+                                        expired.generation,
+                                        "individual",
+                                        expired.id,
+                                        "after it timed out too many times");
+                    record_scores(expired.generation,
+                                  expired.id,
+                                  std::vector<double>(cfg.num_objectives, FAILED_SCORE),
+                                  std::vector<double>(cfg.num_constraints, -FAILED_SCORE));
                 }
             }
-            else {
-                log<NUClear::DEBUG>("Recorded Evaluation for individual", scores.id, "more to come...");
+            dispatch_evaluations();
+
+            // With nobody idle and nothing being evaluated the optimisation can't progress until an evaluator speaks
+            // up, which they only do when asked unless they have just sent us scores
+            if (cfg.network && running && scheduler.idle_count() == 0 && scheduler.in_flight_count() == 0) {
+                query_evaluators();
             }
         });
 
@@ -172,4 +209,90 @@ namespace module::support::optimisation {
             powerplant.shutdown();
         });
     }
+
+    void NSGA2Optimiser::dispatch_evaluations() {
+        if (task == nullptr) {
+            return;
+        }
+
+        auto assignments = scheduler.dispatch(*nsga2_algorithm.get_current_pop(), EvaluationScheduler::clock::now());
+        for (auto& assignment : assignments) {
+            const auto& ind = assignment.individual;
+            log<NUClear::INFO>("Sending request to evaluator",
+                               assignment.evaluator,
+                               "Generation:",
+                               ind.generation,
+                               "individual",
+                               ind.id);
+
+            // Create a message to request an evaluation of an individual
+            auto request       = task->make_evaluation_request(ind.id, ind.generation, ind.reals);
+            request->evaluator = assignment.evaluator;
+            if (cfg.network) {
+                // Evaluators ignore requests that are addressed to another evaluator
+                emit<Scope::NETWORK>(request, "", true);
+            }
+            else {
+                emit(request);
+            }
+        }
+    }
+
+    void NSGA2Optimiser::query_evaluators() {
+        // Evaluators that are busy ignore this and tell us they are ready once they have sent their scores
+        emit<Scope::NETWORK>(std::make_unique<NSGA2EvaluatorReadinessQuery>(), "", true);
+    }
+
+    void NSGA2Optimiser::record_scores(const int& generation,
+                                       const int& id,
+                                       const std::vector<double>& obj_score,
+                                       const std::vector<double>& constraints) {
+        auto pop = nsga2_algorithm.get_current_pop();
+
+        // Results can arrive late or twice if an individual was retried, only use the first one for this generation
+        if (!scheduler.complete(generation, id) || generation != pop->generation) {
+            log<NUClear::DEBUG>("Ignoring stale evaluation for generation", generation, "individual", id);
+            return;
+        }
+
+        log<NUClear::DEBUG>("Got evaluation fitness scores", obj_score[0], obj_score[1]);
+
+        // Tell the algorithm the evaluation scores for this individual
+        pop->set_evaluation_results(id, obj_score, constraints);
+
+        if (pop->are_all_evaluated()) {
+            // End the generation and save its data
+            nsga2_algorithm.complete_generation_and_advance();
+
+            if (nsga2_algorithm.has_met_optimisation_terminal_condition()) {
+                log<NUClear::INFO>("NSGA2 evaluation finished!");
+                running = false;
+
+                // Tell Webots to terminate
+                std::unique_ptr<OptimisationCommand> msg = std::make_unique<OptimisationCommand>();
+                msg->command                             = OptimisationCommand::CommandType::TERMINATE;
+                emit(msg);
+
+                // Tell the NSGA2 components to finish up, but add a delay to give webots time to get
+                // the terminate
+                if (cfg.network) {
+                    emit<Scope::NETWORK>(std::make_unique<NSGA2Terminate>(), "", true);
+                }
+                emit<Scope::DELAY>(std::make_unique<NSGA2Terminate>(), std::chrono::milliseconds(100));
+            }
+            else {
+                log<NUClear::INFO>("Advanced to new generation", nsga2_algorithm.get_current_pop()->generation);
+
+                // Any evaluators that were waiting can start on the new generation
+                dispatch_evaluations();
+            }
+        }
+        else {
+            log<NUClear::DEBUG>("Recorded Evaluation for individual",
+                                id,
+                                "more to come...",
+                                scheduler.in_flight_count(),
+                                "in flight");
+        }
+    }
 }  // namespace module::support::optimisation
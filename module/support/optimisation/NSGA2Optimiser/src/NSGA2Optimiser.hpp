@@ -28,8 +28,10 @@
 #define MODULE_SUPPORT_OPTIMISATION_NSGA2OPTIMISER_HPP
 
 #include <nuclear>
+#include <string>
 #include <vector>
 
+#include "EvaluationScheduler.hpp"
 #include "nsga2/NSGA2.hpp"
 #include "tasks/OptimiserTask.hpp"
 
@@ -49,6 +51,41 @@ namespace module::support::optimisation {
         /// @brief A pointer to the specific type of task that is being optimised.
         std::unique_ptr<OptimiserTask> task = nullptr;
 
+        /// @brief Hands out individuals to evaluators and tracks which ones are still being evaluated
+        EvaluationScheduler scheduler{};
+
+        struct Config {
+            /// @brief If evaluators are separate processes talking to us over NUClearNet rather than in our binary
+            bool network = false;
+            /// @brief The number of objectives each individual is scored on
+            int num_objectives = 0;
+            /// @brief The number of constraints each individual is scored on
+            int num_constraints = 0;
+        } cfg;
+
+        /// @brief If the first generation has been created and we are still waiting on evaluations for it or a later
+        /// generation
+        bool running = false;
+
+        /// @brief The name we use for the evaluator in our own binary when not using the network
+        static inline const std::string LOCAL_EVALUATOR = "local";
+
+        /// @brief The score given to an individual that could not be evaluated after all of its retries. It is large
+        /// but finite so that it is dominated by everything else without breaking the crowding distance calculation
+        static constexpr double FAILED_SCORE = 1e6;
+
+        /// @brief Sends individuals to any evaluators that are waiting for one
+        void dispatch_evaluations();
+
+        /// @brief Asks every evaluator on the network that is not busy to tell us it is ready
+        void query_evaluators();
+
+        /// @brief Stores the scores for an individual and advances the generation once everything is evaluated
+        void record_scores(const int& generation,
+                           const int& id,
+                           const std::vector<double>& obj_score,
+                           const std::vector<double>& constraints);
+
     public:
         /// @brief Called by the powerplant to build and setup the NSGA2Optimiser reactor.
         explicit NSGA2Optimiser(std::unique_ptr<NUClear::Environment> environment);
@@ -29,6 +29,7 @@
 #include "Population.hpp"
 
 #include <nuclear>
+#include <numeric>
 
 namespace nsga2 {
     Population::Population(const int& size_,
@@ -118,64 +119,60 @@ namespace nsga2 {
         inds[_id].check_constraints();
     }
 
-    // Fast Non-Dominated Sort. This calculates the fronts in the population.
+    // Efficient Non-dominated Sort with sequential search (ENS-SS, Zhang et al. 2015). This calculates the fronts in
+    // the population. It produces the same fronts as the original pairwise sort, but only compares an individual
+    // against the fronts it could belong to, rather than against the entire population.
     void Population::fast_nds() {
-        // Reset Front
-        fronts.resize(1);
-        fronts[0].clear();
+        fronts.clear();
+
+        // Order the individuals so that any individual that dominates another is always before it.
+        // Under constrained domination this is least violation first, then lexicographic objective order.
+        std::vector<int> order(inds.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](const int& a, const int& b) {
+            const auto& ind_a = inds[a];
+            const auto& ind_b = inds[b];
+            if (ind_a.constr_violation != ind_b.constr_violation) {
+                return ind_a.constr_violation > ind_b.constr_violation;
+            }
+            return std::lexicographical_compare(ind_a.obj_score.begin(),
+                                                ind_a.obj_score.end(),
+                                                ind_b.obj_score.begin(),
+                                                ind_b.obj_score.end());
+        });
 
-        // Compare each individual `p` to each other individual `q` (also compares p to itself, but doesn't matter)
-        for (std::size_t p = 0; p < inds.size(); p++) {
+        for (const auto& p : order) {
             auto& ind_p = inds[p];
-            ind_p.domination_list.clear();   // Reset the set of individuals that P dominates
-            ind_p.dominated_by_counter = 0;  // Reset the count of individuals that dominate P
-
-            for (std::size_t q = 0; q < inds.size(); q++) {
-                const auto& ind_q = inds[q];
-
-                int comparison = ind_p.check_dominance(ind_q);
-                if (comparison == 1) {
-                    // If P dominates Q, Add Q to the solutions that P dominates
-                    ind_p.domination_list.push_back(q);
-                }
-                else if (comparison == -1) {
-                    // If Q dominates P, Increment the number of individuals that dominate P
-                    ind_p.dominated_by_counter++;
+            ind_p.domination_list.clear();   // Not needed for this sort, but don't leave stale lists behind
+            ind_p.dominated_by_counter = 0;  // Everything that dominates P has already been placed
+
+            // Find the first front where nothing dominates P. Domination is transitive so P belongs in that front
+            std::size_t k = 0;
+            for (; k < fronts.size(); k++) {
+                // Search from the most recently added member, as it is the closest to P in the sorted order
+                const auto& front = fronts[k];
+                bool dominated    = std::any_of(front.rbegin(), front.rend(), [&](const int& q) {
+                    return inds[q].check_dominance(ind_p) == 1;
+                });
+                if (!dominated) {
+                    break;
                 }
             }
 
-            if (ind_p.dominated_by_counter == 0) {
-                // If no other individuals dominate P, then P must be in the first Front (i.e. Rank 1)
-                ind_p.rank = 1;
-                fronts[0].push_back(p);
+            if (k == fronts.size()) {
+                fronts.emplace_back();
             }
+            fronts[k].push_back(p);
+            ind_p.rank = int(k) + 1;
         }
 
-        // Sort the first front (sorting by index, since front is `std::vector<std::vector<int>>`)
-        std::sort(fronts[0].begin(), fronts[0].end());
-
-        std::size_t front_index = 1;
-        while (fronts[front_index - 1].size() > 0) {  // While we haven't encountered an empty front
-            std::vector<int>& front_i = fronts[front_index - 1];
-            std::vector<int> next_front;  // Known as Q in the original paper, this holds members of the next front
-            for (std::size_t p = 0; p < front_i.size(); p++) {
-                Individual& ind_p = inds[front_i[p]];
-
-                // For each of the individuals in the domination list, check if it's part of the next front
-                for (std::size_t q = 0; q < ind_p.domination_list.size(); q++) {
-                    auto& ind_q = inds[ind_p.domination_list[q]];
-                    ind_q.dominated_by_counter--;  // Reduce the counter, as we are no longer considering P vs this Q
-
-                    if (ind_q.dominated_by_counter == 0) {
-                        // If no other individuals outside of current front dominate Q, then Q must be in the next Front
-                        ind_q.rank = front_index + 1;
-                        next_front.push_back(ind_p.domination_list[q]);
-                    }
-                }
-            }
-            fronts.push_back(next_front);
-            front_index++;
+        // Keep the fronts in index order, so results don't depend on the order we visited individuals in
+        for (auto& front : fronts) {
+            std::sort(front.begin(), front.end());
         }
+
+        // The list of fronts always ends with an empty front
+        fronts.emplace_back();
     }
 
     void Population::crowding_distance_all() {
@@ -32,6 +32,7 @@
 #include <algorithm>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "Individual.hpp"
 #include "Random.hpp"
@@ -79,6 +80,7 @@ namespace nsga2 {
                                     const std::vector<double>& obj_score_,
                                     const std::vector<double>& constraints_);
 
+        /// Sorts the population into non-dominated fronts, setting `fronts` and the rank of each individual
         void fast_nds();
         void crowding_distance_all();
         void crowding_distance(const int& front_index_);
@@ -0,0 +1,199 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EvaluationScheduler.hpp"
+#include "nsga2/Population.hpp"
+#include "nsga2/Random.hpp"
+
+using module::support::optimisation::EvaluationScheduler;
+
+namespace {
+
+    /// Makes a population that is ready to be handed out, the scheduler only needs the ids and generations
+    nsga2::Population make_population(const int& size, const int& generation) {
+        nsga2::Population pop(size,
+                              0,
+                              0,
+                              0,
+                              {},
+                              {},
+                              {},
+                              2,
+                              0.0,
+                              0.0,
+                              20.0,
+                              0.0,
+                              std::make_shared<nsga2::RandomGenerator<>>(0),
+                              {});
+        pop.set_ids();
+        pop.set_individuals_generation(generation);
+        pop.generation  = generation;
+        pop.initialised = true;
+        return pop;
+    }
+
+    /// The ids of the individuals in a set of assignments, in the order they were handed out
+    std::vector<int> ids(const std::vector<EvaluationScheduler::Assignment>& assignments) {
+        std::vector<int> output;
+        for (const auto& assignment : assignments) {
+            output.push_back(assignment.individual.id);
+        }
+        return output;
+    }
+
+}  // namespace
+
+TEST_CASE("Each ready evaluator is given one individual", "[nsga2][EvaluationScheduler]") {
+    auto pop       = make_population(5, 0);
+    const auto now = EvaluationScheduler::clock::now();
+
+    EvaluationScheduler scheduler;
+    scheduler.evaluator_ready("a");
+    scheduler.evaluator_ready("b");
+    scheduler.evaluator_ready("a");
+    REQUIRE(scheduler.idle_count() == 2);
+
+    auto assignments = scheduler.dispatch(pop, now);
+    REQUIRE(assignments.size() == 2);
+    REQUIRE(assignments[0].evaluator == "a");
+    REQUIRE(assignments[1].evaluator == "b");
+    REQUIRE(ids(assignments) == std::vector<int>{0, 1});
+    REQUIRE(scheduler.idle_count() == 0);
+    REQUIRE(scheduler.in_flight_count() == 2);
+
+    // Nobody is free so nothing more is handed out
+    REQUIRE(scheduler.dispatch(pop, now).empty());
+
+    // Once the population runs out evaluators stay idle
+    for (const auto& name : {"c", "d", "e", "f"}) {
+        scheduler.evaluator_ready(name);
+    }
+    REQUIRE(ids(scheduler.dispatch(pop, now)) == std::vector<int>{2, 3, 4});
+    REQUIRE(scheduler.idle_count() == 1);
+    REQUIRE(scheduler.in_flight_count() == 5);
+}
+
+TEST_CASE("Only the first result for an individual is used", "[nsga2][EvaluationScheduler]") {
+    auto pop       = make_population(2, 3);
+    const auto now = EvaluationScheduler::clock::now();
+
+    EvaluationScheduler scheduler;
+    scheduler.evaluator_ready("a");
+    scheduler.dispatch(pop, now);
+
+    REQUIRE(scheduler.complete(3, 0));
+    REQUIRE_FALSE(scheduler.complete(3, 0));
+    REQUIRE(scheduler.in_flight_count() == 0);
+
+    // Results for individuals we never sent, or from another generation, are ignored
+    REQUIRE_FALSE(scheduler.complete(3, 1));
+    REQUIRE_FALSE(scheduler.complete(2, 0));
+}
+
+TEST_CASE("Individuals that time out are sent to the next free evaluator first", "[nsga2][EvaluationScheduler]") {
+    auto pop       = make_population(4, 0);
+    const auto now = EvaluationScheduler::clock::now();
+
+    EvaluationScheduler scheduler;
+    scheduler.configure(std::chrono::seconds(10), 2);
+    scheduler.evaluator_ready("a");
+    scheduler.evaluator_ready("b");
+    REQUIRE(ids(scheduler.dispatch(pop, now)) == std::vector<int>{0, 1});
+
+    // Nothing has run out of time yet
+    REQUIRE(scheduler.expire(now + std::chrono::seconds(9)).empty());
+
+    // b finishes in time and a doesn't
+    REQUIRE(scheduler.complete(0, 1));
+    auto expired = scheduler.expire(now + std::chrono::seconds(10));
+    REQUIRE(expired.size() == 1);
+    REQUIRE(expired[0].evaluator == "a");
+    REQUIRE(expired[0].generation == 0);
+    REQUIRE(expired[0].id == 0);
+    REQUIRE(expired[0].retrying);
+    REQUIRE(scheduler.in_flight_count() == 0);
+
+    // The retry goes out before the individuals that haven't been sent yet
+    scheduler.evaluator_ready("b");
+    scheduler.evaluator_ready("c");
+    auto assignments = scheduler.dispatch(pop, now + std::chrono::seconds(10));
+    REQUIRE(ids(assignments) == std::vector<int>{0, 2});
+    REQUIRE(assignments[0].evaluator == "b");
+
+    // a was only slow, its result still counts and the one from b is then a duplicate
+    REQUIRE(scheduler.complete(0, 0));
+    REQUIRE_FALSE(scheduler.complete(0, 0));
+}
+
+TEST_CASE("Individuals are given up on after too many retries", "[nsga2][EvaluationScheduler]") {
+    auto pop = make_population(1, 0);
+    auto now = EvaluationScheduler::clock::now();
+
+    EvaluationScheduler scheduler;
+    scheduler.configure(std::chrono::seconds(1), 2);
+
+    // Sent once and retried twice
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        scheduler.evaluator_ready("a");
+        REQUIRE(ids(scheduler.dispatch(pop, now)) == std::vector<int>{0});
+
+        now += std::chrono::seconds(1);
+        auto expired = scheduler.expire(now);
+        REQUIRE(expired.size() == 1);
+        REQUIRE(expired[0].retrying == (attempt < 2));
+    }
+
+    // Nothing is left to hand out and a late result is not waited on
+    scheduler.evaluator_ready("a");
+    REQUIRE(scheduler.dispatch(pop, now).empty());
+    REQUIRE_FALSE(scheduler.complete(0, 0));
+}
+
+TEST_CASE("Retries from an earlier generation are dropped", "[nsga2][EvaluationScheduler]") {
+    auto pop       = make_population(2, 0);
+    const auto now = EvaluationScheduler::clock::now();
+
+    EvaluationScheduler scheduler;
+    scheduler.configure(std::chrono::seconds(1), 2);
+    scheduler.evaluator_ready("a");
+    scheduler.dispatch(pop, now);
+    REQUIRE(scheduler.expire(now + std::chrono::seconds(1)).size() == 1);
+
+    // The generation moved on before the retry could be sent
+    auto next = make_population(2, 1);
+    scheduler.evaluator_ready("a");
+    auto assignments = scheduler.dispatch(next, now + std::chrono::seconds(1));
+    REQUIRE(assignments.size() == 1);
+    REQUIRE(assignments[0].individual.generation == 1);
+    REQUIRE(assignments[0].individual.id == 0);
+}
@@ -0,0 +1,165 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <limits>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "nsga2/Population.hpp"
+#include "nsga2/Random.hpp"
+
+namespace {
+
+    /// Makes a population with random scores, where some individuals violate their constraints
+    nsga2::Population make_population(const int& size, const int& objectives, const unsigned int& seed) {
+        const int constraints = 2;
+        nsga2::Population pop(size,
+                              0,
+                              0,
+                              constraints,
+                              {},
+                              {},
+                              {},
+                              objectives,
+                              0.0,
+                              0.0,
+                              20.0,
+                              std::numeric_limits<double>::epsilon(),
+                              std::make_shared<nsga2::RandomGenerator<>>(seed),
+                              {});
+        pop.set_ids();
+
+        std::mt19937 rng(seed);
+        // Use a coarse grid of scores so there are plenty of ties and duplicate individuals
+        std::uniform_int_distribution<int> score(0, 20);
+        std::bernoulli_distribution violates(0.2);
+
+        for (auto& ind : pop.inds) {
+            for (auto& s : ind.obj_score) {
+                s = score(rng);
+            }
+            for (auto& c : ind.constr) {
+                c = violates(rng) ? -score(rng) : 0.0;
+            }
+            ind.check_constraints();
+        }
+        return pop;
+    }
+
+    /// The pairwise O(MN^2) sort the optimiser used before, which the efficient sort must match exactly
+    std::pair<std::vector<std::vector<int>>, std::vector<int>> pairwise_nds(const nsga2::Population& pop) {
+        const std::size_t n = pop.inds.size();
+        std::vector<std::vector<int>> domination_lists(n);
+        std::vector<int> dominated_by(n, 0);
+        std::vector<int> ranks(n, 0);
+        std::vector<std::vector<int>> fronts(1);
+
+        // Compare each individual `p` to each other individual `q`
+        for (std::size_t p = 0; p < n; p++) {
+            for (std::size_t q = 0; q < n; q++) {
+                const int comparison = pop.inds[p].check_dominance(pop.inds[q]);
+                if (comparison == 1) {
+                    domination_lists[p].push_back(int(q));
+                }
+                else if (comparison == -1) {
+                    dominated_by[p]++;
+                }
+            }
+
+            // If nothing dominates P it is in the first front
+            if (dominated_by[p] == 0) {
+                ranks[p] = 1;
+                fronts[0].push_back(int(p));
+            }
+        }
+
+        // Peel off each front, whatever is only dominated by the members of this front is in the next one
+        for (std::size_t i = 0; !fronts[i].empty(); i++) {
+            std::vector<int> next_front;
+            for (const auto& p : fronts[i]) {
+                for (const auto& q : domination_lists[p]) {
+                    if (--dominated_by[q] == 0) {
+                        ranks[q] = int(i) + 2;
+                        next_front.push_back(q);
+                    }
+                }
+            }
+            fronts.push_back(next_front);
+        }
+
+        return {fronts, ranks};
+    }
+
+    /// Gets the fronts with each front in index order so the two sorts can be compared
+    std::vector<std::vector<int>> sorted_fronts(std::vector<std::vector<int>> fronts) {
+        for (auto& front : fronts) {
+            std::sort(front.begin(), front.end());
+        }
+        return fronts;
+    }
+
+}  // namespace
+
+TEST_CASE("Efficient non-dominated sort gives the same fronts as the pairwise sort", "[nsga2][nds]") {
+    for (const int& objectives : {1, 2, 3, 5}) {
+        for (unsigned int seed = 0; seed < 10; ++seed) {
+            auto pop = make_population(200, objectives, seed);
+
+            const auto [expected_fronts, expected_ranks] = pairwise_nds(pop);
+
+            pop.fast_nds();
+            REQUIRE(sorted_fronts(pop.fronts) == sorted_fronts(expected_fronts));
+            for (std::size_t i = 0; i < pop.inds.size(); ++i) {
+                REQUIRE(pop.inds[i].rank == expected_ranks[i]);
+            }
+        }
+    }
+}
+
+TEST_CASE("Non-dominated sort on large populations", "[nsga2][nds][!benchmark]") {
+    auto pop = make_population(2000, 3, 42);
+
+    BENCHMARK("pairwise 2000 individuals") {
+        return pairwise_nds(pop).first.size();
+    };
+
+    BENCHMARK("efficient 2000 individuals") {
+        pop.fast_nds();
+        return pop.fronts.size();
+    };
+
+    BENCHMARK("efficient 2000 individuals with crowding") {
+        pop.fast_nds();
+        pop.crowding_distance_all();
+        return pop.fronts.size();
+    };
+}
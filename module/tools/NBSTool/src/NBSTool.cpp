@@ -0,0 +1,324 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "NBSTool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fmt/format.h>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <queue>
+#include <typeinfo>
+#include <yaml-cpp/yaml.h>
+
+#include "message/output/CompressedImage.hpp"
+#include "message/reflection.hpp"
+
+#include "utility/nbs/Decoder.hpp"
+#include "utility/nbs/Encoder.hpp"
+#include "utility/nbs/Frame.hpp"
+#include "utility/nbs/Index.hpp"
+#include "utility/support/ProgressBar.hpp"
+
+namespace module::tools {
+
+    using message::output::CompressedImage;
+    using NUClear::message::CommandLineArguments;
+    using NUClear::util::serialise::xxhash64;
+    using utility::nbs::IndexItem;
+    using utility::support::ProgressBar;
+
+    namespace {
+
+        template <typename T>
+        struct NameReflector;
+
+        template <>
+        struct NameReflector<void> {  // NOLINT(cppcoreguidelines-special-member-functions)
+            virtual std::string name() = 0;
+            virtual ~NameReflector()   = default;
+        };
+
+        template <typename T>
+        struct NameReflector : public NameReflector<void> {
+            std::string name() override {
+                return NUClear::util::demangle(typeid(T).name());
+            }
+        };
+
+        /// Gets the name of a message type from its hash, or the hash itself if it isn't one of our messages
+        std::string type_name(uint64_t hash) {
+            try {
+                return message::reflection::from_hash<NameReflector>(hash).name();
+            }
+            catch (const utility::reflection::unknown_message&) {
+                return fmt::format("{:016x}", hash);
+            }
+        }
+
+        /// Works out a timestamp from +seconds after first or -seconds before last
+        uint64_t offset_time(const std::string& spec, const uint64_t& first, const uint64_t& last) {
+            const auto offset = uint64_t(std::abs(std::stod(spec)) * 1e9);
+            return spec.front() == '-' ? last - std::min(offset, last) : first + offset;
+        }
+
+        void print_usage() {
+            std::cout << "Usage: nbstool <command> [options] files...\n"
+                      << "\n"
+                      << "Commands:\n"
+                      << "  filter          copy only the message types given by --type\n"
+                      << "  trim            copy only the messages between --start and --end\n"
+                      << "  merge           copy every message from all of the files in timestamp order\n"
+                      << "  compress        copy the files into a block compressed nbs file\n"
+                      << "  decompress      copy the files into a plain nbs file\n"
+                      << "  stats           print the number of packets, bytes and the rate for each type\n"
+                      << "  extract_images  write every CompressedImage to a jpeg and yaml file in --output\n"
+                      << "\n"
+                      << "Options:\n"
+                      << "  -o, --output    the nbs file, or for extract_images the directory, to write to\n"
+                      << "  -t, --type      a message type to keep, e.g. message.input.Sensors, may be repeated\n"
+                      << "  -s, --start     +seconds from the first message or -seconds from the last, default +0\n"
+                      << "  -e, --end       +seconds from the first message or -seconds from the last, default -0\n"
+                      << "  -z, --compress  write the output as a block compressed nbs file\n"
+                      << "\n"
+                      << "filter, trim, merge, compress and decompress all accept every option so they can be\n"
+                      << "combined in one pass. Block compressed and plain nbs files can both be used as inputs\n";
+        }
+
+    }  // namespace
+
+    NBSTool::NBSTool(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+
+        on<Trigger<CommandLineArguments>>().then([this](const CommandLineArguments& args) {
+            if (args.size() < 3) {
+                print_usage();
+                powerplant.shutdown();
+                return;
+            }
+
+            const std::string& command = args[1];
+
+            Options options;
+            for (size_t i = 2; i < args.size(); ++i) {
+                const std::string& arg = args[i];
+                if ((arg == "-o" || arg == "--output") && i + 1 < args.size()) {
+                    options.output = args[++i];
+                }
+                else if ((arg == "-t" || arg == "--type") && i + 1 < args.size()) {
+                    const std::string& name = args[++i];
+                    options.types.insert(xxhash64(name.c_str(), name.size(), 0x4e55436c));
+                }
+                else if ((arg == "-s" || arg == "--start") && i + 1 < args.size()) {
+                    options.start = args[++i];
+                }
+                else if ((arg == "-e" || arg == "--end") && i + 1 < args.size()) {
+                    options.end = args[++i];
+                }
+                else if (arg == "-z" || arg == "--compress") {
+                    options.frame_size = utility::nbs::DEFAULT_FRAME_SIZE;
+                }
+                else {
+                    options.inputs.emplace_back(arg);
+                }
+            }
+
+            if (command == "compress") {
+                options.frame_size = utility::nbs::DEFAULT_FRAME_SIZE;
+            }
+            else if (command == "decompress") {
+                options.frame_size = 0;
+            }
+
+            if (command == "filter" || command == "trim" || command == "merge" || command == "compress"
+                || command == "decompress") {
+                if (options.output.empty()) {
+                    log<NUClear::ERROR>("An output file is needed for", command);
+                }
+                else {
+                    copy(options);
+                }
+            }
+            else if (command == "stats") {
+                stats(options);
+            }
+            else if (command == "extract_images") {
+                extract_images(options);
+            }
+            else {
+                print_usage();
+            }
+
+            powerplant.shutdown();
+        });
+    }
+
+    void NBSTool::copy(const Options& options) {
+
+        // Each index is sorted by timestamp so we can merge them without sorting everything again
+        std::vector<utility::nbs::Index> indices;
+        std::vector<utility::nbs::FrameReader> readers;
+        for (const auto& input : options.inputs) {
+            indices.emplace_back(std::vector<std::filesystem::path>({input}));
+            readers.emplace_back(input);
+        }
+
+        // Work out the range of timestamps we have so the trim times can be relative to them
+        uint64_t first = std::numeric_limits<uint64_t>::max();
+        uint64_t last  = 0;
+        uint64_t total = 0;
+        for (const auto& index : indices) {
+            if (index.begin() != index.end()) {
+                first = std::min(first, uint64_t(index.begin()->timestamp));
+                last  = std::max(last, uint64_t(std::prev(index.end())->timestamp));
+                total += std::distance(index.begin(), index.end());
+            }
+        }
+        const uint64_t start = offset_time(options.start, first, last);
+        const uint64_t end   = offset_time(options.end, first, last);
+
+        // The next packet from each of the files, earliest timestamp on top
+        // IndexItem is packed so its fields are copied out rather than bound to references
+        using Cursor = std::pair<uint64_t, size_t>;
+        std::priority_queue<Cursor, std::vector<Cursor>, std::greater<>> heads;
+        std::vector<std::vector<IndexItem>::const_iterator> cursors;
+        for (size_t i = 0; i < indices.size(); ++i) {
+            cursors.push_back(indices[i].begin());
+            if (cursors[i] != indices[i].end()) {
+                heads.emplace(uint64_t(cursors[i]->timestamp), i);
+            }
+        }
+
+        utility::nbs::Encoder encoder(options.output, options.frame_size);
+        ProgressBar progress("packet");
+        uint64_t current = 0;
+        uint64_t written = 0;
+        while (!heads.empty()) {
+            const size_t file = heads.top().second;
+            heads.pop();
+
+            const IndexItem& item = *cursors[file];
+            if (item.timestamp >= start && item.timestamp <= end
+                && (options.types.empty() || options.types.count(uint64_t(item.type)) != 0)) {
+                encoder.write(item, readers[file].at(uint64_t(item.offset)));
+                ++written;
+            }
+
+            if (++cursors[file] != indices[file].end()) {
+                heads.emplace(uint64_t(cursors[file]->timestamp), file);
+            }
+
+            if (++current % 1000 == 0 || current == total) {
+                progress.update(current, total);
+            }
+        }
+        encoder.close();
+
+        log<NUClear::INFO>("Wrote", written, "of", total, "packets to", options.output.string());
+    }
+
+    void NBSTool::stats(const Options& options) {
+        struct Stats {
+            uint64_t packets = 0;
+            uint64_t bytes   = 0;
+            uint64_t first   = std::numeric_limits<uint64_t>::max();
+            uint64_t last    = 0;
+        };
+
+        const utility::nbs::Index index(options.inputs);
+
+        std::map<std::string, Stats> types;
+        for (const auto& item : index) {
+            auto& s = types[type_name(item.type)];
+            s.packets += 1;
+            s.bytes += item.length;
+            s.first = std::min(s.first, uint64_t(item.timestamp));
+            s.last  = std::max(s.last, uint64_t(item.timestamp));
+        }
+
+        for (const auto& [name, s] : types) {
+            const double seconds = double(s.last - s.first) * 1e-9;
+            std::cout << fmt::format("{}\n    {} packets, {} bytes", name, s.packets, s.bytes);
+            if (seconds > 0) {
+                std::cout << fmt::format(", {:.2f} Hz, {:.0f} B/s over {:.1f} s",
+                                         double(s.packets) / seconds,
+                                         double(s.bytes) / seconds,
+                                         seconds);
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    void NBSTool::extract_images(const Options& options) {
+        const std::filesystem::path output = options.output.empty() ? std::filesystem::current_path() : options.output;
+        std::filesystem::create_directories(output);
+
+        utility::nbs::Decoder decoder(options.inputs);
+        decoder.on<CompressedImage>([&](const CompressedImage& image) {
+            const auto timestamp =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(image.timestamp.time_since_epoch()).count();
+            const std::string name = fmt::format("{}_{:012d}", image.name, timestamp);
+
+            // The compressed data is already a jpeg so it is written out as is
+            std::ofstream jpeg(output / (name + ".jpg"), std::ios::binary);
+            jpeg.write(reinterpret_cast<const char*>(image.data.data()), std::streamsize(image.data.size()));
+
+            // Write the lens and camera pose in pixel units the same way the python tool does
+            const double width = image.dimensions.x();
+            YAML::Node lens;
+            lens["projection"]   = std::string(image.lens.projection);
+            lens["focal_length"] = image.lens.focal_length * width;
+            lens["centre"].push_back(image.lens.centre.x() * width);
+            lens["centre"].push_back(image.lens.centre.y() * width);
+            lens["k"].push_back(image.lens.k.x() / std::pow(width, 2));
+            lens["k"].push_back(image.lens.k.y() / std::pow(width, 4));
+            lens["fov"] = image.lens.fov;
+
+            const Eigen::Matrix4d Hoc = image.Hcw.inverse().matrix();
+            for (int row = 0; row < 4; ++row) {
+                YAML::Node values;
+                for (int col = 0; col < 4; ++col) {
+                    values.push_back(Hoc(row, col));
+                }
+                lens["Hoc"].push_back(values);
+            }
+
+            std::ofstream yaml(output / (name + ".yaml"));
+            yaml << lens;
+        });
+
+        ProgressBar progress("packet");
+        decoder.process([&](const uint64_t& current, const uint64_t& total, const uint64_t&, const uint64_t&) {
+            if (current % 1000 == 0 || current == total) {
+                progress.update(current, total);
+            }
+        });
+    }
+
+}  // namespace module::tools
@@ -0,0 +1,90 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MODULE_TOOLS_NBSTOOL_HPP
+#define MODULE_TOOLS_NBSTOOL_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <nuclear>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace module::tools {
+
+    class NBSTool : public NUClear::Reactor {
+    private:
+        struct Options {
+            /// The nbs files to read from
+            std::vector<std::filesystem::path> inputs;
+            /// The nbs file or directory to write to
+            std::filesystem::path output;
+            /// The hashes of the message types to keep, empty to keep every type
+            std::set<uint64_t> types;
+            /// The start of the range to keep as +seconds from the first message or -seconds from the last
+            std::string start = "+0";
+            /// The end of the range to keep as +seconds from the first message or -seconds from the last
+            std::string end = "-0";
+            /// The uncompressed size of each zstd frame in the output, 0 to write a plain nbs file
+            uint32_t frame_size = 0;
+        };
+
+        /**
+         * @brief Copies packets from the inputs to the output in timestamp order, without decoding them
+         *
+         * Used for filter, trim, merge, compress and decompress. Each input's index is already sorted so the inputs are
+         * merged with a k-way merge, and packets are copied straight out of the memory mapped inputs, or out of the
+         * decompressed frame of a block compressed input. A new index is written next to the output.
+         *
+         * @param options the inputs, output, types and time range to copy
+         */
+        void copy(const Options& options);
+
+        /**
+         * @brief Prints the number of packets, bytes and the rate of each message type in the inputs
+         *
+         * Only the indexes are read, none of the packets are decoded
+         *
+         * @param options the inputs to summarise
+         */
+        void stats(const Options& options);
+
+        /**
+         * @brief Writes every compressed image in the inputs to a jpeg and a yaml file with the lens and pose
+         *
+         * @param options the inputs and the directory to write the images to
+         */
+        void extract_images(const Options& options);
+
+    public:
+        /// @brief Called by the powerplant to build and setup the NBSTool reactor.
+        explicit NBSTool(std::unique_ptr<NUClear::Environment> environment);
+    };
+
+}  // namespace module::tools
+
+#endif  // MODULE_TOOLS_NBSTOOL_HPP
@@ -40,6 +40,7 @@
 
 #include "utility/support/yaml_expression.hpp"
 #include "utility/vision/visualmesh/VisualMesh.hpp"
+#include "utility/vision/visualmesh/merge_clusters.hpp"
 
 namespace module::vision {
 
@@ -52,6 +53,7 @@ namespace module::vision {
 
     using utility::support::Expression;
     using utility::vision::visualmesh::cluster_points;
+    using utility::vision::visualmesh::merge_overlapping_clusters;
     using utility::vision::visualmesh::partition_points;
 
     GoalDetector::GoalDetector(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
@@ -100,38 +102,10 @@ namespace module::vision {
 
                 log<NUClear::DEBUG>(fmt::format("Found {} clusters that intersect the green horizon", clusters.size()));
 
-                // Find overlapping clusters and merge them
-                for (auto it = clusters.begin(); it != clusters.end(); it = std::next(it)) {
-                    // Get the largest and smallest theta values
-                    auto range_a = std::minmax_element(it->begin(), it->end(), [&uPCw](const int& a, const int& b) {
-                        return std::atan2(uPCw(1, a), uPCw(0, a)) < std::atan2(uPCw(1, b), uPCw(0, b));
-                    });
-
-                    const double min_a = std::atan2(uPCw(1, *range_a.first), uPCw(0, *range_a.first));
-                    const double max_a = std::atan2(uPCw(1, *range_a.second), uPCw(0, *range_a.second));
-
-                    for (auto it2 = std::next(it); it2 != clusters.end();) {
-                        // Get the largest and smallest theta values
-                        auto range_b =
-                            std::minmax_element(it2->begin(), it2->end(), [&uPCw](const int& a, const int& b) {
-                                return std::atan2(uPCw(1, a), uPCw(0, a)) < std::atan2(uPCw(1, b), uPCw(0, b));
-                            });
-
-                        const double min_b = std::atan2(uPCw(1, *range_b.first), uPCw(0, *range_b.first));
-                        const double max_b = std::atan2(uPCw(1, *range_b.second), uPCw(0, *range_b.second));
-
-                        // The clusters are overlapping, merge them
-                        if (((min_a <= min_b) && (min_b <= max_a)) || ((min_b <= min_a) && (min_a <= max_b))) {
-                            // Append the second cluster on to the first
-                            it->insert(it->end(), it2->begin(), it2->end());
-                            // Delete the second cluster
-                            it2 = clusters.erase(it2);
-                        }
-                        else {
-                            it2 = std::next(it2);
-                        }
-                    }
-                }
+                // Find clusters that overlap in bearing and merge them
+                merge_overlapping_clusters(clusters, [&uPCw](const int& idx) {
+                    return std::atan2(uPCw(1, idx), uPCw(0, idx));
+                });
 
                 log<NUClear::DEBUG>(fmt::format("{} clusters remaining after merging overlaps", clusters.size()));
 
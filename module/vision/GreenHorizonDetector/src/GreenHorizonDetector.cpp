@@ -151,8 +151,9 @@ namespace module::vision {
                 return;
             }
 
-            // Find the convex hull of the field points
-            auto hull_indices = utility::math::geometry::chans_convex_hull(field_cluster, rPWw);
+            // Find the convex hull of the field points, reusing the buffers from the last mesh
+            const std::lock_guard<std::mutex> lock(hull_mutex);
+            utility::math::geometry::monotone_chain_hull(field_cluster, rPWw, sorted_indices, hull_indices);
 
             // Graph the convex hull if debugging
             if (log_level <= NUClear::DEBUG) {
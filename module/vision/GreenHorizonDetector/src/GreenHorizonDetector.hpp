@@ -28,6 +28,7 @@
 #define MODULE_VISION_GREENHORIZONDETECTOR_HPP
 
 #include <Eigen/Core>
+#include <mutex>
 #include <nuclear>
 #include <vector>
 
@@ -44,6 +45,13 @@ namespace module::vision {
             double confidence_threshold = 0.0;
             uint cluster_points         = 0;
         } cfg{};
+
+        /// @brief Guards the hull buffers, as two meshes can be processed at once
+        std::mutex hull_mutex;
+        /// @brief Field point indices sorted by position, reused between meshes
+        std::vector<int> sorted_indices;
+        /// @brief Indices of the convex hull of the field points, reused between meshes
+        std::vector<int> hull_indices;
     };
 
 }  // namespace module::vision
@@ -1,17 +1,23 @@
 #include "Yolo.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <getopt.h>
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <vector>
 
 #include "extension/Configuration.hpp"
 
 #include "message/input/Image.hpp"
+#include "message/localisation/Ball.hpp"
 #include "message/vision/Ball.hpp"
 #include "message/vision/BoundingBoxes.hpp"
 #include "message/vision/FieldIntersections.hpp"
 #include "message/vision/Goal.hpp"
+#include "message/vision/GreenHorizon.hpp"
 #include "message/vision/Robot.hpp"
 
 #include "utility/math/coordinates.hpp"
@@ -33,14 +39,139 @@ namespace module::vision {
     using message::vision::FieldIntersections;
     using message::vision::Goal;
     using message::vision::Goals;
+    using message::vision::GreenHorizon;
     using message::vision::Robot;
     using message::vision::Robots;
 
     using utility::math::coordinates::cartesianToReciprocalSpherical;
     using utility::math::coordinates::cartesianToSpherical;
     using utility::support::Expression;
+    using utility::vision::project;
     using utility::vision::unproject;
 
+    void Yolo::detect(const ov::CompiledModel& model,
+                      ov::InferRequest& request,
+                      const cv::Mat& img,
+                      const cv::Rect& region,
+                      Detections& detections) {
+        // -------- Preprocess the image -------
+        // Letterbox the region into a square and scale it to the model input size
+        const int input_size  = int(model.input().get_shape()[3]);
+        int max               = MAX(region.width, region.height);
+        cv::Mat letterbox_img = cv::Mat::zeros(max, max, CV_8UC3);
+        img(region).copyTo(letterbox_img(cv::Rect(0, 0, region.width, region.height)));
+        cv::Mat blob =
+            cv::dnn::blobFromImage(letterbox_img, 1.0 / 255.0, cv::Size(input_size, input_size), cv::Scalar(), true);
+
+        // -------- Feed the blob into the input node of the Model -------
+        // Get input port for model with one input
+        auto input_port = model.input();
+        // Create tensor from external memory
+        ov::Tensor input_tensor(input_port.get_element_type(), input_port.get_shape(), blob.ptr(0));
+        // Set input tensor for model with one input
+        request.set_input_tensor(input_tensor);
+
+        // -------- Perform Inference --------
+        request.infer();
+        auto output = request.get_output_tensor(0);
+
+        // -------- Postprocess the result --------
+        float* data = output.data<float>();
+        cv::Mat output_buffer(output.get_shape()[1], output.get_shape()[2], CV_32F, data);
+        transpose(output_buffer, output_buffer);  //[8400,84]
+        float scale = letterbox_img.size[0] / float(input_size);
+
+        // Figure out the bbox, class_id and class_score
+        for (int i = 0; i < output_buffer.rows; i++) {
+            cv::Mat objects_scores = output_buffer.row(i).colRange(4, 10);
+            cv::Point class_id;
+            double confidence;
+            cv::minMaxLoc(objects_scores, 0, &confidence, 0, &class_id);
+
+            // Filter out the objects with confidence below the class threshold
+            if (confidence > objects[class_id.x].confidence_threshold) {
+                detections.confidences.push_back(confidence);
+                detections.class_ids.push_back(class_id.x);
+                float cx = output_buffer.at<float>(i, 0);
+                float cy = output_buffer.at<float>(i, 1);
+                float w  = output_buffer.at<float>(i, 2);
+                float h  = output_buffer.at<float>(i, 3);
+
+                // Scale the bbox to the region dimensions and offset it into the full image
+                int left   = int((cx - 0.5 * w) * scale) + region.x;
+                int top    = int((cy - 0.5 * h) * scale) + region.y;
+                int width  = int(w * scale);
+                int height = int(h * scale);
+                detections.boxes.push_back(cv::Rect(left, top, width, height));
+            }
+        }
+    }
+
+    std::vector<cv::Rect> Yolo::regions_of_interest(const Image& img,
+                                                    const std::shared_ptr<const message::localisation::Ball>& ball,
+                                                    const std::shared_ptr<const GreenHorizon>& horizon) {
+        const int width  = img.dimensions.x();
+        const int height = img.dimensions.y();
+        const int size   = std::min({cfg.roi.crop_size, width, height});
+
+        // Project a point in world space into the image, returning nothing if it is behind the camera
+        const Eigen::Vector2d norm_dim = Eigen::Vector2d(width, height) / width;
+        auto world_to_pix              = [&](const Eigen::Vector3d& rPWw) -> std::optional<Eigen::Vector2d> {
+            const Eigen::Vector3d rPCc = img.Hcw * rPWw;
+            if (rPCc.x() <= 0.0) {
+                return std::nullopt;
+            }
+            return project(Eigen::Vector3d(rPCc.normalized()), img.lens, norm_dim) * width;
+        };
+
+        // Square crop with the given top left corner, shifted to lie within the image
+        auto crop = [&](double x, double y) {
+            return cv::Rect(std::clamp(int(std::lround(x)), 0, width - size),
+                            std::clamp(int(std::lround(y)), 0, height - size),
+                            size,
+                            size);
+        };
+
+        std::vector<cv::Rect> regions;
+
+        // The tracked ball gets a crop centred on it, so a small distant ball is seen at full resolution
+        if (ball != nullptr) {
+            auto px = world_to_pix(ball->rBWw);
+            if (px && px->x() >= 0 && px->x() < width && px->y() >= 0 && px->y() < height) {
+                regions.push_back(crop(px->x() - size * 0.5, px->y() - size * 0.5));
+            }
+        }
+
+        // Distant objects sit just below the green horizon, so tile the band under it with crops
+        // A horizon from another camera would be projected into the wrong image, so only use this camera's
+        if (horizon != nullptr && horizon->id == img.id) {
+            double left  = width;
+            double right = 0.0;
+            double top   = height;
+            for (const auto& rPWw : horizon->horizon) {
+                if (auto px = world_to_pix(rPWw)) {
+                    left  = std::min(left, std::clamp(px->x(), 0.0, double(width)));
+                    right = std::max(right, std::clamp(px->x(), 0.0, double(width)));
+                    top   = std::min(top, std::clamp(px->y(), 0.0, double(height)));
+                }
+            }
+
+            if (right > left) {
+                const int budget = cfg.roi.max_crops - int(regions.size());
+                const int tiles  = std::min(budget, int(std::ceil((right - left) / size)));
+                for (int i = 0; i < tiles; ++i) {
+                    const double cx = left + (i + 0.5) * (right - left) / tiles;
+                    regions.push_back(crop(cx - size * 0.5, top - cfg.roi.horizon_margin));
+                }
+            }
+        }
+
+        if (int(regions.size()) > cfg.roi.max_crops) {
+            regions.resize(std::max(cfg.roi.max_crops, 0));
+        }
+        return regions;
+    }
+
     Yolo::Yolo(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
 
         on<Configuration>("Yolo.yaml").then([this](const Configuration& config) {
@@ -55,222 +186,220 @@ namespace module::vision {
             cfg.nms_threshold               = config["nms_threshold"].as<double>();
             cfg.nms_score_threshold         = config["nms_score_threshold"].as<double>();
 
-            // Compile the model and create inference request object
-            compiled_model =
-                ov::Core().compile_model(config["model_path"].as<std::string>(), config["device"].as<std::string>());
-            infer_request = compiled_model.create_infer_request();
-        });
+            cfg.roi.enabled           = config["roi"]["enabled"].as<bool>();
+            cfg.roi.input_size        = config["roi"]["input_size"].as<int>();
+            cfg.roi.crop_size         = config["roi"]["crop_size"].as<int>();
+            cfg.roi.max_crops         = config["roi"]["max_crops"].as<int>();
+            cfg.roi.full_frame_period = config["roi"]["full_frame_period"].as<int>();
+            cfg.roi.horizon_margin    = config["roi"]["horizon_margin"].as<int>();
 
-        on<Trigger<Image>, Single>().then("Yolo Main Loop", [this](const Image& img) {
-            // Start timer for benchmarking
-            auto start = std::chrono::high_resolution_clock::now();
-
-            // -------- Convert image to cv::Mat -------
-            const int width  = img.dimensions.x();
-            const int height = img.dimensions.y();
-            cv::Mat img_cv;
-            switch (img.format) {
-                case utility::vision::fourcc("BGR3"):  // BGR3 not available in utility::vision::FOURCC.
-                    img_cv = cv::Mat(height, width, CV_8UC3, const_cast<uint8_t*>(img.data.data()));
-                    break;
-                case utility::vision::FOURCC::RGGB:
-                    img_cv = cv::Mat(height, width, CV_8UC1, const_cast<uint8_t*>(img.data.data()));
-                    cv::cvtColor(img_cv, img_cv, cv::COLOR_BayerRG2RGB);
-                    break;
-                default:
-                    log<NUClear::WARN>("Image format not supported: ", utility::vision::fourcc(img.format));
-                    return;
+            // Compile the model and create inference request object
+            const auto model_path = config["model_path"].as<std::string>();
+            const auto device     = config["device"].as<std::string>();
+            ov::Core core;
+            compiled_model = core.compile_model(model_path, device);
+            infer_request  = compiled_model.create_infer_request();
+
+            // The crops use a copy of the model reshaped to a smaller input, which is what makes them cheap
+            if (cfg.roi.enabled) {
+                auto model = core.read_model(model_path);
+                model->reshape(ov::PartialShape{1, 3, cfg.roi.input_size, cfg.roi.input_size});
+                roi_model   = core.compile_model(model, device);
+                roi_request = roi_model.create_infer_request();
             }
+            frames_since_full = 0;
+        });
 
-            // -------- Preprocess the image -------
-            int max               = MAX(width, height);
-            cv::Mat letterbox_img = cv::Mat::zeros(max, max, CV_8UC3);
-            img_cv.copyTo(letterbox_img(cv::Rect(0, 0, width, height)));
-            cv::Mat blob = cv::dnn::blobFromImage(letterbox_img, 1.0 / 255.0, cv::Size(640, 640), cv::Scalar(), true);
-
-            // -------- Feed the blob into the input node of the Model -------
-            // Get input port for model with one input
-            auto input_port = compiled_model.input();
-            // Create tensor from external memory
-            ov::Tensor input_tensor(input_port.get_element_type(), input_port.get_shape(), blob.ptr(0));
-            // Set input tensor for model with one input
-            infer_request.set_input_tensor(input_tensor);
-
-            // -------- Perform Inference --------
-            infer_request.infer();
-            auto output = infer_request.get_output_tensor(0);
-
-            // -------- Postprocess the result --------
-            float* data = output.data<float>();
-            cv::Mat output_buffer(output.get_shape()[1], output.get_shape()[2], CV_32F, data);
-            transpose(output_buffer, output_buffer);  //[8400,84]
-            std::vector<int> class_ids;
-            std::vector<float> class_confidences;
-            std::vector<cv::Rect> boxes;
-            float scale = letterbox_img.size[0] / 640.0;
-
-            // Figure out the bbox, class_id and class_score
-            for (int i = 0; i < output_buffer.rows; i++) {
-                cv::Mat objects_scores = output_buffer.row(i).colRange(4, 10);
-                cv::Point class_id;
-                double confidence;
-                cv::minMaxLoc(objects_scores, 0, &confidence, 0, &class_id);
-
-                // Filter out the objects with confidence below the class threshold
-                if (confidence > objects[class_id.x].confidence_threshold) {
-                    class_confidences.push_back(confidence);
-                    class_ids.push_back(class_id.x);
-                    float cx = output_buffer.at<float>(i, 0);
-                    float cy = output_buffer.at<float>(i, 1);
-                    float w  = output_buffer.at<float>(i, 2);
-                    float h  = output_buffer.at<float>(i, 3);
-
-                    // Scale the bbox to the original image dimensions
-                    int left   = int((cx - 0.5 * w) * scale);
-                    int top    = int((cy - 0.5 * h) * scale);
-                    int width  = int(w * scale);
-                    int height = int(h * scale);
-                    boxes.push_back(cv::Rect(left, top, width, height));
+        on<Trigger<Image>, Optional<With<message::localisation::Ball>>, Optional<With<GreenHorizon>>, Single>().then(
+            "Yolo Main Loop",
+            [this](const Image& img,
+                   const std::shared_ptr<const message::localisation::Ball>& ball,
+                   const std::shared_ptr<const GreenHorizon>& horizon) {
+                // Start timer for benchmarking
+                auto start = std::chrono::high_resolution_clock::now();
+
+                // -------- Convert image to cv::Mat -------
+                const int width  = img.dimensions.x();
+                const int height = img.dimensions.y();
+                cv::Mat img_cv;
+                switch (img.format) {
+                    case utility::vision::fourcc("BGR3"):  // BGR3 not available in utility::vision::FOURCC.
+                        img_cv = cv::Mat(height, width, CV_8UC3, const_cast<uint8_t*>(img.data.data()));
+                        break;
+                    case utility::vision::FOURCC::RGGB:
+                        img_cv = cv::Mat(height, width, CV_8UC1, const_cast<uint8_t*>(img.data.data()));
+                        cv::cvtColor(img_cv, img_cv, cv::COLOR_BayerRG2RGB);
+                        break;
+                    default:
+                        log<NUClear::WARN>("Image format not supported: ", utility::vision::fourcc(img.format));
+                        return;
                 }
-            }
 
-            // Perform NMS (non maximum suppression) to remove overlapping boxes
-            std::vector<int> indices;
-            cv::dnn::NMSBoxes(boxes, class_confidences, cfg.nms_score_threshold, cfg.nms_threshold, indices);
-
-            // -------- Emit Detections --------
-            const Eigen::Isometry3d& Hwc = img.Hcw.inverse();
-
-            auto balls               = std::make_unique<Balls>();
-            auto robots              = std::make_unique<Robots>();
-            auto goals               = std::make_unique<Goals>();
-            auto field_intersections = std::make_unique<FieldIntersections>();
-            auto bounding_boxes      = std::make_unique<BoundingBoxes>();
-
-            // Common message fields
-            balls->id = robots->id = goals->id = field_intersections->id = bounding_boxes->id = img.id;
-            balls->timestamp = robots->timestamp = goals->timestamp = field_intersections->timestamp =
-                bounding_boxes->timestamp                           = img.timestamp;
-            balls->Hcw = robots->Hcw = goals->Hcw = field_intersections->Hcw = bounding_boxes->Hcw = img.Hcw;
-
-            // Helper function to simplify unprojection calls
-            auto pix_to_ray = [&](double x, double y) {
-                // Normalize the pixel coordinates to the image width normalized dimensions
-                Eigen::Vector2d norm_dim = Eigen::Vector2d(img.dimensions.x(), img.dimensions.y()) / img.dimensions.x();
-                return unproject(Eigen::Matrix<double, 2, 1>(x / img.dimensions.x(), y / img.dimensions.x()),
-                                 img.lens,
-                                 norm_dim);
-            };
-
-            // Helper function to simplify projecting rays onto the field plane then transforming into camera space
-            auto ray_to_camera_space = [&](const Eigen::Matrix<double, 3, 1>& ray) {
-                Eigen::Vector3d uBCw = Hwc.rotation() * ray;
-                Eigen::Vector3d rPWw = uBCw * std::abs(Hwc.translation().z() / uBCw.z()) + Hwc.translation();
-                return Hwc.inverse() * rPWw;
-            };
-
-            for (size_t i = 0; i < indices.size(); i++) {
-                // Get the index of the detected object from list of indices
-                int idx = indices[i];
-                // Get the class id associated with the detected object
-                int class_id = class_ids[idx];
-
-                // Convert the bounding box points to unit vectors (rays) in the camera {c} space
-                Eigen::Vector3d top_left_ray  = pix_to_ray(boxes[idx].x, boxes[idx].y);
-                Eigen::Vector3d top_right_ray = pix_to_ray(boxes[idx].x + boxes[idx].width, boxes[idx].y);
-                Eigen::Vector3d bottom_right_ray =
-                    pix_to_ray(boxes[idx].x + boxes[idx].width, boxes[idx].y + boxes[idx].height);
-                Eigen::Vector3d bottom_left_ray = pix_to_ray(boxes[idx].x, boxes[idx].y + boxes[idx].height);
-                Eigen::Vector3d centre_ray =
-                    pix_to_ray(boxes[idx].x + boxes[idx].width / 2.0, boxes[idx].y + boxes[idx].height / 2.0);
-                Eigen::Vector3d bottom_centre_ray =
-                    pix_to_ray(boxes[idx].x + boxes[idx].width / 2.0, boxes[idx].y + boxes[idx].height);
-                Eigen::Vector3d top_centre_ray = pix_to_ray(boxes[idx].x + boxes[idx].width / 2.0, boxes[idx].y);
-
-                auto bbox        = std::make_unique<BoundingBox>();
-                bbox->name       = objects[class_id].name;
-                bbox->confidence = class_confidences[idx];
-                bbox->corners.push_back(top_left_ray);
-                bbox->corners.push_back(top_right_ray);
-                bbox->corners.push_back(bottom_right_ray);
-                bbox->corners.push_back(bottom_left_ray);
-
-
-                if (objects[class_id].name == "ball") {
-                    Ball b;
-                    b.uBCc = ray_to_camera_space(centre_ray).normalized();
-                    b.measurements.emplace_back();
-                    b.measurements.back().type = Ball::MeasurementType::PROJECTION;
-                    b.measurements.back().rBCc = ray_to_camera_space(centre_ray);
-                    // Calculate the angular radius of the ball in camera space
-                    b.radius = bottom_centre_ray.dot(bottom_left_ray);
-                    b.colour.fill(1.0);
-                    balls->balls.push_back(b);
-                    bbox->colour = objects[class_id].colour;
-                    bounding_boxes->bounding_boxes.push_back(*bbox);
+                // -------- Run inference -------
+                // Run on crops around the regions of interest, falling back to the full frame periodically or when
+                // there is nothing to look at
+                Detections detections;
+                std::vector<cv::Rect> regions;
+                if (cfg.roi.enabled && frames_since_full + 1 < cfg.roi.full_frame_period) {
+                    regions = regions_of_interest(img, ball, horizon);
                 }
-
-                if (objects[class_id].name == "goal post") {
-                    Goal g;
-                    g.measurements.emplace_back();
-                    g.measurements.back().type = Goal::MeasurementType::CENTRE;
-                    g.measurements.back().rGCc = ray_to_camera_space(bottom_centre_ray);
-                    g.post.top                 = top_centre_ray;
-                    g.post.bottom              = bottom_centre_ray;
-                    g.post.distance            = ray_to_camera_space(bottom_centre_ray).norm();
-                    g.side                     = Goal::Side::UNKNOWN_SIDE;
-                    g.screen_angular           = cartesianToSpherical(g.post.bottom).tail<2>();
-                    goals->goals.push_back(std::move(g));
-                    bbox->colour = objects[class_id].colour;
-                    bounding_boxes->bounding_boxes.push_back(*bbox);
+                if (regions.empty()) {
+                    detect(compiled_model, infer_request, img_cv, cv::Rect(0, 0, width, height), detections);
+                    frames_since_full = 0;
                 }
-
-                if (objects[class_id].name == "robot") {
-                    Robot r;
-                    r.rRCc   = ray_to_camera_space(bottom_centre_ray);
-                    r.radius = bottom_centre_ray.dot(bottom_left_ray);
-                    robots->robots.push_back(r);
-                    bbox->colour = objects[class_id].colour;
-                    bounding_boxes->bounding_boxes.push_back(*bbox);
+                else {
+                    for (const auto& region : regions) {
+                        detect(roi_model, roi_request, img_cv, region, detections);
+                    }
+                    frames_since_full++;
                 }
-
-                if (objects[class_id].name == "L-intersection" || objects[class_id].name == "T-intersection"
-                    || objects[class_id].name == "X-intersection") {
-                    FieldIntersection i;
-                    // Project the centre ray onto the ground plane in world {w} space
-                    Eigen::Vector3d uICw = Hwc.rotation() * centre_ray;
-                    Eigen::Vector3d rIWw = uICw * std::abs(Hwc.translation().z() / uICw.z()) + Hwc.translation();
-                    i.rIWw               = rIWw;
-                    if (objects[class_id].name == "L-intersection") {
-                        i.type       = FieldIntersection::IntersectionType::L_INTERSECTION;
+                std::vector<int>& class_ids          = detections.class_ids;
+                std::vector<float>& class_confidences = detections.confidences;
+                std::vector<cv::Rect>& boxes          = detections.boxes;
+
+                // Perform NMS (non maximum suppression) to remove overlapping boxes, including duplicates from
+                // overlapping crops
+                std::vector<int> indices;
+                cv::dnn::NMSBoxes(boxes, class_confidences, cfg.nms_score_threshold, cfg.nms_threshold, indices);
+
+                // -------- Emit Detections --------
+                const Eigen::Isometry3d& Hwc = img.Hcw.inverse();
+
+                auto balls               = std::make_unique<Balls>();
+                auto robots              = std::make_unique<Robots>();
+                auto goals               = std::make_unique<Goals>();
+                auto field_intersections = std::make_unique<FieldIntersections>();
+                auto bounding_boxes      = std::make_unique<BoundingBoxes>();
+
+                // Common message fields
+                balls->id = robots->id = goals->id = field_intersections->id = bounding_boxes->id = img.id;
+                balls->timestamp = robots->timestamp = goals->timestamp = field_intersections->timestamp =
+                    bounding_boxes->timestamp                           = img.timestamp;
+                balls->Hcw = robots->Hcw = goals->Hcw = field_intersections->Hcw = bounding_boxes->Hcw = img.Hcw;
+
+                // Helper function to simplify unprojection calls
+                auto pix_to_ray = [&](double x, double y) {
+                    // Normalize the pixel coordinates to the image width normalized dimensions
+                    Eigen::Vector2d norm_dim =
+                        Eigen::Vector2d(img.dimensions.x(), img.dimensions.y()) / img.dimensions.x();
+                    return unproject(Eigen::Matrix<double, 2, 1>(x / img.dimensions.x(), y / img.dimensions.x()),
+                                     img.lens,
+                                     norm_dim);
+                };
+
+                // Helper function to simplify projecting rays onto the field plane then transforming into camera space
+                auto ray_to_camera_space = [&](const Eigen::Matrix<double, 3, 1>& ray) {
+                    Eigen::Vector3d uBCw = Hwc.rotation() * ray;
+                    Eigen::Vector3d rPWw = uBCw * std::abs(Hwc.translation().z() / uBCw.z()) + Hwc.translation();
+                    return Hwc.inverse() * rPWw;
+                };
+
+                for (size_t i = 0; i < indices.size(); i++) {
+                    // Get the index of the detected object from list of indices
+                    int idx = indices[i];
+                    // Get the class id associated with the detected object
+                    int class_id = class_ids[idx];
+
+                    // Convert the bounding box points to unit vectors (rays) in the camera {c} space
+                    Eigen::Vector3d top_left_ray  = pix_to_ray(boxes[idx].x, boxes[idx].y);
+                    Eigen::Vector3d top_right_ray = pix_to_ray(boxes[idx].x + boxes[idx].width, boxes[idx].y);
+                    Eigen::Vector3d bottom_right_ray =
+                        pix_to_ray(boxes[idx].x + boxes[idx].width, boxes[idx].y + boxes[idx].height);
+                    Eigen::Vector3d bottom_left_ray = pix_to_ray(boxes[idx].x, boxes[idx].y + boxes[idx].height);
+                    Eigen::Vector3d centre_ray =
+                        pix_to_ray(boxes[idx].x + boxes[idx].width / 2.0, boxes[idx].y + boxes[idx].height / 2.0);
+                    Eigen::Vector3d bottom_centre_ray =
+                        pix_to_ray(boxes[idx].x + boxes[idx].width / 2.0, boxes[idx].y + boxes[idx].height);
+                    Eigen::Vector3d top_centre_ray = pix_to_ray(boxes[idx].x + boxes[idx].width / 2.0, boxes[idx].y);
+
+                    auto bbox        = std::make_unique<BoundingBox>();
+                    bbox->name       = objects[class_id].name;
+                    bbox->confidence = class_confidences[idx];
+                    bbox->corners.push_back(top_left_ray);
+                    bbox->corners.push_back(top_right_ray);
+                    bbox->corners.push_back(bottom_right_ray);
+                    bbox->corners.push_back(bottom_left_ray);
+
+
+                    if (objects[class_id].name == "ball") {
+                        Ball b;
+                        b.uBCc = ray_to_camera_space(centre_ray).normalized();
+                        b.measurements.emplace_back();
+                        b.measurements.back().type = Ball::MeasurementType::PROJECTION;
+                        b.measurements.back().rBCc = ray_to_camera_space(centre_ray);
+                        // Calculate the angular radius of the ball in camera space
+                        b.radius = bottom_centre_ray.dot(bottom_left_ray);
+                        b.colour.fill(1.0);
+                        balls->balls.push_back(b);
                         bbox->colour = objects[class_id].colour;
+                        bounding_boxes->bounding_boxes.push_back(*bbox);
                     }
-                    else if (objects[class_id].name == "T-intersection") {
-                        i.type       = FieldIntersection::IntersectionType::T_INTERSECTION;
+
+                    if (objects[class_id].name == "goal post") {
+                        Goal g;
+                        g.measurements.emplace_back();
+                        g.measurements.back().type = Goal::MeasurementType::CENTRE;
+                        g.measurements.back().rGCc = ray_to_camera_space(bottom_centre_ray);
+                        g.post.top                 = top_centre_ray;
+                        g.post.bottom              = bottom_centre_ray;
+                        g.post.distance            = ray_to_camera_space(bottom_centre_ray).norm();
+                        g.side                     = Goal::Side::UNKNOWN_SIDE;
+                        g.screen_angular           = cartesianToSpherical(g.post.bottom).tail<2>();
+                        goals->goals.push_back(std::move(g));
                         bbox->colour = objects[class_id].colour;
+                        bounding_boxes->bounding_boxes.push_back(*bbox);
                     }
-                    else if (objects[class_id].name == "X-intersection") {
-                        i.type       = FieldIntersection::IntersectionType::X_INTERSECTION;
+
+                    if (objects[class_id].name == "robot") {
+                        Robot r;
+                        r.rRCc   = ray_to_camera_space(bottom_centre_ray);
+                        r.radius = bottom_centre_ray.dot(bottom_left_ray);
+                        robots->robots.push_back(r);
                         bbox->colour = objects[class_id].colour;
+                        bounding_boxes->bounding_boxes.push_back(*bbox);
+                    }
+
+                    if (objects[class_id].name == "L-intersection" || objects[class_id].name == "T-intersection"
+                        || objects[class_id].name == "X-intersection") {
+                        FieldIntersection i;
+                        // Project the centre ray onto the ground plane in world {w} space
+                        Eigen::Vector3d uICw = Hwc.rotation() * centre_ray;
+                        Eigen::Vector3d rIWw = uICw * std::abs(Hwc.translation().z() / uICw.z()) + Hwc.translation();
+                        i.rIWw               = rIWw;
+                        if (objects[class_id].name == "L-intersection") {
+                            i.type       = FieldIntersection::IntersectionType::L_INTERSECTION;
+                            bbox->colour = objects[class_id].colour;
+                        }
+                        else if (objects[class_id].name == "T-intersection") {
+                            i.type       = FieldIntersection::IntersectionType::T_INTERSECTION;
+                            bbox->colour = objects[class_id].colour;
+                        }
+                        else if (objects[class_id].name == "X-intersection") {
+                            i.type       = FieldIntersection::IntersectionType::X_INTERSECTION;
+                            bbox->colour = objects[class_id].colour;
+                        }
+                        field_intersections->intersections.push_back(std::move(i));
+                        bounding_boxes->bounding_boxes.push_back(*bbox);
                     }
-                    field_intersections->intersections.push_back(std::move(i));
-                    bounding_boxes->bounding_boxes.push_back(*bbox);
                 }
-            }
 
-            emit(std::move(balls));
-            emit(std::move(robots));
-            emit(std::move(goals));
-            emit(std::move(field_intersections));
-            emit(std::move(bounding_boxes));
-
-            // -------- Benchmark --------
-            if (log_level <= NUClear::DEBUG) {
-                auto end      = std::chrono::high_resolution_clock::now();
-                auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-                log<NUClear::DEBUG>("Yolo took: ", duration, "ms");
-                log<NUClear::DEBUG>("FPS: ", 1000.0 / duration);
-            }
+                emit(std::move(balls));
+                emit(std::move(robots));
+                emit(std::move(goals));
+                emit(std::move(field_intersections));
+                emit(std::move(bounding_boxes));
+
+                // -------- Benchmark --------
+                if (log_level <= NUClear::DEBUG) {
+                    auto end      = std::chrono::high_resolution_clock::now();
+                    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+                    log<NUClear::DEBUG>("Yolo took: ",
+                                        duration,
+                                        "ms over ",
+                                        std::max<size_t>(regions.size(), 1),
+                                        " inference passes");
+                    log<NUClear::DEBUG>("FPS: ", 1000.0 / duration);
+                }
         });
     }
 
@@ -5,6 +5,11 @@
 #include <nuclear>
 #include <opencv2/opencv.hpp>
 #include <openvino/openvino.hpp>
+#include <vector>
+
+#include "message/input/Image.hpp"
+#include "message/localisation/Ball.hpp"
+#include "message/vision/GreenHorizon.hpp"
 
 namespace module::vision {
 
@@ -16,14 +21,48 @@ namespace module::vision {
             double nms_threshold = 0.5;
             /// @brief NMS confidence (score) threshold for filtering out low confidence detections
             double nms_score_threshold = 0.5;
+            /// @brief Region of interest inference settings
+            struct ROI {
+                /// @brief Whether to run inference on crops around regions of interest instead of the full frame
+                bool enabled = false;
+                /// @brief Side length in pixels of the square model input used for the crops
+                int input_size = 320;
+                /// @brief Side length in image pixels of each square crop
+                int crop_size = 320;
+                /// @brief Maximum number of crops to run inference on in a single frame
+                int max_crops = 4;
+                /// @brief Run a full frame pass every this many frames
+                int full_frame_period = 10;
+                /// @brief Distance in pixels the horizon crops extend above the green horizon
+                int horizon_margin = 32;
+            } roi;
         } cfg;
 
+        /// @brief Detections accumulated over one or more inference passes, in full image coordinates
+        struct Detections {
+            /// @brief Class index of each detection
+            std::vector<int> class_ids;
+            /// @brief Confidence of each detection
+            std::vector<float> confidences;
+            /// @brief Bounding box of each detection
+            std::vector<cv::Rect> boxes;
+        };
+
         /// @brief OpenVINO compiled model, used to create inference request object
         ov::CompiledModel compiled_model{};
 
         /// @brief Inference request, used to run the model (inference)
         ov::InferRequest infer_request{};
 
+        /// @brief OpenVINO compiled model reshaped to the region of interest input size
+        ov::CompiledModel roi_model{};
+
+        /// @brief Inference request for the region of interest model
+        ov::InferRequest roi_request{};
+
+        /// @brief Number of frames since the last full frame pass
+        int frames_since_full = 0;
+
         /// @brief Object struct for storing name and colour
         struct Object {
             /// @brief Class name
@@ -43,6 +82,34 @@ namespace module::vision {
                                        {"X-intersection", Eigen::Vector4d(0, 0, 1, 1), 0.0}};
 
 
+        /**
+         * @brief Runs the model on a region of the image and appends the detections to the given list
+         *
+         * @param model      the compiled model to run
+         * @param request    the inference request created from the model
+         * @param img        the full image
+         * @param region     the region of the image to run inference on
+         * @param detections the detections to append to, in full image coordinates
+         */
+        void detect(const ov::CompiledModel& model,
+                    ov::InferRequest& request,
+                    const cv::Mat& img,
+                    const cv::Rect& region,
+                    Detections& detections);
+
+        /**
+         * @brief Finds the crops to run inference on, around the tracked ball and along the green horizon
+         *
+         * @param img     the image the crops are taken from
+         * @param ball    the tracked ball from ball localisation, if available
+         * @param horizon the most recent green horizon, if available. Ignored if it is from a different camera
+         *
+         * @return the crops in image coordinates, at most `cfg.roi.max_crops` of them
+         */
+        std::vector<cv::Rect> regions_of_interest(const message::input::Image& img,
+                                                  const std::shared_ptr<const message::localisation::Ball>& ball,
+                                                  const std::shared_ptr<const message::vision::GreenHorizon>& horizon);
+
     public:
         /// @brief Called by the powerplant to build and setup the Yolo reactor.
         explicit Yolo(std::unique_ptr<NUClear::Environment> environment);
@@ -34,6 +34,54 @@ import google.protobuf.message
 import xxhash
 from generator.textutil import dedent, indent
 
+
+# Multiplier used to mix the displaced hash before taking the slot from the top bits
+MIX = 0x9E3779B97F4A7C15
+
+
+def perfect_hash(hashes):
+    """Builds a hash and displace table that sends each of the hashes to its own slot
+
+    Hashes are split into buckets by their low bits, and each bucket is given a displacement that is xored into the
+    hash before mixing so none of its hashes collide with the slots already taken.
+    """
+
+    # Keep the table at most 80% full so displacements are quick to find
+    slot_bits = max(1, (len(hashes) * 5 // 4).bit_length())
+    n_slots = 1 << slot_bits
+    n_buckets = 1 << max(0, (len(hashes) // 4).bit_length())
+
+    if len(set(hashes)) != len(hashes):
+        raise RuntimeError("Two message types have the same hash")
+
+    def slot(h, d):
+        return (((h ^ d) * MIX) & 0xFFFFFFFFFFFFFFFF) >> (64 - slot_bits)
+
+    buckets = [[] for _ in range(n_buckets)]
+    for i, h in enumerate(hashes):
+        buckets[h & (n_buckets - 1)].append(i)
+
+    displacement = [0] * n_buckets
+    slot_hash = [0] * n_slots
+    slot_index = [len(hashes)] * n_slots
+
+    # Place the largest buckets first while the table is still empty
+    for b in sorted(range(n_buckets), key=lambda b: len(buckets[b]), reverse=True):
+        d = 0
+        while True:
+            slots = [slot(hashes[i], d) for i in buckets[b]]
+            if len(set(slots)) == len(slots) and all(slot_index[s] == len(hashes) for s in slots):
+                break
+            d += 1
+
+        displacement[b] = d
+        for i, s in zip(buckets[b], slots):
+            slot_hash[s] = hashes[i]
+            slot_index[s] = i
+
+    return displacement, slot_bits, slot_hash, slot_index
+
+
 if __name__ == "__main__":
 
     python_message_root = sys.argv[1]
@@ -74,33 +122,27 @@ if __name__ == "__main__":
         if pb_type.startswith("message.") and not message.DESCRIPTOR.GetOptions().map_entry:
             messages.add(pb_type)
 
-    messages = list(messages)
+    # Sort so the generated tables are the same between builds
+    messages = sorted(messages)
+    hashes = [xxhash.xxh64(m.encode("utf-8"), seed=0x4E55436C).intdigest() for m in messages]
+
+    # Build a perfect hash so every message type lands in its own slot
+    displacement, slot_bits, slot_hash, slot_index = perfect_hash(hashes)
 
     includes = "\n".join('#include "{}"'.format(i) for i in includes)
 
-    cases_reflect = "\n".join(
-        [
-            "case 0x{}: return std::make_unique<Reflector<{}>>();".format(
-                xxhash.xxh64(m, seed=0x4E55436C).hexdigest(), "::".join(m.split("."))
-            )
-            for m in messages
-        ]
+    instances_reflect = ",\n".join(
+        ["detail::instance<Reflector, {}>()".format("::".join(m.split("."))) for m in messages]
     )
 
-    cases_trait = "\n".join(
-        [
-            "case 0x{}: return TypeTrait<{}>::value;".format(
-                xxhash.xxh64(m, seed=0x4E55436C).hexdigest(), "::".join(m.split("."))
-            )
-            for m in messages
-        ]
-    )
+    values_trait = ",\n".join(["TypeTrait<{}>::value".format("::".join(m.split("."))) for m in messages])
 
     output = dedent(
         """\
         #ifndef MESSAGE_REFLECTION_HPP
         #define MESSAGE_REFLECTION_HPP
 
+        #include <array>
         #include <cstdint>
         #include <memory>
         #include <string>
@@ -114,27 +156,97 @@ if __name__ == "__main__":
         namespace message::reflection {{
             using utility::reflection::unknown_message;
 
-            template <template <typename> class Reflector>
-            std::unique_ptr<Reflector<void>> from_hash(const uint64_t& hash) {{
-                switch (hash) {{
-        {cases}
-                    default: throw unknown_message(hash);
+            namespace detail {{
+                /// The number of message types that can be reflected
+                constexpr uint32_t N_MESSAGES = {n_messages};
+
+                /// The number of bits used to select a slot in the hash table
+                constexpr int SLOT_BITS = {slot_bits};
+
+                /// Per bucket displacement that moves every type hash in the bucket into its own slot
+                constexpr std::array<uint64_t, {n_buckets}> displacement = {{{{
+        {displacement}
+                }}}};
+
+                /// The type hash held in each slot, used to reject hashes that are not one of our messages
+                constexpr std::array<uint64_t, {n_slots}> slot_hash = {{{{
+        {slot_hash}
+                }}}};
+
+                /// The index of the message type held in each slot, or N_MESSAGES if the slot is empty
+                constexpr std::array<uint32_t, {n_slots}> slot_index = {{{{
+        {slot_index}
+                }}}};
+
+                /**
+                 * @brief Finds the index of a message type from its type hash without branching on the hash
+                 *
+                 * @param hash the type hash of the message
+                 *
+                 * @return the index of the message type in the reflection tables
+                 *
+                 * @throws unknown_message if the hash is not one of our message types
+                 */
+                inline uint32_t index(const uint64_t& hash) {{
+                    const uint64_t d  = displacement[hash & (displacement.size() - 1)];
+                    const size_t slot = ((hash ^ d) * 0x9E3779B97F4A7C15ULL) >> (64 - SLOT_BITS);
+                    if (slot_index[slot] == N_MESSAGES || slot_hash[slot] != hash) {{
+                        throw unknown_message(hash);
+                    }}
+                    return slot_index[slot];
                 }}
+
+                /// Holds the single reflector instance for each message type
+                template <template <typename> class Reflector, typename T>
+                Reflector<void>* instance() {{
+                    static Reflector<T> reflector;
+                    return &reflector;
+                }}
+            }}  // namespace detail
+
+            /**
+             * @brief Gets the reflector for the message type with this hash
+             *
+             * The reflectors are built once on first use and shared between every lookup afterwards
+             *
+             * @tparam Reflector the reflector template, Reflector<void> is the interface that all of them implement
+             *
+             * @param hash the type hash of the message
+             *
+             * @return the reflector for the message type
+             */
+            template <template <typename> class Reflector>
+            Reflector<void>& from_hash(const uint64_t& hash) {{
+                static const std::array<Reflector<void>*, detail::N_MESSAGES> reflectors = {{{{
+        {instances}
+                }}}};
+                return *reflectors[detail::index(hash)];
             }}
 
             template <template <typename> class TypeTrait>
             bool trait_from_hash(const uint64_t& hash) {{
-                switch(hash){{
-        {cases_id}
-                default: throw unknown_message(hash);
-                }}
+                static constexpr std::array<bool, detail::N_MESSAGES> traits = {{{{
+        {traits}
+                }}}};
+                return traits[detail::index(hash)];
             }}
 
         }}  // namespace message::reflection
 
         #endif  // MESSAGE_REFLECTION_HPP
         """
-    ).format(includes=includes, cases=indent(cases_reflect, 12), cases_id=indent(cases_trait, 12))
+    ).format(
+        includes=includes,
+        n_messages=len(messages),
+        slot_bits=slot_bits,
+        n_buckets=len(displacement),
+        n_slots=len(slot_hash),
+        displacement=indent(",\n".join(str(d) for d in displacement), 12),
+        slot_hash=indent(",\n".join("0x{:016x}".format(h) for h in slot_hash), 12),
+        slot_index=indent(",\n".join(str(i) for i in slot_index), 12),
+        instances=indent(instances_reflect, 12),
+        traits=indent(values_trait, 12),
+    )
 
     with open(reflection_output_header, "w") as f:
         f.write(output)
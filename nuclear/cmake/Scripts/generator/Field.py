@@ -112,6 +112,34 @@ class Field:
         # Since our cpp_type is used a lot, precalculate it
         self.cpp_type, self.special_cpp_type = self.get_cpp_type_info()
 
+        # How a value of this field is encoded on the wire (see message/WireFormat.hpp)
+        self.wire_kind = self.get_wire_kind(f)
+
+    def get_wire_kind(self, f):
+
+        # Messages that are converted to native types (vectors, timestamps, ...) have their own codecs
+        if f.type in [f.TYPE_MESSAGE, f.TYPE_GROUP]:
+            return "::message::wire::Special" if self.special_cpp_type else "::message::wire::Message"
+
+        return {
+            f.TYPE_DOUBLE: "::message::wire::Fixed<double>",
+            f.TYPE_FLOAT: "::message::wire::Fixed<float>",
+            f.TYPE_INT64: "::message::wire::Varint",
+            f.TYPE_UINT64: "::message::wire::Varint",
+            f.TYPE_INT32: "::message::wire::Varint",
+            f.TYPE_FIXED64: "::message::wire::Fixed<uint64_t>",
+            f.TYPE_FIXED32: "::message::wire::Fixed<uint32_t>",
+            f.TYPE_BOOL: "::message::wire::Varint",
+            f.TYPE_STRING: "::message::wire::Bytes",
+            f.TYPE_BYTES: "::message::wire::Bytes",
+            f.TYPE_UINT32: "::message::wire::Varint",
+            f.TYPE_ENUM: "::message::wire::Enum",
+            f.TYPE_SFIXED32: "::message::wire::Fixed<int32_t>",
+            f.TYPE_SFIXED64: "::message::wire::Fixed<int64_t>",
+            f.TYPE_SINT32: "::message::wire::ZigZag",
+            f.TYPE_SINT64: "::message::wire::ZigZag",
+        }[f.type]
+
     def get_cpp_type_info(self):
 
         t = self.type
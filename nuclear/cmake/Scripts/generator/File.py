@@ -91,6 +91,7 @@ class File:
                 "google/protobuf/duration.proto",
             ]:
                 includes.add('4"message/conversion/proto_conversion.hpp"')
+                includes.add('4"message/conversion/wire_conversion.hpp"')
             elif d in ["Neutron.proto"]:
                 pass  # We don't need to do anything for these ones
             else:
@@ -490,6 +490,137 @@ class Message:
 
             return "operator {0}() const;".format(protobuf_name), "\n".join(lines)
 
+    def generate_wire_format(self):
+
+        # Fully qualified c++ name
+        cpp_fqn = "::".join(self.fqn.split("."))
+
+        # Work out how to size, write and read each field
+        writers = []
+        readers = []
+        counters = []
+        for v in self.fields:
+
+            # Pointers are not converted to protobuf so they are not written either
+            if v.pointer:
+                continue
+
+            elif v.one_of:
+                # Each member of the oneof is written in its own field number position when it is the active one
+                for o in v.oneof_fields:
+                    present = "::message::wire::Present<{}>".format(o.wire_kind)
+                    value = "this->{}.{}.get()".format(v.name, o.name)
+                    writers.append(
+                        (
+                            o.number,
+                            "if (this->{}.val_index == {}) {{ size += {}::size({}, {}); }}".format(
+                                v.name, o.number, present, o.number, value
+                            ),
+                            "if (this->{}.val_index == {}) {{ {}::write(out, {}, {}); }}".format(
+                                v.name, o.number, present, o.number, value
+                            ),
+                        )
+                    )
+                    readers.append(
+                        (
+                            o.number,
+                            "::message::wire::OneOf<{}, {}>::read(in, type, this->{}.{});".format(
+                                o.wire_kind, o.cpp_type, v.name, o.name
+                            ),
+                        )
+                    )
+                continue
+
+            elif v.map_type:
+                wrapper = "::message::wire::Map<{}, {}>".format(v.type[0].wire_kind, v.type[1].wire_kind)
+            elif v.repeated:
+                wrapper = "::message::wire::Repeated<{}>".format(v.wire_kind)
+            elif v.wire_kind in ["::message::wire::Message", "::message::wire::Special"]:
+                # The protobuf converter always sets submessages, so they are always written
+                wrapper = "::message::wire::Present<{}>".format(v.wire_kind)
+            else:
+                wrapper = "::message::wire::Singular<{}>".format(v.wire_kind)
+
+            writers.append(
+                (
+                    v.number,
+                    "size += {}::size({}, this->{});".format(wrapper, v.number, v.name),
+                    "{}::write(out, {}, this->{});".format(wrapper, v.number, v.name),
+                )
+            )
+
+            # Fixed size arrays need to count how many values they have read
+            if v.repeated and v.array_size > 0:
+                counters.append("size_t {}_index = 0;".format(v.name))
+                readers.append(
+                    (v.number, "{}::read(in, type, this->{}, {}_index);".format(wrapper, v.name, v.name))
+                )
+            else:
+                readers.append((v.number, "{}::read(in, type, this->{});".format(wrapper, v.name)))
+
+        # Protobuf writes fields in field number order
+        writers.sort(key=lambda w: w[0])
+        readers.sort(key=lambda r: r[0])
+
+        header = dedent(
+            """\
+            [[nodiscard]] size_t wire_size() const;
+            void wire_write(::message::wire::Writer& out) const;
+            void wire_read(::message::wire::Reader& in);"""
+        )
+
+        # If we are empty it's easy
+        if not writers:
+            impl = dedent(
+                """\
+                size_t {fqn}::wire_size() const {{
+                    return 0;
+                }}
+
+                void {fqn}::wire_write(::message::wire::Writer& /*out*/) const {{}}
+
+                void {fqn}::wire_read(::message::wire::Reader& in) {{
+                    while (!in.done()) {{
+                        in.skip(in.tag().second);
+                    }}
+                }}"""
+            ).format(fqn=cpp_fqn)
+
+            return header, impl
+
+        impl_template = dedent(
+            """\
+            size_t {fqn}::wire_size() const {{
+                size_t size = 0;
+            {sizes}
+                return size;
+            }}
+
+            void {fqn}::wire_write(::message::wire::Writer& out) const {{
+            {writes}
+            }}
+
+            void {fqn}::wire_read(::message::wire::Reader& in) {{
+            {counters}    while (!in.done()) {{
+                    const auto [number, type] = in.tag();
+                    switch (number) {{
+            {cases}
+                        default: in.skip(type); break;
+                    }}
+                }}
+            }}"""
+        )
+
+        impl = impl_template.format(
+            fqn=cpp_fqn,
+            sizes=indent("\n".join(w[1] for w in writers)),
+            writes=indent("\n".join(w[2] for w in writers)),
+            counters=indent("\n".join(counters)) + "\n" if counters else "",
+            cases=indent("\n".join("case {}: {} break;".format(r[0], r[1]) for r in readers), 12),
+        )
+
+        return header, impl
+
     def generate_cpp(self):
 
         # Make our value pairs
@@ -516,6 +647,7 @@ class Message:
         protobuf_constructor = self.generate_protobuf_constructor()
         protobuf_converter = self.generate_protobuf_converter()
         equality_operator = self.generate_equality_operator()
+        wire_format = self.generate_wire_format()
 
         constructor_headers = indent(
             "\n\n".join([default_constructor[0], rule_of_five[0], protobuf_constructor[0], equality_operator[0]])
@@ -523,6 +655,8 @@ class Message:
         constructor_impl = "\n\n".join([default_constructor[1], protobuf_constructor[1], equality_operator[1]])
         converter_headers = indent("\n\n".join([protobuf_converter[0]]))
         converter_impl = "\n\n".join([protobuf_converter[1]])
+        wire_format_headers = indent(wire_format[0])
+        wire_format_impl = wire_format[1]
 
         header_template = dedent(
             """\
@@ -538,6 +672,8 @@ class Message:
             {constructors}
                 // Converters
             {converters}
+                // Wire format
+            {wire_format}
                 // Fields
             {fields}
             }};"""
@@ -551,6 +687,9 @@ class Message:
             // Converters
             {converters}
 
+            // Wire format
+            {wire_format}
+
             // Subenums
             {enums}
 
@@ -627,10 +766,15 @@ class Message:
                 constructors=constructor_headers,
                 protobuf_type=protobuf_type,
                 converters=converter_headers,
+                wire_format=wire_format_headers,
                 fields=fields,
             ),
             impl_template.format(
-                constructors=constructor_impl, converters=converter_impl, enums=enum_impls, submessages=submessage_impls
+                constructors=constructor_impl,
+                converters=converter_impl,
+                wire_format=wire_format_impl,
+                enums=enum_impls,
+                submessages=submessage_impls,
             ),
             python_template.format(
                 constructor=indent(python_constructor, 8),
@@ -29,6 +29,8 @@
 
 #include <nuclear>
 
+#include "WireFormat.hpp"
+
 namespace message {
     template <typename T>
     class MessageBase : public std::enable_shared_from_this<T> {};
@@ -43,23 +45,22 @@ namespace NUClear::util::serialise {
 
         static inline std::vector<uint8_t> serialise(const T& in) {
 
-            protobuf_type proto = in;
-
-            std::vector<uint8_t> output(proto.ByteSizeLong());
-            proto.SerializeToArray(output.data(), output.size());
+            // Write the protobuf wire format directly from the Neutron without building a protobuf message
+            std::vector<uint8_t> output(in.wire_size());
+            ::message::wire::Writer writer(output.data());
+            in.wire_write(writer);
 
             return output;
         }
 
         [[nodiscard]] static inline T deserialise(const uint8_t* in, const size_t& length) {
 
-            // Make a buffer
-            protobuf_type out;
+            // Start from the values an empty protobuf message would give us
+            T out(protobuf_type::default_instance());
 
-            // Deserialize it
-            if (!out.ParseFromArray(in, length)) {
-                throw std::runtime_error("Message failed to deserialise.");
-            }
+            // Read the fields that are present (throws if the data is malformed)
+            ::message::wire::Reader reader(in, length);
+            out.wire_read(reader);
 
             return out;
         }
@@ -0,0 +1,680 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MESSAGE_WIREFORMAT_HPP
+#define MESSAGE_WIREFORMAT_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Direct protobuf wire format encoding for Neutron messages.
+ *
+ * The generated Neutron classes use these to write themselves straight into a byte buffer, and to read themselves
+ * straight out of one, without building an intermediate protobuf object. The bytes produced are the same as the ones
+ * protobuf produces for the equivalent protobuf message.
+ *
+ * Each field is described by a kind (Varint, ZigZag, Fixed, Bytes, Enum, Message, Special) which says how a single
+ * value is encoded, and a wrapper (Singular, Present, Repeated, Map, OneOf) which says how the field is laid out.
+ */
+namespace message::wire {
+
+    // Scalars and packed arrays are copied directly from memory
+    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "The wire format is only implemented for little endian");
+
+    /// The protobuf wire types
+    enum class WireType : uint32_t { VARINT = 0, I64 = 1, LEN = 2, I32 = 5 };
+
+    /**
+     * @brief Gets the number of bytes needed to encode the value as a varint
+     */
+    inline size_t varint_size(const uint64_t& value) {
+        // Each byte holds 7 bits, so this is ceil(bits / 7) for the number of significant bits in the value
+        return size_t((63 - __builtin_clzll(value | 1)) * 9 + 73) / 64;
+    }
+
+    /**
+     * @brief Gets the size of a length delimited payload including its length prefix
+     */
+    inline size_t len_size(const size_t& length) {
+        return varint_size(length) + length;
+    }
+
+    /**
+     * @brief Gets the size of the tag for a field number
+     */
+    inline size_t tag_size(const uint32_t& number) {
+        return varint_size(uint64_t(number) << 3);
+    }
+
+    /**
+     * @brief Writes wire format data into a buffer that has already been sized to fit it
+     */
+    class Writer {
+    public:
+        explicit Writer(uint8_t* data) : ptr(data) {}
+
+        void varint(uint64_t value) {
+            while (value >= 0x80) {
+                *ptr++ = uint8_t(value | 0x80);
+                value >>= 7;
+            }
+            *ptr++ = uint8_t(value);
+        }
+
+        void tag(const uint32_t& number, const WireType& type) {
+            varint((uint64_t(number) << 3) | uint64_t(type));
+        }
+
+        template <typename T>
+        void fixed(const T& value) {
+            std::memcpy(ptr, &value, sizeof(T));
+            ptr += sizeof(T);
+        }
+
+        void raw(const void* data, const size_t& length) {
+            if (length > 0) {
+                std::memcpy(ptr, data, length);
+                ptr += length;
+            }
+        }
+
+        [[nodiscard]] const uint8_t* position() const {
+            return ptr;
+        }
+
+    private:
+        /// The next byte to write
+        uint8_t* ptr;
+    };
+
+    /**
+     * @brief Reads wire format data, throwing if it runs off the end or finds something malformed
+     */
+    class Reader {
+    public:
+        Reader(const uint8_t* data, const size_t& length) : ptr(data), end(data + length) {}
+
+        [[nodiscard]] bool done() const {
+            return ptr == end;
+        }
+
+        uint64_t varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (ptr == end) {
+                    fail();
+                }
+                const uint8_t byte = *ptr++;
+                value |= uint64_t(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) {
+                    return value;
+                }
+            }
+            fail();
+        }
+
+        std::pair<uint32_t, WireType> tag() {
+            const uint64_t tag = varint();
+            // Field number zero is never valid
+            if ((tag >> 3) == 0 || (tag >> 3) > 0x1FFFFFFF) {
+                fail();
+            }
+            return {uint32_t(tag >> 3), WireType(tag & 0x7)};
+        }
+
+        template <typename T>
+        T fixed() {
+            need(sizeof(T));
+            T value;
+            std::memcpy(&value, ptr, sizeof(T));
+            ptr += sizeof(T);
+            return value;
+        }
+
+        /**
+         * @brief Reads a length prefix and returns the bytes it covers, moving past them
+         */
+        std::pair<const uint8_t*, size_t> bytes() {
+            const uint64_t length = varint();
+            need(length);
+            const uint8_t* data = ptr;
+            ptr += length;
+            return {data, size_t(length)};
+        }
+
+        /**
+         * @brief Reads a length delimited field and returns a reader over its payload
+         */
+        Reader sub() {
+            auto [data, length] = bytes();
+            return Reader(data, length);
+        }
+
+        void skip(const WireType& type) {
+            switch (type) {
+                case WireType::VARINT: varint(); break;
+                case WireType::I64: need(8); ptr += 8; break;
+                case WireType::LEN: bytes(); break;
+                case WireType::I32: need(4); ptr += 4; break;
+                // Groups are not supported by proto3
+                default: fail();
+            }
+        }
+
+        [[noreturn]] static void fail() {
+            throw std::runtime_error("Message failed to deserialise.");
+        }
+
+    private:
+        void need(const uint64_t& length) const {
+            if (uint64_t(end - ptr) < length) {
+                fail();
+            }
+        }
+
+        /// The next byte to read
+        const uint8_t* ptr;
+        /// One past the last byte that can be read
+        const uint8_t* end;
+    };
+
+    /// int32, int64, uint32, uint64 and bool fields
+    struct Varint {
+        static constexpr WireType type    = WireType::VARINT;
+        static constexpr bool packed      = true;
+        static constexpr size_t fixed_size = 0;
+
+        template <typename V>
+        static uint64_t encode(const V& value) {
+            // Negative numbers are sign extended to 64 bits, which makes them always take 10 bytes
+            if constexpr (std::is_signed_v<V>) {
+                return uint64_t(int64_t(value));
+            }
+            else {
+                return uint64_t(value);
+            }
+        }
+        template <typename V>
+        static bool empty(const V& value) {
+            return value == V(0);
+        }
+        template <typename V>
+        static size_t size(const V& value) {
+            return varint_size(encode(value));
+        }
+        template <typename V>
+        static void write(Writer& out, const V& value) {
+            out.varint(encode(value));
+        }
+        template <typename V>
+        static void read(Reader& in, V& value) {
+            value = V(in.varint());
+        }
+        template <typename V>
+        static V make() {
+            return V{};
+        }
+    };
+
+    /// sint32 and sint64 fields
+    struct ZigZag {
+        static constexpr WireType type    = WireType::VARINT;
+        static constexpr bool packed      = true;
+        static constexpr size_t fixed_size = 0;
+
+        template <typename V>
+        static uint64_t encode(const V& value) {
+            const auto v = int64_t(value);
+            return (uint64_t(v) << 1) ^ uint64_t(v >> 63);
+        }
+        template <typename V>
+        static bool empty(const V& value) {
+            return value == V(0);
+        }
+        template <typename V>
+        static size_t size(const V& value) {
+            return varint_size(encode(value));
+        }
+        template <typename V>
+        static void write(Writer& out, const V& value) {
+            out.varint(encode(value));
+        }
+        template <typename V>
+        static void read(Reader& in, V& value) {
+            const uint64_t v = in.varint();
+            value            = V(int64_t(v >> 1) ^ -int64_t(v & 1));
+        }
+        template <typename V>
+        static V make() {
+            return V{};
+        }
+    };
+
+    /// double, float, fixed32, fixed64, sfixed32 and sfixed64 fields, stored on the wire as a Storage
+    template <typename Storage>
+    struct Fixed {
+        static_assert(sizeof(Storage) == 4 || sizeof(Storage) == 8, "Fixed fields are either 32 or 64 bits");
+
+        using storage                     = Storage;
+        static constexpr WireType type    = sizeof(Storage) == 8 ? WireType::I64 : WireType::I32;
+        static constexpr bool packed      = true;
+        static constexpr size_t fixed_size = sizeof(Storage);
+
+        template <typename V>
+        static bool empty(const V& value) {
+            // Compare the bits so that -0.0 is still written, the same as protobuf does
+            const auto v = Storage(value);
+            std::conditional_t<sizeof(Storage) == 8, uint64_t, uint32_t> bits{};
+            std::memcpy(&bits, &v, sizeof(Storage));
+            return bits == 0;
+        }
+        template <typename V>
+        static size_t size(const V& /*value*/) {
+            return sizeof(Storage);
+        }
+        template <typename V>
+        static void write(Writer& out, const V& value) {
+            out.fixed(Storage(value));
+        }
+        template <typename V>
+        static void read(Reader& in, V& value) {
+            value = V(in.fixed<Storage>());
+        }
+        template <typename V>
+        static V make() {
+            return V{};
+        }
+    };
+
+    /// string and bytes fields
+    struct Bytes {
+        static constexpr WireType type    = WireType::LEN;
+        static constexpr bool packed      = false;
+        static constexpr size_t fixed_size = 0;
+
+        template <typename V>
+        static bool empty(const V& value) {
+            return value.empty();
+        }
+        template <typename V>
+        static size_t size(const V& value) {
+            return len_size(value.size());
+        }
+        template <typename V>
+        static void write(Writer& out, const V& value) {
+            out.varint(value.size());
+            out.raw(value.data(), value.size());
+        }
+        template <typename V>
+        static void read(Reader& in, V& value) {
+            auto [data, length] = in.bytes();
+            if constexpr (std::is_same_v<V, std::string>) {
+                value.assign(reinterpret_cast<const char*>(data), length);
+            }
+            else {
+                value.assign(data, data + length);
+            }
+        }
+        template <typename V>
+        static V make() {
+            return V{};
+        }
+    };
+
+    /// Neutron enum fields
+    struct Enum {
+        static constexpr WireType type    = WireType::VARINT;
+        static constexpr bool packed      = true;
+        static constexpr size_t fixed_size = 0;
+
+        template <typename V>
+        static bool empty(const V& value) {
+            return int(value) == 0;
+        }
+        template <typename V>
+        static size_t size(const V& value) {
+            return varint_size(uint64_t(int64_t(int(value))));
+        }
+        template <typename V>
+        static void write(Writer& out, const V& value) {
+            out.varint(uint64_t(int64_t(int(value))));
+        }
+        template <typename V>
+        static void read(Reader& in, V& value) {
+            value = V(int(in.varint()));
+        }
+        template <typename V>
+        static V make() {
+            return V{};
+        }
+    };
+
+    /// Neutron message fields, which encode themselves through their generated wire functions
+    struct Message {
+        static constexpr WireType type    = WireType::LEN;
+        static constexpr bool packed      = false;
+        static constexpr size_t fixed_size = 0;
+
+        template <typename V>
+        static size_t size(const V& value) {
+            return len_size(value.wire_size());
+        }
+        template <typename V>
+        static void write(Writer& out, const V& value) {
+            out.varint(value.wire_size());
+            value.wire_write(out);
+        }
+        template <typename V>
+        static void read(Reader& in, V& value) {
+            Reader sub = in.sub();
+            value.wire_read(sub);
+        }
+        template <typename V>
+        static V make() {
+            // Start from the same values a default protobuf message would convert to
+            return V(V::protobuf_type::default_instance());
+        }
+    };
+
+    /**
+     * @brief Encodes the body of a builtin message (vectors, matrices, timestamps, ...) directly from the Neutron type
+     *
+     * @details Specialised for each of the Neutron types in message/conversion/wire_conversion.hpp
+     */
+    template <typename T>
+    struct SpecialCodec;
+
+    /// Fields holding one of the builtin message types that Neutron converts to a native type
+    struct Special {
+        static constexpr WireType type    = WireType::LEN;
+        static constexpr bool packed      = false;
+        static constexpr size_t fixed_size = 0;
+
+        template <typename V>
+        static size_t size(const V& value) {
+            return len_size(SpecialCodec<V>::size(value));
+        }
+        template <typename V>
+        static void write(Writer& out, const V& value) {
+            out.varint(SpecialCodec<V>::size(value));
+            SpecialCodec<V>::write(out, value);
+        }
+        template <typename V>
+        static void read(Reader& in, V& value) {
+            Reader sub = in.sub();
+            value      = SpecialCodec<V>::make();
+            SpecialCodec<V>::read(sub, value);
+        }
+        template <typename V>
+        static V make() {
+            return SpecialCodec<V>::make();
+        }
+    };
+
+    /// A proto3 field with implicit presence, which is left out when it holds its default value
+    template <typename Kind>
+    struct Singular {
+        template <typename V>
+        static size_t size(const uint32_t& number, const V& value) {
+            return Kind::empty(value) ? 0 : tag_size(number) + Kind::size(value);
+        }
+        template <typename V>
+        static void write(Writer& out, const uint32_t& number, const V& value) {
+            if (!Kind::empty(value)) {
+                out.tag(number, Kind::type);
+                Kind::write(out, value);
+            }
+        }
+        template <typename V>
+        static void read(Reader& in, const WireType& type, V& value) {
+            if (type == Kind::type) {
+                Kind::read(in, value);
+            }
+            else {
+                in.skip(type);
+            }
+        }
+    };
+
+    /// A field that is always written, such as a submessage or the active member of a oneof
+    template <typename Kind>
+    struct Present {
+        template <typename V>
+        static size_t size(const uint32_t& number, const V& value) {
+            return tag_size(number) + Kind::size(value);
+        }
+        template <typename V>
+        static void write(Writer& out, const uint32_t& number, const V& value) {
+            out.tag(number, Kind::type);
+            Kind::write(out, value);
+        }
+        template <typename V>
+        static void read(Reader& in, const WireType& type, V& value) {
+            Singular<Kind>::read(in, type, value);
+        }
+    };
+
+    /// A repeated field held in a std::vector or std::array, packed when the kind allows it
+    template <typename Kind>
+    struct Repeated {
+        /// True when the container's memory is already laid out as the packed wire data
+        template <typename C>
+        static constexpr bool contiguous() {
+            if constexpr (Kind::fixed_size > 0) {
+                return std::is_same_v<typename C::value_type, typename Kind::storage>;
+            }
+            else {
+                return false;
+            }
+        }
+
+        template <typename C>
+        static size_t payload(const C& values) {
+            if constexpr (Kind::fixed_size > 0) {
+                return values.size() * Kind::fixed_size;
+            }
+            else {
+                size_t size = 0;
+                for (const auto& v : values) {
+                    size += Kind::size(v);
+                }
+                return size;
+            }
+        }
+
+        template <typename C>
+        static size_t size(const uint32_t& number, const C& values) {
+            if constexpr (Kind::packed) {
+                return values.empty() ? 0 : tag_size(number) + len_size(payload(values));
+            }
+            else {
+                size_t size = values.size() * tag_size(number);
+                for (const auto& v : values) {
+                    size += Kind::size(v);
+                }
+                return size;
+            }
+        }
+
+        template <typename C>
+        static void write(Writer& out, const uint32_t& number, const C& values) {
+            if constexpr (Kind::packed) {
+                if (!values.empty()) {
+                    out.tag(number, WireType::LEN);
+                    out.varint(payload(values));
+                    if constexpr (contiguous<C>()) {
+                        out.raw(values.data(), values.size() * Kind::fixed_size);
+                    }
+                    else {
+                        for (const auto& v : values) {
+                            Kind::write(out, v);
+                        }
+                    }
+                }
+            }
+            else {
+                for (const auto& v : values) {
+                    out.tag(number, Kind::type);
+                    Kind::write(out, v);
+                }
+            }
+        }
+
+        template <typename V>
+        static void read(Reader& in, const WireType& type, std::vector<V>& values) {
+            // Parsers must accept both packed and unpacked encodings
+            if (Kind::packed && type == WireType::LEN) {
+                if constexpr (contiguous<std::vector<V>>()) {
+                    auto [data, length] = in.bytes();
+                    if (length % Kind::fixed_size != 0) {
+                        Reader::fail();
+                    }
+                    const size_t offset = values.size();
+                    values.resize(offset + length / Kind::fixed_size);
+                    std::memcpy(values.data() + offset, data, length);
+                }
+                else {
+                    Reader sub = in.sub();
+                    while (!sub.done()) {
+                        V value = Kind::template make<V>();
+                        Kind::read(sub, value);
+                        values.push_back(std::move(value));
+                    }
+                }
+            }
+            else if (type == Kind::type) {
+                V value = Kind::template make<V>();
+                Kind::read(in, value);
+                values.push_back(std::move(value));
+            }
+            else {
+                in.skip(type);
+            }
+        }
+
+        /// Fixed size arrays keep the first N values and drop the rest, `index` counts the values seen so far
+        template <typename V, size_t N>
+        static void read(Reader& in, const WireType& type, std::array<V, N>& values, size_t& index) {
+            auto store = [&](Reader& r) {
+                V value = Kind::template make<V>();
+                Kind::read(r, value);
+                if (index < N) {
+                    values[index] = std::move(value);
+                }
+                ++index;
+            };
+
+            if (Kind::packed && type == WireType::LEN) {
+                Reader sub = in.sub();
+                while (!sub.done()) {
+                    store(sub);
+                }
+            }
+            else if (type == Kind::type) {
+                store(in);
+            }
+            else {
+                in.skip(type);
+            }
+        }
+    };
+
+    /// A map field, written as a repeated message with the key in field 1 and the value in field 2
+    template <typename KeyKind, typename ValueKind>
+    struct Map {
+        template <typename K, typename V>
+        static size_t entry_size(const K& key, const V& value) {
+            return Present<KeyKind>::size(1, key) + Present<ValueKind>::size(2, value);
+        }
+
+        template <typename M>
+        static size_t size(const uint32_t& number, const M& map) {
+            size_t size = map.size() * tag_size(number);
+            for (const auto& [key, value] : map) {
+                size += len_size(entry_size(key, value));
+            }
+            return size;
+        }
+
+        template <typename M>
+        static void write(Writer& out, const uint32_t& number, const M& map) {
+            for (const auto& [key, value] : map) {
+                out.tag(number, WireType::LEN);
+                out.varint(entry_size(key, value));
+                Present<KeyKind>::write(out, 1, key);
+                Present<ValueKind>::write(out, 2, value);
+            }
+        }
+
+        template <typename K, typename V>
+        static void read(Reader& in, const WireType& type, std::map<K, V>& map) {
+            if (type != WireType::LEN) {
+                in.skip(type);
+                return;
+            }
+
+            Reader sub = in.sub();
+            K key      = KeyKind::template make<K>();
+            V value    = ValueKind::template make<V>();
+            while (!sub.done()) {
+                const auto [number, field_type] = sub.tag();
+                switch (number) {
+                    case 1: Present<KeyKind>::read(sub, field_type, key); break;
+                    case 2: Present<ValueKind>::read(sub, field_type, value); break;
+                    default: sub.skip(field_type); break;
+                }
+            }
+            map.insert_or_assign(std::move(key), std::move(value));
+        }
+    };
+
+    /// A member of a oneof, which is written by the generated code when it is the active member
+    template <typename Kind, typename V>
+    struct OneOf {
+        template <typename Proxy>
+        static void read(Reader& in, const WireType& type, Proxy& proxy) {
+            if (type == Kind::type) {
+                V value = Kind::template make<V>();
+                Kind::read(in, value);
+                proxy = std::move(value);
+            }
+            else {
+                in.skip(type);
+            }
+        }
+    };
+
+}  // namespace message::wire
+
+#endif  // MESSAGE_WIREFORMAT_HPP
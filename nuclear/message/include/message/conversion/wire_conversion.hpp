@@ -0,0 +1,443 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MESSAGE_CONVERSION_WIRE_CONVERSION_HPP
+#define MESSAGE_CONVERSION_WIRE_CONVERSION_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <nuclear_bits/clock.hpp>
+#include <utility>
+
+#include "math_types.hpp"
+#include "message/WireFormat.hpp"
+
+/**
+ * Wire format codecs for the Neutron types that are converted from the builtin messages in Vector.proto,
+ * Matrix.proto, Transform.proto and google/protobuf/{timestamp,duration}.proto.
+ *
+ * These write the same bytes that proto_conversion.hpp followed by protobuf serialisation would, but straight from
+ * the Eigen/chrono memory.
+ */
+namespace message::wire {
+
+    namespace detail {
+
+        /// The kind used for an element of a fixed sized vector (vec2-vec16)
+        template <typename Scalar>
+        struct ElementKind {
+            using type = Fixed<Scalar>;
+        };
+        template <>
+        struct ElementKind<int> {
+            using type = ZigZag;
+        };
+        template <>
+        struct ElementKind<unsigned int> {
+            using type = Varint;
+        };
+
+        /// Size of a fixed sized vector message where element i is in field i + 1
+        template <typename Scalar>
+        inline size_t vector_size(const Scalar* data, const int& n) {
+            size_t size = 0;
+            for (int i = 0; i < n; ++i) {
+                size += Singular<typename ElementKind<Scalar>::type>::size(uint32_t(i + 1), data[i]);
+            }
+            return size;
+        }
+
+        template <typename Scalar>
+        inline void vector_write(Writer& out, const Scalar* data, const int& n) {
+            for (int i = 0; i < n; ++i) {
+                Singular<typename ElementKind<Scalar>::type>::write(out, uint32_t(i + 1), data[i]);
+            }
+        }
+
+        template <typename Scalar>
+        inline void vector_read(Reader& in, Scalar* data, const int& n) {
+            std::fill(data, data + n, Scalar(0));
+            while (!in.done()) {
+                const auto [number, type] = in.tag();
+                if (number <= uint32_t(n)) {
+                    Singular<typename ElementKind<Scalar>::type>::read(in, type, data[number - 1]);
+                }
+                else {
+                    in.skip(type);
+                }
+            }
+        }
+
+        /// Size of a fixed sized matrix message where column i is a vector message in field i + 1
+        template <typename Scalar>
+        inline size_t matrix_size(const Scalar* data, const int& rows, const int& cols) {
+            size_t size = 0;
+            for (int c = 0; c < cols; ++c) {
+                size += tag_size(uint32_t(c + 1)) + len_size(vector_size(data + c * rows, rows));
+            }
+            return size;
+        }
+
+        template <typename Scalar>
+        inline void matrix_write(Writer& out, const Scalar* data, const int& rows, const int& cols) {
+            for (int c = 0; c < cols; ++c) {
+                out.tag(uint32_t(c + 1), WireType::LEN);
+                out.varint(vector_size(data + c * rows, rows));
+                vector_write(out, data + c * rows, rows);
+            }
+        }
+
+        template <typename Scalar>
+        inline void matrix_read(Reader& in, Scalar* data, const int& rows, const int& cols) {
+            std::fill(data, data + rows * cols, Scalar(0));
+            while (!in.done()) {
+                const auto [number, type] = in.tag();
+                if (number <= uint32_t(cols) && type == WireType::LEN) {
+                    Reader column = in.sub();
+                    vector_read(column, data + (number - 1) * rows, rows);
+                }
+                else {
+                    in.skip(type);
+                }
+            }
+        }
+
+        /// Size of the packed (or bytes for uint8_t) data of a dynamic vector or matrix in field `number`
+        template <typename Scalar>
+        inline size_t packed_size(const uint32_t& number, const Eigen::Index& n) {
+            return n == 0 ? 0 : tag_size(number) + len_size(n * sizeof(Scalar));
+        }
+
+        template <typename Scalar>
+        inline void packed_write(Writer& out, const uint32_t& number, const Scalar* data, const Eigen::Index& n) {
+            if (n > 0) {
+                out.tag(number, WireType::LEN);
+                out.varint(n * sizeof(Scalar));
+                out.raw(data, n * sizeof(Scalar));
+            }
+        }
+
+        /**
+         * @brief Reads packed data into `data`, which holds `n` elements. `index` counts the elements read so far.
+         *
+         * @details A uint8_t field is a bytes field, where the last value replaces earlier ones rather than appending
+         */
+        template <typename Scalar>
+        inline void packed_read(Reader& in,
+                                const WireType& type,
+                                Scalar* data,
+                                const Eigen::Index& n,
+                                Eigen::Index& index) {
+            if (type == WireType::LEN) {
+                auto [bytes, length] = in.bytes();
+                if (length % sizeof(Scalar) != 0) {
+                    Reader::fail();
+                }
+                if constexpr (sizeof(Scalar) == 1) {
+                    index = 0;
+                }
+                const auto count = std::min(Eigen::Index(length / sizeof(Scalar)), std::max(n - index, Eigen::Index(0)));
+                if (count > 0) {
+                    std::memcpy(data + index, bytes, count * sizeof(Scalar));
+                }
+                index += Eigen::Index(length / sizeof(Scalar));
+            }
+            else if constexpr (sizeof(Scalar) != 1) {
+                // An unpacked element, which parsers have to accept
+                if (type == Fixed<Scalar>::type) {
+                    const auto value = in.fixed<Scalar>();
+                    if (index < n) {
+                        data[index] = value;
+                    }
+                    ++index;
+                }
+                else {
+                    in.skip(type);
+                }
+            }
+            else {
+                in.skip(type);
+            }
+        }
+
+        /// Counts the elements in a packed (or bytes) field without copying them
+        template <typename Scalar>
+        inline void packed_count(Reader& in, const WireType& type, Eigen::Index& count) {
+            if (type == WireType::LEN) {
+                const auto length = Eigen::Index(in.bytes().second / sizeof(Scalar));
+                count             = sizeof(Scalar) == 1 ? length : count + length;
+            }
+            else if constexpr (sizeof(Scalar) != 1) {
+                if (type == Fixed<Scalar>::type) {
+                    ++count;
+                }
+                in.skip(type);
+            }
+            else {
+                in.skip(type);
+            }
+        }
+
+        /// The protobuf timestamp/duration split into whole seconds and the remaining nanoseconds
+        template <typename Duration>
+        inline std::pair<int64_t, int32_t> split(const Duration& d) {
+            const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(d);
+            const auto nanos   = std::chrono::duration_cast<std::chrono::nanoseconds>(d - seconds);
+            return {seconds.count(), int32_t(nanos.count())};
+        }
+
+        inline size_t chrono_size(const std::pair<int64_t, int32_t>& t) {
+            return Singular<Varint>::size(1, t.first) + Singular<Varint>::size(2, t.second);
+        }
+
+        inline void chrono_write(Writer& out, const std::pair<int64_t, int32_t>& t) {
+            Singular<Varint>::write(out, 1, t.first);
+            Singular<Varint>::write(out, 2, t.second);
+        }
+
+        inline std::chrono::nanoseconds chrono_read(Reader& in) {
+            int64_t seconds = 0;
+            int32_t nanos   = 0;
+            while (!in.done()) {
+                const auto [number, type] = in.tag();
+                switch (number) {
+                    case 1: Singular<Varint>::read(in, type, seconds); break;
+                    case 2: Singular<Varint>::read(in, type, nanos); break;
+                    default: in.skip(type); break;
+                }
+            }
+            return std::chrono::seconds(seconds) + std::chrono::nanoseconds(nanos);
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Eigen vectors and matrices, both fixed (vecN/matN) and dynamic (vec/mat) sized
+     */
+    template <typename Scalar, int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+    struct SpecialCodec<Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols>> {
+        using T = Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols>;
+
+        static_assert((Options & Eigen::RowMajor) == 0 || Cols == 1, "Matrices are written column by column");
+
+        static constexpr bool dynamic = Rows == Eigen::Dynamic;
+
+        static size_t size(const T& v) {
+            if constexpr (dynamic && Cols == 1) {
+                return detail::packed_size<Scalar>(1, v.size());
+            }
+            else if constexpr (dynamic) {
+                return Singular<Varint>::size(1, uint32_t(v.rows())) + Singular<Varint>::size(2, uint32_t(v.cols()))
+                       + detail::packed_size<Scalar>(3, v.size());
+            }
+            else if constexpr (Cols == 1) {
+                return detail::vector_size(v.data(), Rows);
+            }
+            else {
+                return detail::matrix_size(v.data(), Rows, Cols);
+            }
+        }
+
+        static void write(Writer& out, const T& v) {
+            if constexpr (dynamic && Cols == 1) {
+                detail::packed_write(out, 1, v.data(), v.size());
+            }
+            else if constexpr (dynamic) {
+                Singular<Varint>::write(out, 1, uint32_t(v.rows()));
+                Singular<Varint>::write(out, 2, uint32_t(v.cols()));
+                detail::packed_write(out, 3, v.data(), v.size());
+            }
+            else if constexpr (Cols == 1) {
+                detail::vector_write(out, v.data(), Rows);
+            }
+            else {
+                detail::matrix_write(out, v.data(), Rows, Cols);
+            }
+        }
+
+        static void read(Reader& in, T& v) {
+            if constexpr (dynamic && Cols == 1) {
+                // Count the elements first so the vector is only allocated once
+                Reader count_pass = in;
+                Eigen::Index count = 0;
+                while (!count_pass.done()) {
+                    const auto [number, type] = count_pass.tag();
+                    if (number == 1) {
+                        detail::packed_count<Scalar>(count_pass, type, count);
+                    }
+                    else {
+                        count_pass.skip(type);
+                    }
+                }
+                v.resize(count);
+
+                Eigen::Index index = 0;
+                while (!in.done()) {
+                    const auto [number, type] = in.tag();
+                    if (number == 1) {
+                        detail::packed_read(in, type, v.data(), v.size(), index);
+                    }
+                    else {
+                        in.skip(type);
+                    }
+                }
+            }
+            else if constexpr (dynamic) {
+                // The shape can come after the data so read it first
+                Reader shape_pass = in;
+                uint32_t rows     = 0;
+                uint32_t cols     = 0;
+                while (!shape_pass.done()) {
+                    const auto [number, type] = shape_pass.tag();
+                    switch (number) {
+                        case 1: Singular<Varint>::read(shape_pass, type, rows); break;
+                        case 2: Singular<Varint>::read(shape_pass, type, cols); break;
+                        default: shape_pass.skip(type); break;
+                    }
+                }
+                v = T::Zero(rows, cols);
+
+                Eigen::Index index = 0;
+                while (!in.done()) {
+                    const auto [number, type] = in.tag();
+                    if (number == 3) {
+                        detail::packed_read(in, type, v.data(), v.size(), index);
+                    }
+                    else {
+                        in.skip(type);
+                    }
+                }
+            }
+            else if constexpr (Cols == 1) {
+                detail::vector_read(in, v.data(), Rows);
+            }
+            else {
+                detail::matrix_read(in, v.data(), Rows, Cols);
+            }
+        }
+
+        static T make() {
+            if constexpr (dynamic) {
+                return T{};
+            }
+            else {
+                return T::Zero();
+            }
+        }
+    };
+
+    /**
+     * @brief Eigen isometries, written as their full homogeneous matrix (iso2/iso3)
+     */
+    template <typename Scalar, int Dim, int Mode, int Options>
+    struct SpecialCodec<Eigen::Transform<Scalar, Dim, Mode, Options>> {
+        using T = Eigen::Transform<Scalar, Dim, Mode, Options>;
+
+        static constexpr int N = Dim + 1;
+
+        static size_t size(const T& v) {
+            return detail::matrix_size(v.matrix().data(), N, N);
+        }
+        static void write(Writer& out, const T& v) {
+            detail::matrix_write(out, v.matrix().data(), N, N);
+        }
+        static void read(Reader& in, T& v) {
+            detail::matrix_read(in, v.matrix().data(), N, N);
+        }
+        static T make() {
+            T v;
+            v.matrix().setZero();
+            return v;
+        }
+    };
+
+    /**
+     * @brief Eigen quaternions, whose coefficients are stored in the same x, y, z, w order as quat/fquat
+     */
+    template <typename Scalar, int Options>
+    struct SpecialCodec<Eigen::Quaternion<Scalar, Options>> {
+        using T = Eigen::Quaternion<Scalar, Options>;
+
+        static size_t size(const T& v) {
+            return detail::vector_size(v.coeffs().data(), 4);
+        }
+        static void write(Writer& out, const T& v) {
+            detail::vector_write(out, v.coeffs().data(), 4);
+        }
+        static void read(Reader& in, T& v) {
+            detail::vector_read(in, v.coeffs().data(), 4);
+        }
+        static T make() {
+            return T(Scalar(0), Scalar(0), Scalar(0), Scalar(0));
+        }
+    };
+
+    /**
+     * @brief google.protobuf.Timestamp
+     */
+    template <>
+    struct SpecialCodec<NUClear::clock::time_point> {
+        using T = NUClear::clock::time_point;
+
+        static size_t size(const T& v) {
+            return detail::chrono_size(detail::split(v.time_since_epoch()));
+        }
+        static void write(Writer& out, const T& v) {
+            detail::chrono_write(out, detail::split(v.time_since_epoch()));
+        }
+        static void read(Reader& in, T& v) {
+            v = T(std::chrono::duration_cast<NUClear::clock::duration>(detail::chrono_read(in)));
+        }
+        static T make() {
+            return T{};
+        }
+    };
+
+    /**
+     * @brief google.protobuf.Duration
+     */
+    template <>
+    struct SpecialCodec<NUClear::clock::duration> {
+        using T = NUClear::clock::duration;
+
+        static size_t size(const T& v) {
+            return detail::chrono_size(detail::split(v));
+        }
+        static void write(Writer& out, const T& v) {
+            detail::chrono_write(out, detail::split(v));
+        }
+        static void read(Reader& in, T& v) {
+            v = std::chrono::duration_cast<T>(detail::chrono_read(in));
+        }
+        static T make() {
+            return T{};
+        }
+    };
+
+}  // namespace message::wire
+
+#endif  // MESSAGE_CONVERSION_WIRE_CONVERSION_HPP
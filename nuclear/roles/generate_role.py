@@ -43,6 +43,7 @@ role_modules = sys.argv[4:]
 with open(role_name, "w", encoding="utf-8") as role_file:
 
     # We use our NUClear header
+    role_file.write("#include <cstdlib>\n")
     role_file.write("#include <nuclear>\n\n")
 
     # Add our module headers
@@ -103,6 +104,11 @@ with open(role_name, "w", encoding="utf-8") as role_file:
     unsigned int nThreads = std::thread::hardware_concurrency() + 2;
     config.thread_count = nThreads >= 4 ? nThreads : 4;
 
+    // NUCLEAR_THREADS overrides the number of pool threads, e.g. a single thread for runs that must repeat exactly
+    if (const char* threads = std::getenv("NUCLEAR_THREADS"); threads != nullptr && std::atoi(threads) > 0) {
+        config.thread_count = std::atoi(threads);
+    }
+
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
     NUClear::PowerPlant plant(config, argc, const_cast<const char**>(argv));"""
 
@@ -934,3 +934,56 @@ SCENARIO("Conversion from protobuf message to Neutron is consistent", "[nuclear]
         }
     }
 }
+
+SCENARIO("Direct wire serialisation matches protobuf serialisation", "[nuclear][message][wire]") {
+    using Serialise = NUClear::util::serialise::Serialise<MessageTest>;
+
+    GIVEN("A neutron message with every kind of field set") {
+        MessageTest msg = construct_message(NUClear::clock::now());
+
+        // Populate the composite fields
+        MessageTest::Nested nested;
+        nested.value  = -3;
+        nested.points = {Eigen::Vector3d(1.0, 2.0, 3.0), Eigen::Vector3d(-0.0, 0.0, 5.0)};
+
+        msg.colour   = MessageTest::Colour::BLUE;
+        msg.nested   = nested;
+        msg.children = {nested, MessageTest::Nested(), nested};
+        msg.doubles  = {1.5, -0.0, 0.0, 3.25};
+        msg.sints    = {-1, 0, 1, -300, 300};
+        msg.strings  = {"", "a", "bcd"};
+        msg.colours  = {MessageTest::Colour::RED, MessageTest::Colour::GREEN, MessageTest::Colour::BLUE};
+        msg.fixed3   = {1, 0, 3};
+        // Protobuf doesn't write maps in a fixed order, so only use one entry
+        msg.named["one"] = nested;
+
+        WHEN("it is serialised") {
+            const std::vector<uint8_t> bytes = Serialise::serialise(msg);
+
+            THEN("the bytes are the same as serialising the protobuf message") {
+                const std::string expected = PbMessageTest(msg).SerializeAsString();
+                REQUIRE(std::string(bytes.begin(), bytes.end()) == expected);
+            }
+
+            THEN("deserialising gives back the same message") {
+                REQUIRE(Serialise::deserialise(bytes) == msg);
+            }
+
+            THEN("deserialising gives the same message as parsing it with protobuf") {
+                PbMessageTest pb_msg;
+                REQUIRE(pb_msg.ParseFromArray(bytes.data(), int(bytes.size())));
+                REQUIRE(Serialise::deserialise(bytes) == MessageTest(pb_msg));
+            }
+
+            THEN("deserialising truncated data throws") {
+                REQUIRE_THROWS(Serialise::deserialise(bytes.data(), bytes.size() - 1));
+            }
+        }
+    }
+
+    GIVEN("An empty buffer") {
+        THEN("deserialising gives the same message as an empty protobuf message") {
+            REQUIRE(Serialise::deserialise(nullptr, 0) == MessageTest(PbMessageTest()));
+        }
+    }
+}
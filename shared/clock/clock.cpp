@@ -29,6 +29,7 @@
 
 #include <array>
 #include <chrono>
+#include <memory>
 
 namespace utility::clock {
 
@@ -70,6 +71,29 @@ namespace utility::clock {
         active = n;
     }
 
+    void set_time(const NUClear::clock::time_point& time, const double& rtf) {
+
+        // Same circular buffer update as update_rtf, but the epoch is the given time rather than where we got to
+        int c = active;
+        int n = (c + 1) % data.size();
+
+        data[n].epoch       = time;
+        data[n].last_update = NUClear::base_clock::now();
+        data[n].rtf         = rtf;
+
+        active = n;
+    }
+
+    void set_time(NUClear::PowerPlant& powerplant, const NUClear::clock::time_point& time, const double& rtf) {
+        set_time(time, rtf);
+
+        // A task that is already due wakes the chrono controller, which then checks every timer against the new time
+        powerplant.emit<NUClear::dsl::word::emit::Direct>(std::make_unique<NUClear::dsl::operation::ChronoTask>(
+            [](NUClear::clock::time_point& /*time*/) { return false; },
+            time,
+            0));
+    }
+
 }  // namespace utility::clock
 
 namespace NUClear {
@@ -32,6 +32,31 @@
 namespace utility::clock {
     // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
     void update_rtf(const double& rtf);
+
+    /**
+     * @brief Moves the clock to time and lets it run on from there at rtf
+     *
+     * An rtf of 0 holds the clock at time until it is next set, which lets a simulator step a virtual clock forward
+     * at its own pace.
+     *
+     * @param time the time the clock should read now
+     * @param rtf  the real time factor the clock runs at from time
+     */
+    void set_time(const NUClear::clock::time_point& time, const double& rtf);
+
+    /**
+     * @brief Moves the clock like set_time, and wakes NUClear's chrono controller so that timers such as Every and
+     * Watchdog that are due by the new time run straight away
+     *
+     * The chrono controller sleeps for however long its next timer was away when it last looked, measured in real
+     * time. When the clock is moved by hand, and especially when it is held still, it would otherwise not notice the
+     * new time until that sleep ran out.
+     *
+     * @param powerplant the powerplant whose chrono controller should check its timers
+     * @param time       the time the clock should read now
+     * @param rtf        the real time factor the clock runs at from time
+     */
+    void set_time(NUClear::PowerPlant& powerplant, const NUClear::clock::time_point& time, const double& rtf);
     extern double custom_rtf;  // Real time factor
 }  // namespace utility::clock
 
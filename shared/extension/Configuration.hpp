@@ -30,9 +30,15 @@
 
 #include <cstdlib>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
 #include <nuclear>
 #include <regex>
+#include <string>
 #include <utility>
+#include <vector>
 #include <yaml-cpp/yaml.h>
 
 #include "FileWatch.hpp"
@@ -83,48 +89,21 @@ namespace extension {
                       const std::string& binary,
                       const std::string& platform)
             : fileName(fileName), hostname(hostname), binary(binary), platform(platform) {
-            bool loaded = false;
 
-            // Load the default config file.
-            if (fs::exists(fs::path("config") / fileName)) {
-                config = YAML::LoadFile(fs::path("config") / fileName);
-                loaded = true;
+            // The layers in order from least to most specific, later layers are merged over the earlier ones
+            std::vector<fs::path> layers;
+            layers.push_back(fs::path("config") / fileName);
+            if (!platform.empty()) {
+                layers.push_back(fs::path("config") / platform / fileName);
             }
-
-            // If the same file exists in this platform's per-platform config directory then load and merge
-            if (fs::exists(fs::path("config") / platform / fileName) && !platform.empty()) {
-                if (loaded) {
-                    config = merge_yaml_nodes(config, YAML::LoadFile(fs::path("config") / platform / fileName));
-                }
-
-                else {
-                    config = YAML::LoadFile(fs::path("config") / platform / fileName);
-                    loaded = true;
-                }
+            if (!hostname.empty()) {
+                layers.push_back(fs::path("config") / hostname / fileName);
             }
-
-            // If the same file exists in this robots per-robot config directory then load and merge.
-            if (fs::exists(fs::path("config") / hostname / fileName)) {
-                if (loaded) {
-                    config = merge_yaml_nodes(config, YAML::LoadFile(fs::path("config") / hostname / fileName));
-                }
-
-                else {
-                    config = YAML::LoadFile(fs::path("config") / hostname / fileName);
-                    loaded = true;
-                }
+            if (!binary.empty()) {
+                layers.push_back(fs::path("config") / binary / fileName);
             }
 
-            // If the same file exists in this binary's per-binary config directory then load and merge.
-            if (fs::exists(fs::path("config") / binary / fileName)) {
-                if (loaded) {
-                    config = merge_yaml_nodes(config, YAML::LoadFile(fs::path("config") / binary / fileName));
-                }
-
-                else {
-                    config = YAML::LoadFile(fs::path("config") / binary / fileName);
-                }
-            }
+            config = load_layers(layers);
         }
 
         [[nodiscard]] static YAML::Node merge_yaml_nodes(const YAML::Node& base, const YAML::Node& override) {
@@ -197,6 +176,105 @@ namespace extension {
             return "";
         }
 
+    private:
+        /// A parsed configuration file along with the hash of the content it was parsed from
+        struct Layer {
+            std::size_t hash = 0;
+            YAML::Node node{};
+        };
+
+        /// The result of merging a list of layers, along with the hashes of the layers that made it
+        struct Merged {
+            std::vector<std::size_t> hashes{};
+            YAML::Node node{};
+        };
+
+        /// Process wide cache of parsed and merged configuration files so that modules which share a file, or
+        /// reloads where only one layer has changed, don't have to reparse and remerge every layer
+        struct Cache {
+            std::mutex mutex{};
+            /// The most recently parsed version of each file we have loaded
+            std::map<fs::path, Layer> layers{};
+            /// The most recent merge of each list of layers we have loaded
+            std::map<std::vector<fs::path>, Merged> merged{};
+        };
+
+        [[nodiscard]] static Cache& cache() {
+            static Cache instance;
+            return instance;
+        }
+
+        /**
+         * Gets the parsed content of a file, only parsing it again if its content has changed since it was last parsed.
+         * Must be called while holding the cache mutex.
+         *
+         * @param path the path of the yaml file to load
+         *
+         * @return the layer for this file which must not be modified
+         *
+         * @throws YAML::ParserException if the file is not valid yaml
+         */
+        [[nodiscard]] static const Layer& load_layer(const fs::path& path) {
+            std::ifstream ifs(path, std::ios::binary);
+            std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+            std::size_t hash = std::hash<std::string>()(content);
+
+            auto& layers = cache().layers;
+            auto it      = layers.find(path);
+            if (it == layers.end() || it->second.hash != hash) {
+                // Parse before touching the cache so a bad file doesn't leave a broken layer behind
+                YAML::Node node = YAML::Load(content);
+                it              = layers.insert_or_assign(path, Layer{hash, node}).first;
+            }
+            return it->second;
+        }
+
+        /**
+         * Loads and merges a list of configuration files. Files that don't exist are skipped, and only files whose
+         * content has changed are reparsed.
+         *
+         * @param paths the paths of the layers to load in order from least to most specific
+         *
+         * @return a node with the merged configuration that is owned by the caller
+         *
+         * @throws YAML::ParserException if any of the files are not valid yaml
+         */
+        [[nodiscard]] static YAML::Node load_layers(const std::vector<fs::path>& paths) {
+            std::lock_guard<std::mutex> lock(cache().mutex);
+
+            std::vector<fs::path> existing;
+            std::vector<const Layer*> layers;
+            std::vector<std::size_t> hashes;
+            for (const auto& path : paths) {
+                if (fs::exists(path)) {
+                    existing.push_back(path);
+                    layers.push_back(&load_layer(path));
+                    hashes.push_back(layers.back()->hash);
+                }
+            }
+
+            if (layers.empty()) {
+                return YAML::Node();
+            }
+
+            // If none of the layers have changed since we last merged them we can reuse the result
+            auto& merged = cache().merged[existing];
+            if (merged.hashes != hashes) {
+                // Nodes are references into shared memory, and merging modifies the base node, so we merge copies to
+                // keep the cached layers intact
+                YAML::Node node = YAML::Clone(layers.front()->node);
+                for (auto it = std::next(layers.begin()); it != layers.end(); ++it) {
+                    node = merge_yaml_nodes(node, YAML::Clone((*it)->node));
+                }
+                merged.hashes = std::move(hashes);
+                merged.node   = node;
+            }
+
+            // Give the caller their own copy so changes they make can't leak into the cache
+            return YAML::Clone(merged.node);
+        }
+
+    public:
         [[nodiscard]] Configuration operator[](const std::string& key) {
             return Configuration(fileName, hostname, binary, platform, config[key]);
         }
@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <nuclear>
+#include <thread>
+#include <vector>
+
+#include "clock/clock.hpp"
+
+namespace {
+
+    /// What the ticker reactor has seen, shared with the test body
+    struct {
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool started = false;
+        int ticks    = 0;
+    } state;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    class Ticker : public NUClear::Reactor {
+    public:
+        explicit Ticker(std::unique_ptr<NUClear::Environment> environment) : Reactor(std::move(environment)) {
+            on<Startup>().then([] {
+                const std::lock_guard<std::mutex> lock(state.mutex);
+                state.started = true;
+                state.changed.notify_all();
+            });
+
+            on<Every<1, std::chrono::seconds>>().then([] {
+                const std::lock_guard<std::mutex> lock(state.mutex);
+                ++state.ticks;
+                state.changed.notify_all();
+            });
+        }
+    };
+
+}  // namespace
+
+TEST_CASE("Stepping a held clock fires Every reactions at each step", "[clock]") {
+    // Hold the clock still before the Every reaction is bound so its first tick is one second from here
+    const auto start = NUClear::clock::now();
+    utility::clock::set_time(start, 0.0);
+
+    NUClear::Configuration config;
+    config.thread_count = 2;
+    NUClear::PowerPlant plant(config);
+    plant.install<Ticker>();
+    std::thread runner([&plant] { plant.start(); });
+
+    // Each step should fire the reaction long before the chrono controller's one second real time sleep runs out
+    std::vector<int> ticks;
+    /* Mutex Scope */ {
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.changed.wait_for(lock, std::chrono::seconds(5), [] { return state.started; });
+    }
+    for (int step = 1; step <= 5; ++step) {
+        utility::clock::set_time(plant, start + std::chrono::seconds(step), 0.0);
+
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.changed.wait_for(lock, std::chrono::milliseconds(500), [step] { return state.ticks >= step; });
+        ticks.push_back(state.ticks);
+    }
+
+    plant.shutdown();
+    runner.join();
+
+    // Let the clock run in real time again for the other tests
+    utility::clock::set_time(NUClear::base_clock::now(), 1.0);
+
+    REQUIRE(ticks == std::vector<int>{1, 2, 3, 4, 5});
+}
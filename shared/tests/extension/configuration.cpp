@@ -0,0 +1,129 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "extension/Configuration.hpp"
+
+using extension::Configuration;
+
+namespace {
+
+    namespace fs = std::filesystem;
+
+    /// Runs the tests from inside an empty directory so the configuration files they write are the only ones found
+    class ConfigDirectory {
+    public:
+        explicit ConfigDirectory(const std::string& name)
+            : previous(fs::current_path()), root(fs::temp_directory_path() / "configuration_test" / name) {
+            fs::remove_all(root);
+            fs::create_directories(root / "config" / "robot");
+            fs::current_path(root);
+        }
+        ~ConfigDirectory() {
+            fs::current_path(previous);
+            fs::remove_all(root);
+        }
+        ConfigDirectory(const ConfigDirectory&)            = delete;
+        ConfigDirectory& operator=(const ConfigDirectory&) = delete;
+
+    private:
+        fs::path previous;
+        fs::path root;
+    };
+
+    /// Writes a configuration file and gives it the requested modification time
+    void write(const fs::path& path, const std::string& content, const fs::file_time_type& mtime) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+        fs::last_write_time(path, mtime);
+    }
+
+    int value(const std::string& file, const std::string& hostname = "") {
+        return Configuration(file, hostname, "", "")["value"].as<int>();
+    }
+
+}  // namespace
+
+TEST_CASE("Configuration files that keep their modification time and size are still read again",
+          "[extension][configuration]") {
+    ConfigDirectory dir("same_stat");
+    const fs::path path = fs::path("config") / "Same.yaml";
+    const auto mtime    = fs::file_time_type::clock::now() - std::chrono::hours(1);
+
+    write(path, "value: 1", mtime);
+    REQUIRE(value("Same.yaml") == 1);
+
+    // Same size and modification time, as happens with coarse timestamps or copies that preserve them
+    write(path, "value: 2", mtime);
+    REQUIRE(value("Same.yaml") == 2);
+}
+
+TEST_CASE("Configuration files are loaded again when their content changes", "[extension][configuration]") {
+    ConfigDirectory dir("invalidation");
+    const fs::path path = fs::path("config") / "Changed.yaml";
+    const auto mtime    = fs::file_time_type::clock::now() - std::chrono::hours(1);
+
+    write(path, "value: 1", mtime);
+    REQUIRE(value("Changed.yaml") == 1);
+
+    // Same size but a new modification time
+    write(path, "value: 2", mtime + std::chrono::seconds(1));
+    REQUIRE(value("Changed.yaml") == 2);
+
+    // Same modification time but a new size
+    write(path, "value: 30", mtime + std::chrono::seconds(1));
+    REQUIRE(value("Changed.yaml") == 30);
+
+    // Touched without changing the content
+    write(path, "value: 30", mtime + std::chrono::seconds(2));
+    REQUIRE(value("Changed.yaml") == 30);
+}
+
+TEST_CASE("Merged configuration is rebuilt when only one of its layers changes", "[extension][configuration]") {
+    ConfigDirectory dir("merged");
+    const fs::path base  = fs::path("config") / "Merged.yaml";
+    const fs::path robot = fs::path("config") / "robot" / "Merged.yaml";
+    const auto mtime     = fs::file_time_type::clock::now() - std::chrono::hours(1);
+
+    write(base, "value: 1\nother: 5", mtime);
+    write(robot, "value: 2", mtime);
+    REQUIRE(value("Merged.yaml", "robot") == 2);
+    REQUIRE(Configuration("Merged.yaml", "robot", "", "")["other"].as<int>() == 5);
+
+    write(robot, "value: 3", mtime + std::chrono::seconds(1));
+    REQUIRE(value("Merged.yaml", "robot") == 3);
+    REQUIRE(value("Merged.yaml") == 1);
+
+    // Changing the result we were given must not leak into the cache
+    auto config            = Configuration("Merged.yaml", "robot", "", "");
+    config.config["value"] = 4;
+    REQUIRE(value("Merged.yaml", "robot") == 3);
+}
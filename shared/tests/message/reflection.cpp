@@ -0,0 +1,134 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <nuclear>
+
+#include "message/input/Image.hpp"
+#include "message/input/Sensors.hpp"
+#include "message/reflection.hpp"
+#include "message/vision/VisualMesh.hpp"
+
+#include "utility/nbs/Encoder.hpp"
+#include "utility/nbs/Index.hpp"
+#include "utility/type_traits/has_id.hpp"
+
+namespace {
+
+    template <typename T>
+    struct HashReflector;
+
+    template <>
+    struct HashReflector<void> {  // NOLINT(cppcoreguidelines-special-member-functions)
+        virtual uint64_t hash() = 0;
+        virtual ~HashReflector() = default;
+    };
+
+    template <typename T>
+    struct HashReflector : public HashReflector<void> {
+        uint64_t hash() override {
+            return NUClear::util::serialise::Serialise<T>::hash();
+        }
+    };
+
+    /// Writes an nbs file with a mix of message types, the way a camera and sensor recording would look
+    std::filesystem::path make_recording() {
+        auto path = std::filesystem::temp_directory_path() / "reflection_test.nbs";
+        std::filesystem::remove(path);
+        std::filesystem::remove(path.string() + ".idx");
+
+        utility::nbs::Encoder encoder(path);
+        auto time = NUClear::clock::now();
+        for (int i = 0; i < 2000; ++i) {
+            time += std::chrono::milliseconds(10);
+
+            message::input::Sensors sensors;
+            sensors.timestamp = time;
+            encoder.write(sensors, time);
+
+            if (i % 3 == 0) {
+                message::input::Image image;
+                image.id        = i % 2;
+                image.timestamp = time;
+                encoder.write(image, time);
+
+                message::vision::VisualMesh mesh;
+                mesh.id        = i % 2;
+                mesh.timestamp = time;
+                encoder.write(mesh, time);
+            }
+        }
+        encoder.close();
+
+        return path;
+    }
+
+}  // namespace
+
+TEST_CASE("Reflection finds the message type for every packet in an index", "[message][reflection]") {
+    const utility::nbs::Index index({make_recording()});
+
+    REQUIRE(index.begin() != index.end());
+    for (const auto& item : index) {
+        REQUIRE(message::reflection::from_hash<HashReflector>(item.type).hash() == item.type);
+    }
+
+    // Every lookup of the same type gives back the same reflector
+    const uint64_t sensors = NUClear::util::serialise::Serialise<message::input::Sensors>::hash();
+    REQUIRE(&message::reflection::from_hash<HashReflector>(sensors)
+            == &message::reflection::from_hash<HashReflector>(sensors));
+
+    REQUIRE(message::reflection::trait_from_hash<utility::type_traits::has_id>(
+        NUClear::util::serialise::Serialise<message::input::Image>::hash()));
+    REQUIRE_FALSE(message::reflection::trait_from_hash<utility::type_traits::has_id>(sensors));
+
+    REQUIRE_THROWS_AS(message::reflection::from_hash<HashReflector>(sensors + 1), utility::reflection::unknown_message);
+    REQUIRE_THROWS_AS(message::reflection::trait_from_hash<utility::type_traits::has_id>(0),
+                      utility::reflection::unknown_message);
+}
+
+TEST_CASE("Benchmark reflection lookups over an index", "[message][reflection][!benchmark]") {
+    const utility::nbs::Index index({make_recording()});
+
+    BENCHMARK("from_hash per packet") {
+        uint64_t total = 0;
+        for (const auto& item : index) {
+            total += message::reflection::from_hash<HashReflector>(item.type).hash();
+        }
+        return total;
+    };
+
+    BENCHMARK("trait_from_hash per packet") {
+        int total = 0;
+        for (const auto& item : index) {
+            total += message::reflection::trait_from_hash<utility::type_traits::has_id>(item.type) ? 1 : 0;
+        }
+        return total;
+    };
+}
@@ -0,0 +1,189 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <nuclear>
+#include <vector>
+
+#include "message/input/Image.hpp"
+#include "message/input/Sensors.hpp"
+#include "message/vision/VisualMesh.hpp"
+
+using message::input::Image;
+using message::input::Sensors;
+using message::vision::VisualMesh;
+
+namespace {
+
+    /// Serialise by converting to the protobuf class first, the way messages were serialised before
+    template <typename T>
+    std::vector<uint8_t> protobuf_serialise(const T& msg) {
+        typename T::protobuf_type proto = msg;
+        std::vector<uint8_t> output(proto.ByteSizeLong());
+        proto.SerializeToArray(output.data(), int(output.size()));
+        return output;
+    }
+
+    /// Deserialise by parsing into the protobuf class and converting, the way messages were deserialised before
+    template <typename T>
+    T protobuf_deserialise(const std::vector<uint8_t>& data) {
+        typename T::protobuf_type proto;
+        proto.ParseFromArray(data.data(), int(data.size()));
+        return T(proto);
+    }
+
+    Image make_image() {
+        Image msg;
+        msg.format     = 0x31384752;  // RGGB bayer
+        msg.dimensions = Eigen::Matrix<unsigned int, 2, 1>(1280, 1024);
+        msg.data.resize(1280 * 1024);
+        for (size_t i = 0; i < msg.data.size(); ++i) {
+            msg.data[i] = uint8_t(i * 31);
+        }
+        msg.id                = 1;
+        msg.name              = "left";
+        msg.timestamp         = NUClear::clock::now();
+        msg.Hcw               = Eigen::Isometry3d(Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitZ()));
+        msg.Hcw.translation() = Eigen::Vector3d(0.1, -0.2, 0.5);
+        msg.lens.projection   = Image::Lens::Projection::EQUISOLID;
+        msg.lens.focal_length = 0.35f;
+        msg.lens.fov          = 3.14f;
+        msg.lens.centre       = Eigen::Vector2f(0.01f, -0.02f);
+        msg.lens.k            = Eigen::Vector2f(0.1f, 0.05f);
+        return msg;
+    }
+
+    Sensors make_sensors() {
+        Sensors msg;
+        msg.timestamp     = NUClear::clock::now();
+        msg.accelerometer = Eigen::Vector3d(0.1, 0.2, 9.8);
+        msg.gyroscope     = Eigen::Vector3d(0.01, -0.02, 0.03);
+        for (auto& foot : msg.feet) {
+            foot.down = true;
+            foot.Hwf  = Eigen::Isometry3d(Eigen::Translation3d(0.0, 0.055, 0.0));
+        }
+        for (uint32_t i = 0; i < 20; ++i) {
+            Sensors::Servo servo;
+            servo.id               = i;
+            servo.enabled          = true;
+            servo.p_gain           = 32.0f;
+            servo.goal_position    = 0.01f * float(i);
+            servo.present_position = 0.01f * float(i) + 0.001f;
+            servo.present_velocity = -0.5f;
+            servo.load             = 0.2f;
+            servo.voltage          = 12.1f;
+            servo.temperature      = 41.0f;
+            msg.servo.push_back(servo);
+        }
+        msg.voltage        = 12.1f;
+        msg.battery        = 0.9f;
+        msg.rMTt           = Eigen::Vector3d(0.0, 0.0, 0.45);
+        msg.inertia_tensor = Eigen::Matrix3d::Identity();
+        for (auto& Htx : msg.Htx) {
+            Htx = Eigen::Matrix4d::Random();
+        }
+        msg.Hrw = Eigen::Isometry3d::Identity();
+        msg.Htw = Eigen::Isometry3d::Identity();
+        msg.vTw = Eigen::Vector3d(0.2, 0.0, 0.0);
+        return msg;
+    }
+
+    VisualMesh make_mesh() {
+        constexpr int n = 20000;
+        VisualMesh msg;
+        msg.timestamp       = NUClear::clock::now();
+        msg.id              = 1;
+        msg.name            = "left";
+        msg.Hcw             = Eigen::Isometry3d::Identity();
+        msg.coordinates     = Eigen::MatrixXf::Random(2, n);
+        msg.neighbourhood   = Eigen::MatrixXi::Random(7, n);
+        msg.classifications = Eigen::MatrixXf::Random(4, n);
+        msg.rPWw            = Eigen::MatrixXf::Random(3, n);
+        msg.uPCw            = Eigen::MatrixXf::Random(3, n);
+        msg.indices.resize(n);
+        for (int i = 0; i < n; ++i) {
+            msg.indices[i] = i;
+        }
+        // A single entry keeps the byte comparison independent of protobuf's map iteration order
+        msg.class_map["ball"] = 0;
+        return msg;
+    }
+
+    template <typename T>
+    void check_bytes(const T& msg) {
+        const auto direct = NUClear::util::serialise::Serialise<T>::serialise(msg);
+        REQUIRE(direct == protobuf_serialise(msg));
+
+        const auto round_trip = NUClear::util::serialise::Serialise<T>::deserialise(direct);
+        REQUIRE(NUClear::util::serialise::Serialise<T>::serialise(round_trip) == direct);
+    }
+
+    template <typename T>
+    void benchmark(const T& msg) {
+        const auto data = protobuf_serialise(msg);
+
+        BENCHMARK("protobuf serialise") {
+            return protobuf_serialise(msg);
+        };
+        BENCHMARK("direct serialise") {
+            return NUClear::util::serialise::Serialise<T>::serialise(msg);
+        };
+        BENCHMARK("protobuf deserialise") {
+            return protobuf_deserialise<T>(data);
+        };
+        BENCHMARK("direct deserialise") {
+            return NUClear::util::serialise::Serialise<T>::deserialise(data);
+        };
+    }
+
+}  // namespace
+
+TEST_CASE("Direct serialisation produces the same bytes as protobuf", "[message][serialise]") {
+    SECTION("Image") {
+        check_bytes(make_image());
+    }
+    SECTION("Sensors") {
+        check_bytes(make_sensors());
+    }
+    SECTION("VisualMesh") {
+        check_bytes(make_mesh());
+    }
+}
+
+TEST_CASE("Benchmark direct serialisation against protobuf", "[message][serialise][!benchmark]") {
+    SECTION("Image") {
+        benchmark(make_image());
+    }
+    SECTION("Sensors") {
+        benchmark(make_sensors());
+    }
+    SECTION("VisualMesh") {
+        benchmark(make_mesh());
+    }
+}
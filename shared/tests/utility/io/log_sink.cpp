@@ -0,0 +1,172 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utility/io/LogSink.hpp"
+
+using utility::io::LogSink;
+
+namespace {
+
+    std::filesystem::path temp_log(const std::string& name) {
+        auto dir = std::filesystem::temp_directory_path() / "log_sink_test";
+        std::filesystem::create_directories(dir);
+        for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+            if (entry.path().filename().string().rfind(name, 0) == 0) {
+                std::filesystem::remove(entry.path());
+            }
+        }
+        return dir / name;
+    }
+
+    std::vector<std::string> read_lines(const std::filesystem::path& path) {
+        std::vector<std::string> lines;
+        std::ifstream input(path);
+        for (std::string line; std::getline(input, line);) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+}  // namespace
+
+TEST_CASE("LogSink writes every record in order", "[utility][io][LogSink]") {
+    const auto path = temp_log("ordered");
+    {
+        LogSink sink(path.string(), LogSink::Config());
+        for (int i = 0; i < 1000; ++i) {
+            REQUIRE(sink.write(fmt::format("line {}\n", i), i % 100 == 0));
+        }
+    }
+
+    const auto lines = read_lines(path);
+    REQUIRE(lines.size() == 1000);
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(lines[i] == fmt::format("line {}", i));
+    }
+}
+
+TEST_CASE("LogSink rotates the file once it gets too large", "[utility][io][LogSink]") {
+    const auto path = temp_log("rotated");
+
+    LogSink::Config config;
+    config.max_file_size = 200;
+    config.max_files     = 1000;
+    {
+        LogSink sink(path.string(), config);
+        for (int i = 0; i < 500; ++i) {
+            // Give the writer time to write each group as its own batch so we rotate many times
+            sink.write(fmt::format("line {}\n", i), i % 50 == 49);
+            if (i % 50 == 49) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+        }
+    }
+
+    // Stitch the rotated files back together from oldest to newest
+    std::vector<std::string> lines;
+    int n_files = 0;
+    for (int i = config.max_files; i > 0; --i) {
+        const auto rotated = fmt::format("{}.{}", path.string(), i);
+        if (std::filesystem::exists(rotated)) {
+            auto part = read_lines(rotated);
+            lines.insert(lines.end(), part.begin(), part.end());
+            ++n_files;
+        }
+    }
+    auto part = read_lines(path);
+    lines.insert(lines.end(), part.begin(), part.end());
+
+    REQUIRE(n_files >= 5);
+    REQUIRE(lines.size() == 500);
+    for (int i = 0; i < 500; ++i) {
+        REQUIRE(lines[i] == fmt::format("line {}", i));
+    }
+}
+
+TEST_CASE("LogSink counts the records it drops when the queue is full", "[utility][io][LogSink]") {
+    const auto path = temp_log("dropped");
+
+    LogSink::Config config;
+    config.queue_size   = 4;
+    config.flush_period = std::chrono::seconds(10);
+
+    uint64_t dropped = 0;
+    {
+        LogSink sink(path.string(), config);
+        for (int i = 0; i < 10000; ++i) {
+            sink.write(fmt::format("line {}\n", i));
+        }
+        dropped = sink.dropped();
+    }
+
+    // Every record either made it to the file or was counted as dropped, and the drops are noted in the log
+    uint64_t written = 0;
+    uint64_t noted   = 0;
+    for (const auto& line : read_lines(path)) {
+        uint64_t n = 0;
+        if (std::sscanf(line.c_str(), "LogSink dropped %lu log messages", &n) == 1) {
+            noted += n;
+        }
+        else {
+            ++written;
+        }
+    }
+    REQUIRE(written + dropped == 10000);
+    REQUIRE(noted == dropped);
+}
+
+TEST_CASE("LogSink has written an urgent record by the time write returns", "[utility][io][LogSink]") {
+    const auto path = temp_log("urgent");
+
+    // Without the urgent record nothing would be written for a long time
+    LogSink::Config config;
+    config.flush_period = std::chrono::seconds(10);
+
+    LogSink sink(path.string(), config);
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE(sink.write(fmt::format("line {}\n", i)));
+    }
+    REQUIRE(sink.write("error\n", true));
+
+    // Read while the sink is still alive so the destructor can't be what wrote them
+    const auto lines = read_lines(path);
+    REQUIRE(lines.size() == 11);
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE(lines[i] == fmt::format("line {}", i));
+    }
+    REQUIRE(lines.back() == "error");
+}
@@ -26,8 +26,10 @@
  */
 
 #include <Eigen/Core>
+#include <algorithm>
 #include <array>
 #include <catch2/catch_test_macros.hpp>
+#include <numeric>
 #include <utility>
 
 #include "VanDerPolModel.hpp"
@@ -209,6 +211,40 @@ TEST_CASE("Test the ParticleFilter", "[utility][math][filter][ParticleFilter]")
     REQUIRE(percentage_x1 <= 30.0);
 }
 
+TEST_CASE("Test the ParticleFilter state between resamples", "[utility][math][filter][ParticleFilter]") {
+
+    utility::math::filter::ParticleFilter<double, shared::tests::VanDerPolModel> model_filter;
+    model_filter.model.n_particles   = 1000;
+    model_filter.model.process_noise = Eigen::Vector2d(1e-4, 1e-4);
+    model_filter.resample_threshold  = 0.5;
+    model_filter.set_state(Eigen::Vector2d::Zero(), Eigen::Matrix2d::Identity());
+
+    // A broad measurement reweights the particles without dropping the effective sample size below the threshold, so
+    // none of these updates resample and the state must come from the weights alone
+    const Eigen::Matrix<double, 1, 1> measurement(2.0);
+    const Eigen::Matrix<double, 1, 1> measurement_noise(4.0);
+    double previous_x = model_filter.get_state().x();
+    for (int i = 0; i < 2; ++i) {
+        model_filter.measure(measurement, measurement_noise);
+        REQUIRE(model_filter.effective_sample_size() >= 0.5 * model_filter.particle_count());
+        model_filter.time(0.001);
+
+        const auto& log_weights = model_filter.get_particle_log_weights();
+        INFO("Update " << i);
+        REQUIRE(std::any_of(log_weights.begin(), log_weights.end(), [](const double& w) { return w != 0.0; }));
+
+        // The measurement pulls the weighted mean towards it, while the particles themselves barely moved
+        const double unweighted_x = model_filter.get_particles().row(0).mean();
+        const double weighted_x   = model_filter.get_state().x();
+        REQUIRE(weighted_x > previous_x + 0.1);
+        REQUIRE(weighted_x > unweighted_x + 0.2);
+        previous_x = weighted_x;
+
+        // Weighting towards the measurement shrinks the variance of the measured state
+        REQUIRE(model_filter.get_covariance()(0, 0) < 0.95);
+    }
+}
+
 TEST_CASE("Test the KalmanFilter", "[utility][math][filter][KalmanFilter]") {
 
     // Load in the test data
@@ -279,3 +315,51 @@ TEST_CASE("Test the KalmanFilter", "[utility][math][filter][KalmanFilter]") {
 
     REQUIRE(average_error < 1e-2);
 }
+
+TEST_CASE("Test the ParticleFilter with KLD-sampling", "[utility][math][filter][ParticleFilter]") {
+
+    const YAML::Node config             = YAML::LoadFile("tests/TestFilters.yaml");
+    const Eigen::Vector2d process_noise = config["parameters"]["noise"]["process"].as<Expression>();
+    const Eigen::Matrix<double, 1, 1> measurement_noise(
+        double(config["parameters"]["noise"]["measurement"].as<Expression>()));
+    const Eigen::Vector2d initial_state = config["parameters"]["initial"]["state"].as<Expression>();
+    const Eigen::Matrix2d initial_covariance =
+        Eigen::Vector2d(config["parameters"]["initial"]["covariance"].as<Expression>()).asDiagonal();
+    const double deltaT = config["parameters"]["delta_t"].as<Expression>();
+
+    // Resolve the Expression list types into actual types
+    const std::vector<Eigen::Vector2d> true_state = resolve_expression<Eigen::Vector2d>(config["true_state"]);
+    const std::vector<Eigen::Matrix<double, 1, 1>> measurements =
+        resolve_expression<Eigen::Matrix<double, 1, 1>, double>(config["measurements"]);
+
+    utility::math::filter::ParticleFilter<double, shared::tests::VanDerPolModel> model_filter;
+
+    // Start with as many particles as we allow, the filter should shed them as it converges
+    model_filter.model.n_particles   = 2000;
+    model_filter.model.process_noise = process_noise;
+    model_filter.kld.enabled         = true;
+    model_filter.kld.bin_size        = Eigen::Vector2d(0.2, 0.2);
+    model_filter.kld.min_particles   = 50;
+    model_filter.kld.max_particles   = 2000;
+    model_filter.set_state(initial_state, initial_covariance);
+    REQUIRE(model_filter.particle_count() == 2000);
+
+    std::vector<int> counts;
+    double mean_state_error = 0.0;
+    for (size_t i = 0; i < measurements.size(); ++i) {
+        model_filter.measure(measurements[i], measurement_noise);
+        model_filter.time(deltaT);
+        counts.push_back(model_filter.particle_count());
+        mean_state_error += std::abs(true_state[i].x() - model_filter.get_state().x());
+    }
+    mean_state_error /= measurements.size();
+
+    const double mean_count = std::accumulate(counts.begin(), counts.end(), 0.0) / counts.size();
+    INFO("The mean number of particles is " << mean_count);
+    INFO("The mean absolute error of state 1 is " << mean_state_error);
+
+    REQUIRE(*std::min_element(counts.begin(), counts.end()) >= model_filter.kld.min_particles);
+    REQUIRE(*std::max_element(counts.begin(), counts.end()) <= model_filter.kld.max_particles);
+    REQUIRE(mean_count < 1000.0);
+    REQUIRE(mean_state_error < 0.5);
+}
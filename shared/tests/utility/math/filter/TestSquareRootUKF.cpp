@@ -0,0 +1,246 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Eigen/Cholesky>
+#include <Eigen/Core>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "VanDerPolModel.hpp"
+
+#include "utility/math/filter/KalmanFilter.hpp"
+#include "utility/math/filter/SquareRootUKF.hpp"
+#include "utility/math/filter/UKF.hpp"
+#include "utility/support/yaml_expression.hpp"
+
+using utility::math::filter::KalmanFilter;
+using utility::math::filter::SquareRootUKF;
+using utility::math::filter::UKF;
+using utility::support::Expression;
+using utility::support::resolve_expression;
+
+/// A linear constant velocity model in three dimensions, which the unscented transform captures exactly
+template <typename Scalar>
+class ConstantVelocityModel {
+public:
+    static constexpr size_t size = 6;
+
+    using StateVec = Eigen::Matrix<Scalar, size, 1>;
+    using StateMat = Eigen::Matrix<Scalar, size, size>;
+
+    /// Continuous time process model, position integrates velocity
+    static StateMat A() {
+        StateMat a                        = StateMat::Zero();
+        a.template topRightCorner<3, 3>() = Eigen::Matrix<Scalar, 3, 3>::Identity();
+        return a;
+    }
+
+    StateVec process_noise = StateVec::Constant(0.01);
+
+    StateVec time(const StateVec& state, const Scalar& deltaT) {
+        return state + deltaT * A() * state;
+    }
+
+    StateMat noise(const Scalar& /*deltaT*/) {
+        return process_noise.asDiagonal();
+    }
+
+    template <typename T, typename U>
+    auto difference(const T& a, const U& b) {
+        return a - b;
+    }
+
+    Eigen::Matrix<Scalar, 3, 1> predict(const StateVec& state) {
+        return state.template head<3>();
+    }
+
+    StateVec limit(const StateVec& state) {
+        return state;
+    }
+};
+
+using CVModel = ConstantVelocityModel<double>;
+
+/// A reference trajectory and noisy position measurements of it for the constant velocity model
+std::vector<Eigen::Vector3d> constant_velocity_measurements(const int n, const double deltaT) {
+    std::mt19937 rng(7);
+    std::normal_distribution<double> noise(0.0, 0.1);
+    Eigen::Vector3d position(1.0, -2.0, 0.5);
+    const Eigen::Vector3d velocity(0.3, 0.2, -0.1);
+
+    std::vector<Eigen::Vector3d> measurements;
+    for (int i = 0; i < n; ++i) {
+        position += deltaT * velocity;
+        measurements.emplace_back(position + Eigen::Vector3d(noise(rng), noise(rng), noise(rng)));
+    }
+    return measurements;
+}
+
+TEST_CASE("The SquareRootUKF matches the KalmanFilter on a linear model", "[utility][math][filter][SquareRootUKF]") {
+    const double deltaT     = 0.1;
+    const auto measurements = constant_velocity_measurements(200, deltaT);
+
+    CVModel::StateVec initial_state     = CVModel::StateVec::Zero();
+    const CVModel::StateMat initial_cov = CVModel::StateVec::Constant(2.0).asDiagonal();
+    const CVModel::StateMat process_cov = CVModel().noise(deltaT);
+    const Eigen::Matrix<double, 3, 6> C = Eigen::Matrix<double, 3, 6>::Identity();
+
+    // A diagonal variance takes the scaling path, a correlated one is decorrelated by its Cholesky factor
+    Eigen::Matrix3d diagonal = Eigen::Vector3d(0.01, 0.02, 0.03).asDiagonal();
+    Eigen::Matrix3d correlated;
+    correlated << 0.02, 0.01, 0.0, 0.01, 0.03, -0.005, 0.0, -0.005, 0.01;
+
+    for (const Eigen::Matrix3d& R : {diagonal, correlated}) {
+        KalmanFilter<double, 6, 0, 3> kf(initial_state,
+                                         initial_cov,
+                                         CVModel::A(),
+                                         Eigen::Matrix<double, 6, 0>(),
+                                         C,
+                                         process_cov,
+                                         R);
+        SquareRootUKF<double, ConstantVelocityModel> srukf(initial_state, initial_cov);
+
+        for (const auto& measurement : measurements) {
+            kf.measure(measurement);
+            srukf.measure(measurement, R);
+            REQUIRE(srukf.get_state().isApprox(kf.get_state(), 1e-8));
+            REQUIRE(srukf.get_covariance().isApprox(kf.get_covariance(), 1e-8));
+
+            kf.time(Eigen::Matrix<double, 0, 1>(), deltaT);
+            REQUIRE(srukf.time(deltaT) == Eigen::Success);
+            REQUIRE(srukf.get_state().isApprox(kf.get_state(), 1e-8));
+            REQUIRE(srukf.get_covariance().isApprox(kf.get_covariance(), 1e-8));
+
+            // The carried factor stays lower triangular with a positive diagonal
+            const CVModel::StateMat& S = srukf.get_sqrt_covariance();
+            REQUIRE(S.isLowerTriangular());
+            REQUIRE((S.diagonal().array() > 0.0).all());
+        }
+    }
+}
+
+TEST_CASE("The SquareRootUKF log likelihood matches the Gaussian density", "[utility][math][filter][SquareRootUKF]") {
+    const CVModel::StateVec mean = (CVModel::StateVec() << 1.0, 2.0, 3.0, 0.1, 0.2, 0.3).finished();
+    CVModel::StateMat covariance = CVModel::StateVec::Constant(0.5).asDiagonal();
+    covariance(0, 1)             = 0.2;
+    covariance(1, 0)             = 0.2;
+    Eigen::Matrix3d R;
+    R << 0.02, 0.01, 0.0, 0.01, 0.03, -0.005, 0.0, -0.005, 0.01;
+    const Eigen::Vector3d measurement(1.3, 1.6, 3.2);
+
+    SquareRootUKF<double, ConstantVelocityModel> srukf(mean, covariance);
+    const double log_likelihood = srukf.measure(measurement, R);
+
+    // The measurement is linear so its predicted distribution is N(C x, C P C^T + R)
+    const Eigen::Matrix3d innovation_variance = covariance.topLeftCorner<3, 3>() + R;
+    const Eigen::Vector3d innovation          = measurement - mean.head<3>();
+    const double expected = -0.5
+                            * (std::log(innovation_variance.determinant())
+                               + innovation.dot(innovation_variance.llt().solve(innovation))
+                               + 3.0 * std::log(2 * M_PI));
+
+    REQUIRE(std::abs(log_likelihood - expected) < 1e-9);
+}
+
+TEST_CASE("Compare the SquareRootUKF with the UKF", "[utility][math][filter][SquareRootUKF]") {
+
+    const YAML::Node config             = YAML::LoadFile("tests/TestFilters.yaml");
+    const Eigen::Vector2d process_noise = config["parameters"]["noise"]["process"].as<Expression>();
+    const Eigen::Matrix<double, 1, 1> measurement_noise(
+        double(config["parameters"]["noise"]["measurement"].as<Expression>()));
+    const Eigen::Vector2d initial_state = config["parameters"]["initial"]["state"].as<Expression>();
+    const Eigen::Matrix2d initial_covariance =
+        Eigen::Vector2d(config["parameters"]["initial"]["covariance"].as<Expression>()).asDiagonal();
+    const double deltaT = config["parameters"]["delta_t"].as<Expression>();
+
+    const std::vector<Eigen::Vector2d> true_state = resolve_expression<Eigen::Vector2d>(config["true_state"]);
+    const std::vector<Eigen::Matrix<double, 1, 1>> measurements =
+        resolve_expression<Eigen::Matrix<double, 1, 1>, double>(config["measurements"]);
+
+    REQUIRE(true_state.size() == measurements.size());
+
+    UKF<double, shared::tests::VanDerPolModel> ukf;
+    SquareRootUKF<double, shared::tests::VanDerPolModel> srukf;
+    ukf.model.process_noise   = process_noise;
+    srukf.model.process_noise = process_noise;
+    ukf.set_state(initial_state, initial_covariance);
+    srukf.set_state(initial_state, initial_covariance);
+
+    Eigen::Vector2d ukf_squared_error   = Eigen::Vector2d::Zero();
+    Eigen::Vector2d srukf_squared_error = Eigen::Vector2d::Zero();
+    double count_x1                     = 0.0;
+    for (size_t i = 0; i < measurements.size(); ++i) {
+        ukf.measure(measurements[i], measurement_noise);
+        ukf.time(deltaT);
+        srukf.measure(measurements[i], measurement_noise);
+        REQUIRE(srukf.time(deltaT) == Eigen::Success);
+
+        ukf_squared_error += (true_state[i] - ukf.get_state()).cwiseAbs2();
+        srukf_squared_error += (true_state[i] - srukf.get_state()).cwiseAbs2();
+        count_x1 += std::abs(true_state[i].x() - srukf.get_state().x()) > std::sqrt(srukf.get_covariance()(0, 0))
+                        ? 1.0
+                        : 0.0;
+    }
+
+    const Eigen::Vector2d ukf_rms   = (ukf_squared_error / measurements.size()).cwiseSqrt();
+    const Eigen::Vector2d srukf_rms = (srukf_squared_error / measurements.size()).cwiseSqrt();
+    const double percentage_x1      = 100.0 * count_x1 / measurements.size();
+
+    INFO("UKF RMS state error..........: " << ukf_rms.transpose());
+    INFO("SquareRootUKF RMS state error: " << srukf_rms.transpose());
+    INFO(percentage_x1 << "% of state 1 estimates exceed the 1σ boundary");
+
+    REQUIRE(percentage_x1 <= 30.0);
+    REQUIRE((srukf_rms.array() <= 1.2 * ukf_rms.array()).all());
+}
+
+TEST_CASE("Benchmark the SquareRootUKF against the UKF", "[utility][math][filter][SquareRootUKF][!benchmark]") {
+    const double deltaT                 = 0.1;
+    const auto measurements             = constant_velocity_measurements(100, deltaT);
+    const Eigen::Matrix3d R             = Eigen::Vector3d(0.01, 0.02, 0.03).asDiagonal();
+    const CVModel::StateMat initial_cov = CVModel::StateVec::Constant(2.0).asDiagonal();
+
+    BENCHMARK("UKF") {
+        UKF<double, ConstantVelocityModel> ukf(CVModel::StateVec::Zero(), initial_cov);
+        for (const auto& measurement : measurements) {
+            ukf.measure(measurement, R);
+            ukf.time(deltaT);
+        }
+        return ukf.get_state();
+    };
+    BENCHMARK("SquareRootUKF") {
+        SquareRootUKF<double, ConstantVelocityModel> srukf(CVModel::StateVec::Zero(), initial_cov);
+        for (const auto& measurement : measurements) {
+            srukf.measure(measurement, R);
+            srukf.time(deltaT);
+        }
+        return srukf.get_state();
+    };
+}
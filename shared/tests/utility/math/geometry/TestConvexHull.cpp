@@ -26,14 +26,18 @@
  */
 #include <Eigen/Core>
 #include <Eigen/Geometry>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <numeric>
+#include <random>
 #include <yaml-cpp/yaml.h>
 
 #include "utility/math/geometry/ConvexHull.hpp"
 #include "utility/support/yaml_expression.hpp"
 
 using utility::math::geometry::chans_convex_hull;
+using utility::math::geometry::ConvexPolygon;
+using utility::math::geometry::monotone_chain_hull;
 using utility::math::geometry::point_in_convex_hull;
 using utility::support::resolve_expression;
 
@@ -147,3 +151,226 @@ SCENARIO("Convex hull of a polygon can be calculated using Chan's algorithm", "[
         }
     }
 }
+
+
+/// Whether two closed hulls visit the same points in the same order, regardless of which point they start from
+static bool same_cycle(const std::vector<int>& a, const std::vector<int>& b) {
+    if (a.size() != b.size() || a.empty()) {
+        return a.size() == b.size();
+    }
+    std::vector<int> open_a(a.begin(), std::prev(a.end()));
+    std::vector<int> open_b(b.begin(), std::prev(b.end()));
+    auto start = std::find(open_b.begin(), open_b.end(), open_a.front());
+    if (start == open_b.end()) {
+        return false;
+    }
+    std::rotate(open_b.begin(), start, open_b.end());
+    return open_a == open_b;
+}
+
+/// Points scattered in a disc, which puts a realistic number of them on the hull
+static Eigen::Matrix<double, 2, Eigen::Dynamic> random_points(int n, std::mt19937& rng) {
+    std::uniform_real_distribution<double> angle(0.0, 2.0 * M_PI);
+    std::uniform_real_distribution<double> radius(0.0, 1.0);
+    Eigen::Matrix<double, 2, Eigen::Dynamic> points(2, n);
+    for (int i = 0; i < n; ++i) {
+        const double theta = angle(rng);
+        const double r     = std::sqrt(radius(rng)) * 5.0;
+        points.col(i) << r * std::cos(theta), r * std::sin(theta);
+    }
+    return points;
+}
+
+SCENARIO("Convex hulls can be calculated using the monotone chain algorithm", "[utility][math][geometry]") {
+    for (const char* shape : {"square", "triangle", "polygon"}) {
+        GIVEN(std::string("The ") + shape + " test points") {
+            const std::vector<Eigen::Vector2d> points =
+                resolve_expression<Eigen::Vector2d>(test_values[shape]["input"]);
+            std::vector<int> indices(points.size());
+            std::iota(indices.begin(), indices.end(), 0);
+            Eigen::Matrix<double, 2, Eigen::Dynamic> points_matrix(2, points.size());
+            for (size_t i = 0; i < points.size(); i++) {
+                points_matrix.col(i) << points[i][0], points[i][1];
+            }
+
+            WHEN("A convex hull is calculated using the monotone chain") {
+                const std::vector<int> result = monotone_chain_hull(indices, points_matrix);
+
+                THEN("It is the same closed clockwise hull as the expected one") {
+                    REQUIRE(result.front() == result.back());
+                    REQUIRE(same_cycle(result, test_values[shape]["hull"].as<std::vector<int>>()));
+                }
+            }
+        }
+    }
+
+    GIVEN("Random point clouds") {
+        std::mt19937 rng(42);
+        std::vector<int> sorted;
+        std::vector<int> hull;
+        for (int trial = 0; trial < 20; ++trial) {
+            const auto points = random_points(500, rng);
+            std::vector<int> indices(points.cols());
+            std::iota(indices.begin(), indices.end(), 0);
+
+            // Reuse the same buffers each time, as the green horizon detector does
+            monotone_chain_hull(indices, points, sorted, hull);
+
+            THEN("Every turn of the hull is clockwise") {
+                for (size_t i = 0; i + 2 < hull.size() + 1; ++i) {
+                    const Eigen::Vector2d a = points.col(hull[i]);
+                    const Eigen::Vector2d b = points.col(hull[(i + 1) % (hull.size() - 1)]);
+                    const Eigen::Vector2d c = points.col(hull[(i + 2) % (hull.size() - 1)]);
+                    const Eigen::Vector2d ab = b - a;
+                    const Eigen::Vector2d ac = c - a;
+                    REQUIRE(ab.x() * ac.y() - ab.y() * ac.x() < 0.0);
+                }
+            }
+
+            THEN("Every point is inside the hull") {
+                std::vector<Eigen::Vector2d> hull_points;
+                for (int idx : hull) {
+                    hull_points.emplace_back(points.col(idx));
+                }
+                const ConvexPolygon polygon(hull_points);
+                for (int i = 0; i < points.cols(); ++i) {
+                    REQUIRE(polygon.contains(Eigen::Vector2d(points.col(i))));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Convex polygons agree with the winding number containment test", "[utility][math][geometry]") {
+    GIVEN("The polygon test hull and its check points") {
+        const std::vector<Eigen::Vector2d> points =
+            resolve_expression<Eigen::Vector2d>(test_values["polygon"]["input"]);
+        std::vector<Eigen::Vector2d> hull_points;
+        for (int idx : test_values["polygon"]["hull"].as<std::vector<int>>()) {
+            hull_points.push_back(points[idx]);
+        }
+        const std::vector<Eigen::Vector2d> check_points =
+            resolve_expression<Eigen::Vector2d>(test_values["polygon"]["check_points"]);
+        const std::vector<bool> check_results = resolve_expression<bool>(test_values["polygon"]["check_results"]);
+
+        WHEN("A convex polygon is built from the hull") {
+            const ConvexPolygon polygon(hull_points);
+
+            THEN("The check points are inside or outside as expected") {
+                for (size_t i = 0; i < check_points.size(); i++) {
+                    REQUIRE(polygon.contains(check_points[i]) == check_results[i]);
+                }
+            }
+        }
+    }
+
+    GIVEN("A random hull and random points") {
+        std::mt19937 rng(7);
+        const auto hull_cloud = random_points(200, rng);
+        std::vector<int> indices(hull_cloud.cols());
+        std::iota(indices.begin(), indices.end(), 0);
+        std::vector<Eigen::Vector3d> hull_points;
+        for (int idx : monotone_chain_hull(indices, hull_cloud)) {
+            hull_points.emplace_back(hull_cloud(0, idx), hull_cloud(1, idx), 0.0);
+        }
+        const ConvexPolygon polygon(hull_points);
+
+        std::uniform_real_distribution<double> coordinate(-6.0, 6.0);
+
+        THEN("Single points give the same answer as the winding number") {
+            for (int i = 0; i < 2000; ++i) {
+                const Eigen::Vector3d p(coordinate(rng), coordinate(rng), 0.0);
+                REQUIRE(polygon.contains(p) == point_in_convex_hull(hull_points, p));
+            }
+        }
+
+        THEN("Whole clusters are classified the same as testing each point") {
+            std::normal_distribution<double> spread(0.0, 0.5);
+            for (int i = 0; i < 500; ++i) {
+                const Eigen::Vector2d centre(coordinate(rng), coordinate(rng));
+                Eigen::Matrix<double, 3, Eigen::Dynamic> cluster_points(3, 30);
+                for (int j = 0; j < cluster_points.cols(); ++j) {
+                    cluster_points.col(j) << centre.x() + spread(rng), centre.y() + spread(rng), 0.0;
+                }
+                std::vector<int> cluster(cluster_points.cols());
+                std::iota(cluster.begin(), cluster.end(), 0);
+
+                bool in  = false;
+                bool out = false;
+                for (int idx : cluster) {
+                    const bool inside = point_in_convex_hull(hull_points, Eigen::Vector3d(cluster_points.col(idx)));
+                    in                = in || inside;
+                    out               = out || !inside;
+                }
+                const auto expected = in && out ? ConvexPolygon::Side::BOTH
+                                      : in      ? ConvexPolygon::Side::INSIDE
+                                                : ConvexPolygon::Side::OUTSIDE;
+                REQUIRE(polygon.classify(cluster, cluster_points) == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("Benchmark convex hulls and containment tests", "[utility][math][geometry][!benchmark]") {
+    std::mt19937 rng(1);
+    const auto points = random_points(2000, rng);
+    std::vector<int> indices(points.cols());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    std::vector<int> sorted;
+    std::vector<int> hull;
+    monotone_chain_hull(indices, points, sorted, hull);
+    std::vector<Eigen::Vector3d> hull_points;
+    for (int idx : hull) {
+        hull_points.emplace_back(points(0, idx), points(1, idx), 0.0);
+    }
+    const ConvexPolygon polygon(hull_points);
+
+    // Clusters of queries around the edge of the hull, like objects near the green horizon
+    Eigen::Matrix<double, 3, Eigen::Dynamic> queries(3, 2000);
+    std::uniform_real_distribution<double> angle(0.0, 2.0 * M_PI);
+    std::normal_distribution<double> spread(0.0, 0.3);
+    for (int i = 0; i < queries.cols(); i += 20) {
+        const double theta = angle(rng);
+        for (int j = i; j < i + 20; ++j) {
+            queries.col(j) << 5.0 * std::cos(theta) + spread(rng), 5.0 * std::sin(theta) + spread(rng), 0.0;
+        }
+    }
+    std::vector<std::vector<int>> clusters;
+    for (int i = 0; i < queries.cols(); i += 20) {
+        clusters.emplace_back(20);
+        std::iota(clusters.back().begin(), clusters.back().end(), i);
+    }
+
+    BENCHMARK("chans convex hull") {
+        return chans_convex_hull(indices, points);
+    };
+    BENCHMARK("monotone chain hull") {
+        monotone_chain_hull(indices, points, sorted, hull);
+        return hull.size();
+    };
+    BENCHMARK("build convex polygon") {
+        return ConvexPolygon(hull_points);
+    };
+    BENCHMARK("point_in_convex_hull per point") {
+        int inside = 0;
+        for (int i = 0; i < queries.cols(); ++i) {
+            inside += point_in_convex_hull(hull_points, Eigen::Vector3d(queries.col(i))) ? 1 : 0;
+        }
+        return inside;
+    };
+    BENCHMARK("ConvexPolygon::contains per point") {
+        int inside = 0;
+        for (int i = 0; i < queries.cols(); ++i) {
+            inside += polygon.contains(queries.col(i)) ? 1 : 0;
+        }
+        return inside;
+    };
+    BENCHMARK("ConvexPolygon::classify per cluster") {
+        int both = 0;
+        for (const auto& cluster : clusters) {
+            both += polygon.classify(cluster, queries) == ConvexPolygon::Side::BOTH ? 1 : 0;
+        }
+        return both;
+    };
+}
@@ -0,0 +1,212 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Eigen/Core>
+#include <Eigen/LU>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <random>
+
+#include "utility/math/stats/multivariate.hpp"
+#include "utility/math/stats/xoshiro.hpp"
+
+using utility::math::stats::MultivariateNormal;
+using utility::math::stats::Xoshiro256PlusPlus;
+
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+/// The density as it was originally calculated, inverting the covariance for every point
+template <int N>
+double reference_density(const Eigen::Matrix<double, N, 1>& x,
+                         const Eigen::Matrix<double, N, 1>& mean,
+                         const Eigen::Matrix<double, N, N>& covariance) {
+    const auto z = -0.5 * ((x - mean).transpose() * covariance.inverse() * (x - mean))(0);
+    return std::exp(z) / std::sqrt(std::pow(2.0 * M_PI, N) * std::abs(covariance.determinant()));
+}
+
+/// A random symmetric positive definite matrix
+template <int N>
+Eigen::Matrix<double, N, N> random_covariance(std::mt19937& rng) {
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    const Eigen::Matrix<double, N, N> a = Eigen::Matrix<double, N, N>().NullaryExpr([&]() { return dist(rng); });
+    return a * a.transpose() + 0.1 * Eigen::Matrix<double, N, N>::Identity();
+}
+
+SCENARIO("The multivariate normal density matches the closed form", "[utility][math][stats][multivariate]") {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(-2.0, 2.0);
+
+    GIVEN("Random means and positive definite covariances") {
+        for (int trial = 0; trial < 20; ++trial) {
+            const Eigen::Matrix<double, 4, 1> mean =
+                Eigen::Matrix<double, 4, 1>().NullaryExpr([&]() { return dist(rng); });
+            const Eigen::Matrix4d covariance = random_covariance<4>(rng);
+            MultivariateNormal<double, 4> multivariate(mean, covariance);
+
+            const Eigen::Matrix<double, 4, Eigen::Dynamic> xs =
+                Eigen::Matrix<double, 4, Eigen::Dynamic>::NullaryExpr(4, 50, [&]() { return dist(rng); });
+            const Eigen::VectorXd log_densities = multivariate.log_density(xs);
+
+            THEN("The single and batch densities agree with the original formula") {
+                for (int i = 0; i < xs.cols(); ++i) {
+                    const Eigen::Matrix<double, 4, 1> x = xs.col(i);
+                    const double expected               = reference_density<4>(x, mean, covariance);
+                    REQUIRE_THAT(multivariate.density(x), WithinRel(expected, 1e-9));
+                    REQUIRE_THAT(multivariate.log_density(x), WithinRel(std::log(expected), 1e-9));
+                    REQUIRE_THAT(log_densities[i], WithinRel(std::log(expected), 1e-9));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Samples from the multivariate normal have the right moments", "[utility][math][stats][multivariate]") {
+    std::mt19937 rng(7);
+    const int n_samples = 200000;
+
+    // A positive definite covariance uses the Cholesky factor, a singular one falls back to the eigen decomposition
+    Eigen::Matrix3d singular = Eigen::Matrix3d::Zero();
+    singular.topLeftCorner<2, 2>() << 0.5, 0.2, 0.2, 0.3;
+
+    for (const Eigen::Matrix3d& covariance : {random_covariance<3>(rng), singular}) {
+        GIVEN("A distribution with a known mean and covariance") {
+            const Eigen::Vector3d mean(1.0, -2.0, 0.5);
+            MultivariateNormal<double, 3> multivariate(mean, covariance);
+
+            WHEN("Many samples are drawn using an injected generator") {
+                Xoshiro256PlusPlus gen(1234);
+                Eigen::Matrix<double, 3, Eigen::Dynamic> samples(3, n_samples);
+                for (int i = 0; i < n_samples; ++i) {
+                    samples.col(i) = multivariate.sample(gen);
+                }
+
+                THEN("The sample mean and covariance match the distribution") {
+                    const Eigen::Vector3d sample_mean = samples.rowwise().mean();
+                    const Eigen::Matrix<double, 3, Eigen::Dynamic> centred = samples.colwise() - sample_mean;
+                    const Eigen::Matrix3d sample_covariance = centred * centred.transpose() / double(n_samples - 1);
+                    for (int r = 0; r < 3; ++r) {
+                        REQUIRE_THAT(sample_mean[r], WithinAbs(mean[r], 0.01));
+                        for (int c = 0; c < 3; ++c) {
+                            REQUIRE_THAT(sample_covariance(r, c), WithinAbs(covariance(r, c), 0.02));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("The xoshiro generator is reproducible and uniform", "[utility][math][stats][xoshiro]") {
+    GIVEN("Two generators with the same seed and one with a different seed") {
+        Xoshiro256PlusPlus a(99);
+        Xoshiro256PlusPlus b(99);
+        Xoshiro256PlusPlus c(100);
+
+        THEN("Generators with the same seed produce the same sequence and different seeds differ") {
+            bool all_same = true;
+            for (int i = 0; i < 100; ++i) {
+                const auto x = a();
+                REQUIRE(x == b());
+                all_same = all_same && x == c();
+            }
+            REQUIRE_FALSE(all_same);
+        }
+
+        THEN("The uniform distribution drawn from it has the right mean and variance") {
+            std::uniform_real_distribution<double> dist(0.0, 1.0);
+            const int n = 100000;
+            double sum  = 0.0;
+            double sum2 = 0.0;
+            for (int i = 0; i < n; ++i) {
+                const double u = dist(a);
+                sum += u;
+                sum2 += u * u;
+            }
+            REQUIRE_THAT(sum / n, WithinAbs(0.5, 0.005));
+            REQUIRE_THAT(sum2 / n - (sum / n) * (sum / n), WithinAbs(1.0 / 12.0, 0.002));
+        }
+    }
+}
+
+TEST_CASE("Benchmark the multivariate normal", "[utility][math][stats][multivariate][!benchmark]") {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> dist(-2.0, 2.0);
+    const Eigen::Matrix4d covariance = random_covariance<4>(rng);
+    const Eigen::Vector4d mean       = Eigen::Vector4d::Zero();
+
+    // A measurement update over a typical number of particles
+    const Eigen::Matrix<double, 4, Eigen::Dynamic> xs =
+        Eigen::Matrix<double, 4, Eigen::Dynamic>::NullaryExpr(4, 1000, [&]() { return dist(rng); });
+
+    BENCHMARK("construct with a random_device seeded mt19937") {
+        std::mt19937 gen(std::random_device{}());
+        return gen();
+    };
+    BENCHMARK("construct") {
+        return MultivariateNormal<double, 4>(mean, covariance).sample();
+    };
+    BENCHMARK("density inverting per point") {
+        double sum = 0.0;
+        for (int i = 0; i < xs.cols(); ++i) {
+            sum += reference_density<4>(xs.col(i), mean, covariance);
+        }
+        return sum;
+    };
+    BENCHMARK("density per point") {
+        MultivariateNormal<double, 4> multivariate(mean, covariance);
+        double sum = 0.0;
+        for (int i = 0; i < xs.cols(); ++i) {
+            sum += multivariate.density(xs.col(i));
+        }
+        return sum;
+    };
+    BENCHMARK("batch log density") {
+        MultivariateNormal<double, 4> multivariate(mean, covariance);
+        return multivariate.log_density(xs).sum();
+    };
+    BENCHMARK("sample with mt19937") {
+        MultivariateNormal<double, 4> multivariate(mean, covariance);
+        std::mt19937 gen(1);
+        double sum = 0.0;
+        for (int i = 0; i < xs.cols(); ++i) {
+            sum += multivariate.sample(gen).sum();
+        }
+        return sum;
+    };
+    BENCHMARK("sample with xoshiro256++") {
+        MultivariateNormal<double, 4> multivariate(mean, covariance);
+        Xoshiro256PlusPlus gen(1);
+        double sum = 0.0;
+        for (int i = 0; i < xs.cols(); ++i) {
+            sum += multivariate.sample(gen).sum();
+        }
+        return sum;
+    };
+}
@@ -0,0 +1,145 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "utility/math/stats/resample/multinomial.hpp"
+#include "utility/math/stats/resample/residual.hpp"
+#include "utility/math/stats/resample/stratified.hpp"
+#include "utility/math/stats/resample/systematic.hpp"
+#include "utility/math/stats/xoshiro.hpp"
+
+namespace resample = utility::math::stats::resample;
+using utility::math::stats::Xoshiro256PlusPlus;
+
+using Catch::Matchers::WithinAbs;
+
+/// Resample many times and return how often each weight was chosen, as a fraction of all the samples
+template <typename Sampler>
+std::vector<double> frequencies(const std::vector<double>& weights, const int& count, Sampler&& sampler) {
+    Xoshiro256PlusPlus gen(2024);
+    std::vector<int> idx;
+    std::vector<double> counts(weights.size(), 0.0);
+    const int repeats = 2000;
+    bool valid        = true;
+    for (int r = 0; r < repeats; ++r) {
+        idx.clear();
+        sampler(count, weights.begin(), weights.end(), gen, idx);
+        valid = valid && int(idx.size()) == count;
+        for (const int& i : idx) {
+            valid = valid && i >= 0 && i < int(weights.size());
+            counts[std::clamp(i, 0, int(weights.size()) - 1)] += 1.0;
+        }
+    }
+    REQUIRE(valid);
+    for (auto& c : counts) {
+        c /= double(count * repeats);
+    }
+    return counts;
+}
+
+SCENARIO("Resampling chooses particles in proportion to their weights", "[utility][math][stats][resample]") {
+    // Unnormalised weights including a zero weight that must never be chosen
+    const std::vector<double> weights = {0.5, 3.0, 0.0, 1.25, 0.25, 2.0, 1.0, 0.0001};
+    const double total                = std::accumulate(weights.begin(), weights.end(), 0.0);
+    const int count                   = 100;
+
+    auto check = [&](const std::vector<double>& f) {
+        for (size_t i = 0; i < weights.size(); ++i) {
+            REQUIRE_THAT(f[i], WithinAbs(weights[i] / total, 0.005));
+        }
+        REQUIRE(f[2] == 0.0);
+    };
+
+    GIVEN("The multinomial method") {
+        check(frequencies(weights, count, [](auto&&... args) { resample::multinomial(args...); }));
+    }
+    GIVEN("The stratified method") {
+        check(frequencies(weights, count, [](auto&&... args) { resample::stratified(args...); }));
+    }
+    GIVEN("The systematic method") {
+        check(frequencies(weights, count, [](auto&&... args) { resample::systematic(args...); }));
+    }
+    GIVEN("The residual method with each of the other methods for the residuals") {
+        auto residual_with = [&](auto&& residual_sampler) {
+            return frequencies(weights, count, [&](const int& n, auto begin, auto end, auto& gen, auto& idx) {
+                resample::residual(n, begin, end, gen, idx, residual_sampler);
+            });
+        };
+        check(residual_with([](auto&&... args) { resample::multinomial(args...); }));
+        check(residual_with([](auto&&... args) { resample::stratified(args...); }));
+        check(residual_with([](auto&&... args) { resample::systematic(args...); }));
+    }
+    GIVEN("The original interface that returns a new list") {
+        const std::vector<int> idx = resample::systematic(count, weights.begin(), weights.end());
+        REQUIRE(int(idx.size()) == count);
+        REQUIRE(std::count(idx.begin(), idx.end(), 2) == 0);
+    }
+}
+
+TEST_CASE("Benchmark resampling", "[utility][math][stats][resample][!benchmark]") {
+    std::mt19937 rng(1);
+    std::exponential_distribution<double> dist(1.0);
+    std::vector<double> weights(300);
+    for (auto& w : weights) {
+        w = dist(rng);
+    }
+    Xoshiro256PlusPlus gen(1);
+    std::vector<int> idx;
+    idx.reserve(weights.size());
+
+    BENCHMARK("systematic returning a new list") {
+        return resample::systematic(int(weights.size()), weights.begin(), weights.end());
+    };
+    BENCHMARK("systematic into a reused list") {
+        idx.clear();
+        resample::systematic(int(weights.size()), weights.begin(), weights.end(), gen, idx);
+        return idx.size();
+    };
+    BENCHMARK("residual systematic into a reused list") {
+        idx.clear();
+        resample::residual(int(weights.size()),
+                           weights.begin(),
+                           weights.end(),
+                           gen,
+                           idx,
+                           [](auto&&... args) { resample::systematic(args...); });
+        return idx.size();
+    };
+    BENCHMARK("multinomial into a reused list") {
+        idx.clear();
+        resample::multinomial(int(weights.size()), weights.begin(), weights.end(), gen, idx);
+        return idx.size();
+    };
+}
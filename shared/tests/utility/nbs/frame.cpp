@@ -0,0 +1,290 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <nuclear>
+#include <tuple>
+#include <vector>
+#include <zstr.hpp>
+
+#include "message/input/Image.hpp"
+#include "message/input/Sensors.hpp"
+
+#include "utility/nbs/Decoder.hpp"
+#include "utility/nbs/Encoder.hpp"
+#include "utility/nbs/Frame.hpp"
+#include "utility/nbs/Index.hpp"
+
+using message::input::Image;
+using message::input::Sensors;
+
+namespace {
+
+    /// Writes a plain nbs file with a sensor and camera recording
+    std::filesystem::path make_recording() {
+        auto path = std::filesystem::temp_directory_path() / "frame_test.nbs";
+        std::filesystem::remove(path);
+        std::filesystem::remove(path.string() + ".idx");
+
+        utility::nbs::Encoder encoder(path);
+        auto time = NUClear::clock::now();
+        for (int i = 0; i < 1000; ++i) {
+            time += std::chrono::milliseconds(10);
+
+            Sensors sensors;
+            sensors.timestamp = time;
+            encoder.write(sensors, time);
+
+            if (i % 10 == 0) {
+                Image image;
+                image.id        = i % 20 == 0 ? 0 : 1;
+                image.timestamp = time + std::chrono::milliseconds(5);
+                image.data.resize(64 * 1024, uint8_t(i));
+                encoder.write(image, time);
+            }
+        }
+        encoder.close();
+
+        return path;
+    }
+
+    /// Copies a recording packet by packet into a new file, the same way nbstool converts between formats
+    std::filesystem::path convert(const std::filesystem::path& input,
+                                  const std::string& name,
+                                  const uint32_t& frame_size) {
+        auto path = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove(path);
+        std::filesystem::remove(path.string() + ".idx");
+
+        const utility::nbs::Index index({input});
+        utility::nbs::FrameReader reader(input);
+        utility::nbs::Encoder encoder(path, frame_size);
+        for (const auto& item : index) {
+            encoder.write(item, reader.at(uint64_t(item.offset)));
+        }
+        encoder.close();
+
+        return path;
+    }
+
+    /// The index without the fileno so the indexes of different files can be compared
+    std::vector<std::tuple<uint64_t, uint32_t, uint64_t, uint64_t, uint32_t>> entries(
+        const std::filesystem::path& path) {
+        std::vector<std::tuple<uint64_t, uint32_t, uint64_t, uint64_t, uint32_t>> output;
+        const utility::nbs::Index index({path});
+        for (const auto& item : index) {
+            output.emplace_back(item.type, item.id, item.timestamp, item.offset, item.length);
+        }
+        return output;
+    }
+
+    std::vector<uint8_t> read_file(const std::filesystem::path& path) {
+        std::ifstream input(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>()};
+    }
+
+}  // namespace
+
+TEST_CASE("Block compressed nbs files hold the same packets as plain ones", "[utility][nbs][frame]") {
+    const auto plain      = make_recording();
+    const auto compressed = convert(plain, "frame_test_compressed.nbs", 256 * 1024);
+    const auto round_trip = convert(compressed, "frame_test_round_trip.nbs", 0);
+
+    REQUIRE(std::filesystem::file_size(compressed) < std::filesystem::file_size(plain));
+    REQUIRE(read_file(round_trip) == read_file(plain));
+
+    utility::nbs::FrameReader plain_reader(plain);
+    utility::nbs::FrameReader reader(compressed);
+    REQUIRE_FALSE(plain_reader.compressed());
+    REQUIRE(reader.compressed());
+    REQUIRE(reader.size() == plain_reader.size());
+    REQUIRE(reader.frames().size() > 1);
+
+    // The frame table covers the whole recording with each packet counted once
+    uint64_t packets = 0;
+    for (const auto& frame : reader.frames()) {
+        REQUIRE(frame.start <= frame.end);
+        for (const auto& type : frame.types) {
+            packets += type.second;
+        }
+    }
+    REQUIRE(packets == 1100);
+
+    // The index written while encoding, and one built from the file, point at the same packets as the plain file
+    const auto expected = entries(plain);
+    REQUIRE(entries(compressed) == expected);
+    std::filesystem::remove(compressed.string() + ".idx");
+    REQUIRE(entries(compressed) == expected);
+
+    // The decoder gives the same messages from both files
+    std::vector<std::pair<uint32_t, size_t>> from_plain;
+    std::vector<std::pair<uint32_t, size_t>> from_compressed;
+    utility::nbs::Decoder plain_decoder(plain);
+    plain_decoder.on<Image>([&](const Image& image) { from_plain.emplace_back(image.id, image.data.size()); });
+    plain_decoder.process();
+    utility::nbs::Decoder decoder(compressed);
+    decoder.on<Image>([&](const Image& image) { from_compressed.emplace_back(image.id, image.data.size()); });
+    decoder.process();
+    REQUIRE(from_plain.size() == 100);
+    REQUIRE(from_compressed == from_plain);
+}
+
+TEST_CASE("Frames are recovered from a block compressed nbs file that was not closed", "[utility][nbs][frame]") {
+    const auto path = convert(make_recording(), "frame_test_unclosed.nbs", 256 * 1024);
+
+    std::vector<utility::nbs::Frame> frames;
+    {
+        utility::nbs::FrameReader reader(path);
+        frames = reader.frames();
+    }
+
+    // Cut off the frame table and half of the last frame, as if the robot lost power while recording
+    const auto& last = frames.back();
+    std::filesystem::resize_file(path, last.offset + last.compressed_size / 2);
+
+    utility::nbs::FrameReader reader(path);
+    REQUIRE(reader.compressed());
+    REQUIRE(reader.frames().size() == frames.size() - 1);
+    for (size_t i = 0; i < reader.frames().size(); ++i) {
+        REQUIRE(reader.frames()[i].offset == frames[i].offset);
+        REQUIRE(reader.frames()[i].uncompressed_offset == frames[i].uncompressed_offset);
+        REQUIRE(reader.frame(i).second == frames[i].uncompressed_size);
+    }
+
+    // The index still has entries for the packets that were cut off, which are left out when it is loaded
+    uint64_t packets = 0;
+    size_t images    = 0;
+    for (size_t i = 0; i < reader.frames().size(); ++i) {
+        for (const auto& type : frames[i].types) {
+            packets += type.second;
+            images += type.first == NUClear::util::serialise::Serialise<Image>::hash() ? type.second : 0;
+        }
+    }
+    const utility::nbs::Index index({path});
+    REQUIRE(uint64_t(std::distance(index.begin(), index.end())) == packets);
+    for (const auto& item : index) {
+        REQUIRE(item.offset + item.length <= reader.size());
+    }
+
+    // So the decoder only reads the packets that are in the file
+    size_t decoded = 0;
+    utility::nbs::Decoder decoder(path);
+    decoder.on<Image>([&](const Image& /*image*/) { ++decoded; });
+    decoder.process();
+    REQUIRE(images > 0);
+    REQUIRE(decoded == images);
+}
+
+TEST_CASE("The index of a block compressed nbs file only covers frames that are in the file", "[utility][nbs][frame]") {
+    const auto path     = std::filesystem::temp_directory_path() / "frame_test_recording.nbs";
+    const auto snapshot = std::filesystem::temp_directory_path() / "frame_test_snapshot.nbs";
+    for (const auto& p : {path, snapshot}) {
+        std::filesystem::remove(p);
+        std::filesystem::remove(p.string() + ".idx");
+    }
+
+    // Copy the files partway through recording, which is what is left if the robot loses power at that point
+    {
+        utility::nbs::Encoder encoder(path, 256 * 1024);
+        auto time = NUClear::clock::now();
+        for (int i = 0; i < 50; ++i) {
+            time += std::chrono::milliseconds(10);
+            Image image;
+            image.timestamp = time;
+            image.data.resize(64 * 1024, uint8_t(i));
+            encoder.write(image, time);
+        }
+        std::filesystem::copy_file(path, snapshot);
+        std::filesystem::copy_file(path.string() + ".idx", snapshot.string() + ".idx");
+    }
+
+    utility::nbs::FrameReader reader(snapshot);
+    REQUIRE(reader.compressed());
+    REQUIRE_FALSE(reader.frames().empty());
+
+    // Every packet the index points at is in a frame that was written, and every written packet is in the index
+    std::vector<std::pair<uint64_t, uint32_t>> written;
+    {
+        zstr::ifstream input(snapshot.string() + ".idx");
+        utility::nbs::IndexItem item{};
+        while (input.read(reinterpret_cast<char*>(&item), sizeof(item) - sizeof(item.fileno))) {
+            written.emplace_back(item.offset, item.length);
+            REQUIRE(item.offset + item.length <= reader.size());
+        }
+    }
+    REQUIRE(written.size() > 0);
+    REQUIRE(written.size() < 50);
+
+    const auto expected = entries(snapshot);
+    std::filesystem::remove(snapshot.string() + ".idx");
+    REQUIRE(entries(snapshot) == expected);
+    REQUIRE(expected.size() == written.size());
+
+    size_t decoded = 0;
+    utility::nbs::Decoder decoder(snapshot);
+    decoder.on<Image>([&](const Image& /*image*/) { ++decoded; });
+    decoder.process();
+    REQUIRE(decoded == written.size());
+}
+
+TEST_CASE("Reads that move between frames of a block compressed nbs file reuse the decompressed frames",
+          "[utility][nbs][frame]") {
+    const auto plain      = make_recording();
+    const auto compressed = convert(plain, "frame_test_alternating.nbs", 256 * 1024);
+
+    utility::nbs::FrameReader plain_reader(plain);
+    utility::nbs::FrameReader reader(compressed);
+    REQUIRE(reader.frames().size() > 6);
+
+    // The plain bytes each frame of the compressed file holds
+    auto expected = [&](const size_t& i) {
+        const auto& f    = reader.frames()[i];
+        const uint8_t* p = plain_reader.at(f.uncompressed_offset);
+        return std::vector<uint8_t>(p, p + f.uncompressed_size);
+    };
+    auto contents = [&](const size_t& i) {
+        const auto [data, size] = reader.frame(i);
+        return std::vector<uint8_t>(data, data + size);
+    };
+
+    // Going back to a frame that was read recently gives the frame that is already decompressed
+    const uint8_t* first = reader.frame(0).first;
+    REQUIRE(contents(1) == expected(1));
+    REQUIRE(reader.frame(0).first == first);
+    REQUIRE(contents(0) == expected(0));
+    REQUIRE(contents(1) == expected(1));
+
+    // Once enough other frames have been read it is decompressed again, and still holds the right bytes
+    for (size_t i = 2; i < reader.frames().size(); ++i) {
+        REQUIRE(contents(i) == expected(i));
+    }
+    REQUIRE(contents(0) == expected(0));
+    REQUIRE(contents(reader.frames().size() - 1) == expected(reader.frames().size() - 1));
+}
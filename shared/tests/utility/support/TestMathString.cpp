@@ -0,0 +1,88 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utility/support/math_string.hpp"
+
+using Catch::Matchers::WithinRel;
+using utility::support::parse_math_string;
+using utility::support::parse_math_strings;
+
+SCENARIO("math strings evaluate to the same value whether they are cached or batched",
+         "[utility][support][math_string]") {
+    GIVEN("A list of expressions using constants") {
+        const std::vector<std::string> expressions = {"pi", "pi / 2", "2 * 3 + 1", "-4.5", "1 KiB", "MiB / KiB"};
+        const std::vector<double> expected         = {M_PI, M_PI / 2.0, 7.0, -4.5, 1024.0, 1024.0};
+
+        WHEN("They are evaluated one at a time") {
+            THEN("Each should match the expected value, including on a second cached lookup") {
+                for (size_t i = 0; i < expressions.size(); ++i) {
+                    REQUIRE_THAT(parse_math_string<double>(expressions[i]), WithinRel(expected[i], 1e-12));
+                    REQUIRE_THAT(parse_math_string<double>(expressions[i]), WithinRel(expected[i], 1e-12));
+                }
+            }
+        }
+
+        WHEN("They are evaluated as a batch") {
+            // Use new strings so that the batch has to compile them rather than hit the cache
+            std::vector<std::string> batch;
+            for (const auto& e : expressions) {
+                batch.push_back("(" + e + ") * 1");
+            }
+            const auto values = parse_math_strings<double>(batch);
+
+            THEN("The values should be in order and match the expected value") {
+                REQUIRE(values.size() == expected.size());
+                for (size_t i = 0; i < values.size(); ++i) {
+                    REQUIRE_THAT(values[i], WithinRel(expected[i], 1e-12));
+                }
+            }
+        }
+
+        WHEN("A batch contains the auto constant") {
+            const auto values = parse_math_strings<double>({"auto", "3"});
+
+            THEN("It should resolve to infinity") {
+                REQUIRE(std::isinf(values[0]));
+                REQUIRE(values[1] == 3.0);
+            }
+        }
+
+        WHEN("A batch contains an invalid expression") {
+            THEN("It should throw an invalid argument exception") {
+                REQUIRE_THROWS_AS(parse_math_strings<double>({"1 + 2", "not_a_constant * 2"}), std::invalid_argument);
+            }
+        }
+    }
+}
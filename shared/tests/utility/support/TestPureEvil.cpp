@@ -0,0 +1,81 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <string>
+
+#include "utility/support/evil/pure_evil.hpp"
+
+#if !defined(NDEBUG) and !defined(__APPLE__)
+
+namespace {
+
+    [[gnu::noinline]] int throw_from_here(int value) {
+        if (value >= 0) {
+            throw std::runtime_error("thrown " + std::to_string(value));
+        }
+        return value;
+    }
+
+    int throw_and_catch(int value) {
+        try {
+            return throw_from_here(value);
+        }
+        catch (const std::runtime_error& ex) {
+            return int(ex.what()[0]);
+        }
+    }
+
+}  // namespace
+
+TEST_CASE("Thrown exceptions can be symbolised after they are caught", "[utility][support][evil]") {
+    throw_and_catch(1);
+
+    REQUIRE(utility::support::evil::exception_name() == "std::runtime_error");
+
+    // The frame that threw should be in the trace
+    bool found = false;
+    for (const auto& frame : utility::support::evil::stack()) {
+        found = found || frame.function.find("throw_from_here") != std::string::npos;
+    }
+    REQUIRE(found);
+}
+
+TEST_CASE("Benchmark the cost of throwing with pure evil", "[utility][support][evil][!benchmark]") {
+    BENCHMARK("throw and catch") {
+        return throw_and_catch(1);
+    };
+
+    BENCHMARK("throw, catch and symbolise") {
+        int result = throw_and_catch(1);
+        return result + int(utility::support::evil::stack().size());
+    };
+}
+
+#endif  // !defined(NDEBUG) and !defined(__APPLE__)
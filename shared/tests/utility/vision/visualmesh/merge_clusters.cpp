@@ -0,0 +1,170 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "utility/vision/visualmesh/merge_clusters.hpp"
+
+using utility::vision::visualmesh::merge_overlapping_clusters;
+
+/// The pairwise merge that GoalDetector used before, which the sweep must match exactly
+void reference_merge(std::vector<std::vector<int>>& clusters, const std::vector<double>& theta) {
+    for (auto it = clusters.begin(); it != clusters.end(); it = std::next(it)) {
+        auto range_a = std::minmax_element(it->begin(), it->end(), [&](const int& a, const int& b) {
+            return theta[a] < theta[b];
+        });
+
+        const double min_a = theta[*range_a.first];
+        const double max_a = theta[*range_a.second];
+
+        for (auto it2 = std::next(it); it2 != clusters.end();) {
+            auto range_b = std::minmax_element(it2->begin(), it2->end(), [&](const int& a, const int& b) {
+                return theta[a] < theta[b];
+            });
+
+            const double min_b = theta[*range_b.first];
+            const double max_b = theta[*range_b.second];
+
+            if (((min_a <= min_b) && (min_b <= max_a)) || ((min_b <= min_a) && (min_a <= max_b))) {
+                it->insert(it->end(), it2->begin(), it2->end());
+                it2 = clusters.erase(it2);
+            }
+            else {
+                it2 = std::next(it2);
+            }
+        }
+    }
+}
+
+/// A cluttered frame of many small clusters, each a handful of points around a bearing within the field of view
+std::vector<std::vector<int>> cluttered_frame(const int& n_clusters,
+                                              const double& width,
+                                              std::mt19937& rng,
+                                              std::vector<double>& theta) {
+    std::uniform_real_distribution<double> bearing(-1.0, 1.0);
+    std::normal_distribution<double> spread(0.0, width);
+    std::uniform_int_distribution<int> points(1, 8);
+
+    theta.clear();
+    std::vector<std::vector<int>> clusters(n_clusters);
+    for (auto& cluster : clusters) {
+        const double centre = bearing(rng);
+        for (int i = points(rng); i > 0; --i) {
+            cluster.push_back(int(theta.size()));
+            theta.push_back(centre + spread(rng));
+        }
+    }
+    return clusters;
+}
+
+SCENARIO("Overlapping clusters are merged the same as the pairwise merge", "[utility][vision][visualmesh]") {
+    std::mt19937 rng(12345);
+    std::vector<double> theta;
+
+    GIVEN("Random cluttered frames with varying amounts of overlap") {
+        WHEN("The clusters are merged with the sweep") {
+            THEN("The merged clusters are identical to the pairwise merge, including the order of their points") {
+                for (const double& width : {0.0005, 0.005, 0.02, 0.1}) {
+                    for (const int& n_clusters : {0, 1, 2, 5, 50, 300}) {
+                        auto clusters = cluttered_frame(n_clusters, width, rng, theta);
+
+                        // Clusters sharing a bearing exactly, to test the edges of the ranges
+                        if (n_clusters > 2) {
+                            clusters[1].push_back(clusters[0].front());
+                            clusters[2].push_back(clusters[1].back());
+                        }
+
+                        auto expected = clusters;
+                        reference_merge(expected, theta);
+                        merge_overlapping_clusters(clusters, [&](const int& idx) { return theta[idx]; });
+
+                        INFO("width " << width << " clusters " << n_clusters);
+                        REQUIRE(clusters == expected);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Benchmark merging goal post clusters", "[utility][vision][visualmesh][!benchmark]") {
+    std::mt19937 rng(1);
+    std::vector<double> theta;
+
+    // Noisy frames produce hundreds of small clusters of goal points, most of which do not overlap
+    const auto clusters = cluttered_frame(400, 0.002, rng, theta);
+
+    BENCHMARK("pairwise merge") {
+        auto c = clusters;
+        reference_merge(c, theta);
+        return c.size();
+    };
+    BENCHMARK("pairwise merge with atan2") {
+        // The previous GoalDetector loop recalculated the bearing of every point inside each comparison
+        auto c = clusters;
+        for (auto it = c.begin(); it != c.end(); it = std::next(it)) {
+            auto bearing = [&](const int& idx) { return std::atan2(std::sin(theta[idx]), std::cos(theta[idx])); };
+            auto compare = [&](const int& a, const int& b) { return bearing(a) < bearing(b); };
+            auto range_a = std::minmax_element(it->begin(), it->end(), compare);
+
+            const double min_a = bearing(*range_a.first);
+            const double max_a = bearing(*range_a.second);
+
+            for (auto it2 = std::next(it); it2 != c.end();) {
+                auto range_b       = std::minmax_element(it2->begin(), it2->end(), compare);
+                const double min_b = bearing(*range_b.first);
+                const double max_b = bearing(*range_b.second);
+                if (((min_a <= min_b) && (min_b <= max_a)) || ((min_b <= min_a) && (min_a <= max_b))) {
+                    it->insert(it->end(), it2->begin(), it2->end());
+                    it2 = c.erase(it2);
+                }
+                else {
+                    it2 = std::next(it2);
+                }
+            }
+        }
+        return c.size();
+    };
+    BENCHMARK("sweep merge") {
+        auto c = clusters;
+        merge_overlapping_clusters(c, [&](const int& idx) { return theta[idx]; });
+        return c.size();
+    };
+    BENCHMARK("sweep merge with atan2") {
+        auto c = clusters;
+        merge_overlapping_clusters(c, [&](const int& idx) {
+            return std::atan2(std::sin(theta[idx]), std::cos(theta[idx]));
+        });
+        return c.size();
+    };
+}
@@ -0,0 +1,265 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "LogSink.hpp"
+
+#include <cerrno>
+#include <filesystem>
+#include <fmt/format.h>
+#include <system_error>
+#include <utility>
+
+extern "C" {
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+}
+
+namespace utility::io {
+
+    namespace {
+        /// Rounds up to the next power of two so positions can be wrapped with a mask
+        size_t ring_size(size_t size) {
+            size_t n = 2;
+            while (n < size) {
+                n <<= 1;
+            }
+            return n;
+        }
+    }  // namespace
+
+    LogSink::LogSink(std::string path_, const Config& config_)
+        : config(config_)
+        , path(std::move(path_))
+        , cells(std::make_unique<Cell[]>(ring_size(config.queue_size)))  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+        , mask(ring_size(config.queue_size) - 1) {
+        for (size_t i = 0; i <= mask; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        if (!open()) {
+            throw std::system_error(errno, std::system_category(), fmt::format("Failed to open log file {}", path));
+        }
+        writer = std::thread(&LogSink::run, this);
+    }
+
+    LogSink::LogSink(int fd_, const Config& config_)
+        : config(config_)
+        , fd(fd_)
+        , cells(std::make_unique<Cell[]>(ring_size(config.queue_size)))  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+        , mask(ring_size(config.queue_size) - 1) {
+        for (size_t i = 0; i <= mask; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        writer = std::thread(&LogSink::run, this);
+    }
+
+    LogSink::~LogSink() {
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            stopping.store(true, std::memory_order_release);
+        }
+        wake.notify_one();
+        writer.join();
+
+        if (owns_fd) {
+            ::close(fd);
+        }
+    }
+
+    bool LogSink::write(std::string record, bool urgent) {
+        // A cell is free for position pos when its sequence is pos, and holds a record once its sequence is pos + 1
+        size_t pos = head.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell   = cells[pos & mask];
+            size_t seq   = cell.sequence.load(std::memory_order_acquire);
+            auto lap_gap = static_cast<std::ptrdiff_t>(seq - pos);
+
+            if (lap_gap == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.record = std::move(record);
+                    cell.urgent = urgent;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    break;
+                }
+            }
+            // The writer hasn't emptied this cell yet so the queue is full
+            else if (lap_gap < 0) {
+                n_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Wake the writer for errors, or if the queue is getting full before its next flush
+        if (urgent || pos - tail.load(std::memory_order_relaxed) >= (mask + 1) / 2) {
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+                flush_requested.store(true, std::memory_order_release);
+            }
+            wake.notify_one();
+        }
+
+        // Errors are often the last thing logged before a crash, so wait until this one is out of the process
+        if (urgent) {
+            std::unique_lock<std::mutex> lock(mutex);
+            flushed.wait(lock, [this, pos] { return written_position.load(std::memory_order_acquire) > pos; });
+        }
+
+        return true;
+    }
+
+    uint64_t LogSink::dropped() const {
+        return n_dropped.load(std::memory_order_relaxed);
+    }
+
+    bool LogSink::drain(std::string& batch) {
+        bool urgent = false;
+        size_t pos  = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+                break;
+            }
+
+            batch.append(cell.record);
+            urgent = urgent || cell.urgent;
+            cell.record.clear();
+
+            // Hand the cell back to the logging threads for their next lap of the ring
+            cell.sequence.store(pos + mask + 1, std::memory_order_release);
+            tail.store(++pos, std::memory_order_relaxed);
+        }
+        return urgent;
+    }
+
+    void LogSink::run() {
+        std::string batch;
+        batch.reserve(config.flush_size);
+
+        uint64_t reported_drops = 0;
+        auto last_flush         = std::chrono::steady_clock::now();
+
+        for (;;) {
+            // Check before draining so anything written before we were destroyed makes it into this batch
+            const bool stop = stopping.load(std::memory_order_acquire);
+
+            flush_requested.store(false, std::memory_order_relaxed);
+            const bool urgent = drain(batch);
+
+            // Let whoever reads the log know that some of it is missing
+            const uint64_t drops = n_dropped.load(std::memory_order_relaxed);
+            if (drops != reported_drops) {
+                batch.append(fmt::format("LogSink dropped {} log messages\n", drops - reported_drops));
+                reported_drops = drops;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (!batch.empty()
+                && (urgent || stop || batch.size() >= config.flush_size || now - last_flush >= config.flush_period)) {
+                flush(batch);
+                batch.clear();
+                last_flush = now;
+
+                // Release any urgent writes that were waiting on what we just wrote
+                {
+                    const std::lock_guard<std::mutex> lock(mutex);
+                    written_position.store(tail.load(std::memory_order_relaxed), std::memory_order_release);
+                }
+                flushed.notify_all();
+            }
+
+            if (stop) {
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait_for(lock, config.flush_period, [this] {
+                return flush_requested.load(std::memory_order_acquire) || stopping.load(std::memory_order_acquire);
+            });
+        }
+    }
+
+    void LogSink::flush(const std::string& batch) {
+        if (!path.empty() && config.max_file_size > 0 && file_size > 0
+            && file_size + batch.size() > config.max_file_size) {
+            rotate();
+        }
+
+        // Rotating can fail to reopen the file, in which case there is nowhere to write
+        if (fd < 0) {
+            return;
+        }
+
+        // A failed write has nowhere to be logged, so we give up on this batch rather than retry forever
+        for (size_t written = 0; written < batch.size();) {
+            ssize_t n = ::write(fd, batch.data() + written, batch.size() - written);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return;
+            }
+            written += size_t(n);
+            file_size += uint64_t(n);
+        }
+    }
+
+    void LogSink::rotate() {
+        ::close(fd);
+        owns_fd = false;
+
+        // Shuffle the old logs along, the oldest one falls off the end
+        std::error_code ec;
+        for (int i = config.max_files - 1; i > 0; --i) {
+            std::filesystem::rename(fmt::format("{}.{}", path, i), fmt::format("{}.{}", path, i + 1), ec);
+        }
+        if (config.max_files > 0) {
+            std::filesystem::rename(path, path + ".1", ec);
+        }
+        else {
+            std::filesystem::remove(path, ec);
+        }
+
+        // If this fails fd is left negative and flush stops writing
+        open();
+    }
+
+    bool LogSink::open() {
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        owns_fd = true;
+
+        struct stat st {};
+        file_size = ::fstat(fd, &st) == 0 ? uint64_t(st.st_size) : 0;
+        return true;
+    }
+
+}  // namespace utility::io
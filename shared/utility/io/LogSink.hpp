@@ -0,0 +1,171 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UTILITY_IO_LOG_SINK_HPP
+#define UTILITY_IO_LOG_SINK_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace utility::io {
+
+    /**
+     * Writes log records from many threads to a file descriptor on a single background thread
+     *
+     * Records are placed on a bounded lock free queue so the threads that log never block on the write. The writer
+     * thread collects records into batches and writes them once enough bytes are waiting, or once the flush period has
+     * passed. An urgent record (an error) is instead written straight away, and the thread that logged it waits until it
+     * has been handed to the operating system so it survives the process crashing. If the queue is full the record is
+     * dropped and counted, and the number of dropped records is written to the log once there is room again.
+     */
+    class LogSink {
+    public:
+        struct Config {
+            /// The number of records that can be waiting to be written, rounded up to a power of two
+            size_t queue_size = 4096;
+            /// Write the batch once it holds at least this many bytes
+            size_t flush_size = 64 * 1024;
+            /// Write the batch at least this often when there is anything in it
+            std::chrono::milliseconds flush_period{100};
+            /// Rotate the file when a write would take it past this many bytes, 0 to never rotate
+            uint64_t max_file_size = 0;
+            /// The number of rotated files to keep as path.1 to path.N
+            int max_files = 5;
+        };
+
+        /**
+         * @brief Creates a sink that appends to the file at path, creating it if it does not exist
+         *
+         * @param path   the file to write the log to
+         * @param config how the sink batches, flushes and rotates
+         *
+         * @throws std::system_error if the file can't be opened
+         */
+        LogSink(std::string path, const Config& config);
+
+        /**
+         * @brief Creates a sink that writes to an already open file descriptor, such as STDERR_FILENO
+         *
+         * The file descriptor is not closed by the sink and is never rotated
+         *
+         * @param fd     the file descriptor to write the log to
+         * @param config how the sink batches and flushes
+         */
+        LogSink(int fd, const Config& config);
+
+        /// Writes everything that is still queued before returning
+        ~LogSink();
+
+        LogSink(const LogSink&)            = delete;
+        LogSink(LogSink&&)                 = delete;
+        LogSink& operator=(const LogSink&) = delete;
+        LogSink& operator=(LogSink&&)      = delete;
+
+        /**
+         * @brief Queues a record to be written by the writer thread
+         *
+         * @param record the text to write, including its trailing newline
+         * @param urgent if the writer should write this record and everything before it straight away, in which case
+         *               this blocks until they have been written
+         *
+         * @return true if the record was queued, false if the queue was full and the record was dropped
+         */
+        bool write(std::string record, bool urgent = false);
+
+        /// @brief The total number of records that have been dropped because the queue was full
+        [[nodiscard]] uint64_t dropped() const;
+
+    private:
+        struct Cell {
+            /// Which lap of the ring this cell is ready for, see push and pop
+            std::atomic<size_t> sequence{0};
+            /// The record held in this cell
+            std::string record;
+            /// If the record should be written straight away
+            bool urgent{false};
+        };
+
+        /// Takes records off the queue and writes them until the sink is destroyed
+        void run();
+        /// Appends every queued record to the batch, returns true if any of them were urgent
+        bool drain(std::string& batch);
+        /// Writes the batch to the file descriptor, rotating the file first if it would get too large
+        void flush(const std::string& batch);
+        /// Moves path to path.1, path.1 to path.2 and so on and opens a new empty file at path
+        void rotate();
+        /// Opens the file at path for appending and works out how large it already is, returns false if it can't
+        bool open();
+
+        /// How we batch, flush and rotate
+        Config config;
+        /// The file we are writing to, empty if we were given a file descriptor
+        std::string path;
+        /// The file descriptor we are writing to
+        int fd{-1};
+        /// If we opened fd and need to close it
+        bool owns_fd{false};
+        /// How many bytes are in the file we are writing to
+        uint64_t file_size{0};
+
+        /// The ring of cells that make up the queue
+        std::unique_ptr<Cell[]> cells;  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+        /// The number of cells minus one, used to wrap positions onto the ring
+        size_t mask{0};
+        /// The next position that will be written to by a logging thread
+        alignas(64) std::atomic<size_t> head{0};
+        /// The next position that will be read by the writer thread
+        alignas(64) std::atomic<size_t> tail{0};
+
+        /// The number of records that were dropped because the queue was full
+        std::atomic<uint64_t> n_dropped{0};
+        /// Set when a logging thread wants the writer to write straight away
+        std::atomic<bool> flush_requested{false};
+        /// Set when the sink is being destroyed
+        std::atomic<bool> stopping{false};
+
+        /// Every record before this position has been written, or given up on if the write failed
+        std::atomic<size_t> written_position{0};
+
+        /// Guards the flags the writer sleeps on, so a wakeup can't be lost between checking them and sleeping
+        std::mutex mutex;
+        /// Used by the writer to sleep until there is something to do
+        std::condition_variable wake;
+        /// Used by urgent writes to wait for the writer to write their record
+        std::condition_variable flushed;
+
+        /// The thread that does all the writing
+        std::thread writer;
+    };
+
+}  // namespace utility::io
+
+#endif  // UTILITY_IO_LOG_SINK_HPP
@@ -13,6 +13,9 @@ target_link_libraries(nuclear_utility PUBLIC fmt::fmt)
 find_package(zstr REQUIRED)
 target_link_libraries(nuclear_utility PUBLIC zstr::zstr)
 
+find_package(zstd REQUIRED)
+target_link_libraries(nuclear_utility PUBLIC zstd::zstd)
+
 find_package(mio REQUIRED)
 target_link_libraries(nuclear_utility PUBLIC mio::mio)
 
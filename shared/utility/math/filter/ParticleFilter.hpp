@@ -29,7 +29,10 @@
 #define UTILITY_MATH_FILTER_PARTICLEFILTER_HPP
 
 #include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
 #include <random>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -39,6 +42,7 @@
 #include "utility/math/stats/resample/residual.hpp"
 #include "utility/math/stats/resample/stratified.hpp"
 #include "utility/math/stats/resample/systematic.hpp"
+#include "utility/math/stats/xoshiro.hpp"
 
 namespace utility::math::filter {
 
@@ -75,6 +79,10 @@ namespace utility::math::filter {
 
         bool use_residual_resampling = true;
 
+        /// Resample only when the effective sample size of the weights falls below this fraction of the particle
+        /// count. At 1 the particles are resampled on every time update
+        Scalar resample_threshold = Scalar(1);
+
         using Model = FilterModel<Scalar>;
         // The model
         Model model{};
@@ -82,6 +90,27 @@ namespace utility::math::filter {
         using StateVec = Eigen::Matrix<Scalar, Model::size, 1>;
         using StateMat = Eigen::Matrix<Scalar, Model::size, Model::size>;
 
+        /**
+         * @brief Settings for KLD-sampling, which adapts the number of particles to the uncertainty of the posterior.
+         * When resampling, particles are drawn until there are enough that the KL divergence between the sampled and
+         * true posterior is below epsilon with probability 1 - delta, given the number of state space bins occupied by
+         * the particles. See D. Fox, "Adapting the Sample Size in Particle Filters Through KLD-Sampling", IJRR 2003.
+         */
+        struct KLDSampling {
+            /// Whether the number of particles adapts, otherwise model.n_particles particles are always used
+            bool enabled = false;
+            /// The size of a bin in each dimension of the state space
+            StateVec bin_size = StateVec::Constant(Scalar(0.1));
+            /// The bound on the KL divergence between the sampled and true posterior
+            Scalar epsilon = Scalar(0.05);
+            /// The upper 1 - delta quantile of the standard normal distribution, 2.326 for delta = 0.01
+            Scalar z = Scalar(2.326);
+            /// The fewest particles to use, however well localised the filter is
+            int min_particles = 50;
+            /// The most particles to use, however uncertain the filter is
+            int max_particles = 1000;
+        } kld{};
+
         /**
          * @brief Constructs the particle filter using default values. Mean is set to 0 and covariance is set to
          * \f$0.1 * I_{n}\f$, where n is the size of the model. The residual method is used for resampling particles and
@@ -149,7 +178,7 @@ namespace utility::math::filter {
             init(mean, covariance);
 
             // Limit the state of each particle to ensure they are still valid
-            for (unsigned int i = 0; i < particles.cols(); i++) {
+            for (int i = 0; i < particle_count(); i++) {
                 particles.col(i) = model.limit(particles.col(i));
             }
         }
@@ -183,7 +212,7 @@ namespace utility::math::filter {
             }
 
             // Limit the state of each particle to ensure they are still valid
-            for (unsigned int i = 0; i < particles.cols(); i++) {
+            for (int i = 0; i < particle_count(); i++) {
                 particles.col(i) = model.limit(particles.col(i));
             }
         }
@@ -192,8 +221,104 @@ namespace utility::math::filter {
         using ParticleList    = Eigen::Matrix<Scalar, Model::size, Eigen::Dynamic>;
         using ParticleWeights = std::vector<Scalar>;
 
+        /// The particles, only the first particle_count() columns are in use and the rest is spare capacity so the
+        /// number of particles can change without reallocating
         ParticleList particles{};
+        /// Resampled particles are written here and then swapped with particles, so neither is reallocated
+        ParticleList resampled{};
+        /// The number of particles in the filter, not including rogues
+        int n_live = 0;
+        /// The log of each particle's weight, so many measurements can be accumulated without underflowing
+        ParticleWeights log_weights{};
+        /// The normalised weights used for resampling, kept so they don't need reallocating every time
         ParticleWeights weights{};
+        /// The indices of the particles chosen by resampling
+        std::vector<int> indices{};
+        /// The state space bins occupied by the particles drawn so far during KLD-sampling
+        std::unordered_set<uint64_t> bins{};
+
+        /// The random number generator used for sampling and resampling, seeded once for the life of the filter
+        stats::Xoshiro256PlusPlus gen{(uint64_t(std::random_device()()) << 32) | std::random_device()()};
+
+        /**
+         * @brief Make sure all of the particle and weight storage is big enough for the most particles we could have.
+         * This only reallocates when the model or KLD settings have grown, and keeps the existing particles.
+         */
+        void reserve() {
+            const int capacity = std::max(model.n_particles, kld.enabled ? kld.max_particles : 0) + model.n_rogues;
+            if (particles.cols() < capacity) {
+                particles.conservativeResize(Eigen::NoChange, capacity);
+                resampled.resize(Model::size, capacity);
+                log_weights.reserve(capacity);
+                weights.reserve(capacity);
+                indices.reserve(capacity);
+            }
+        }
+
+        /**
+         * @brief Make sure the particle and weight storage is big enough and set the number of particles to the
+         * model's n_particles
+         */
+        void allocate() {
+            reserve();
+            n_live = model.n_particles;
+            log_weights.resize(n_live + model.n_rogues);
+            weights.resize(n_live + model.n_rogues);
+        }
+
+        /**
+         * @brief The number of particles KLD-sampling needs for the particles to occupy k bins
+         *
+         * @param k The number of bins occupied by the particles drawn so far
+         */
+        [[nodiscard]] int kld_particles(const int& k) const {
+            if (k <= 1) {
+                return kld.min_particles;
+            }
+            const Scalar a = Scalar(2) / (Scalar(9) * Scalar(k - 1));
+            const Scalar b = Scalar(1) - a + std::sqrt(a) * kld.z;
+            const Scalar n = Scalar(k - 1) / (Scalar(2) * kld.epsilon) * b * b * b;
+            return std::clamp(int(std::ceil(n)), kld.min_particles, kld.max_particles);
+        }
+
+        /**
+         * @brief A hash of the state space bin that a particle falls in for KLD-sampling
+         */
+        [[nodiscard]] uint64_t kld_bin(const StateVec& state) const {
+            uint64_t key = 0xCBF29CE484222325ULL;
+            for (int i = 0; i < int(Model::size); ++i) {
+                const auto bin = int64_t(std::floor(state[i] / kld.bin_size[i]));
+                key            = (key ^ uint64_t(bin)) * 0x100000001B3ULL;
+            }
+            return key;
+        }
+
+        /**
+         * @brief Normalise the log weights into weights that sum to 1 using the log-sum-exp trick
+         *
+         * @return The effective sample size of the normalised weights, 1 / \sum w_i^2
+         */
+        Scalar normalise_weights() {
+            const Scalar max = *std::max_element(log_weights.begin(), log_weights.end());
+
+            // If every particle is impossible (or something is NaN), treat them all as equally likely
+            if (!std::isfinite(max)) {
+                std::fill(weights.begin(), weights.end(), Scalar(1) / Scalar(weights.size()));
+                return Scalar(weights.size());
+            }
+
+            Scalar sum(0);
+            for (int i = 0; i < int(weights.size()); ++i) {
+                weights[i] = std::exp(log_weights[i] - max);
+                sum += weights[i];
+            }
+            Scalar sum_squares(0);
+            for (auto& w : weights) {
+                w /= sum;
+                sum_squares += w * w;
+            }
+            return Scalar(1) / sum_squares;
+        }
 
         /**
          * @brief Clears all particles in the filter and samples new particles from the multivariate normal
@@ -204,17 +329,14 @@ namespace utility::math::filter {
          */
         void init(const StateVec& mean, const StateMat& covariance) {
             // Make sure our particle list has the right shape
-            if (particles.cols() != model.n_particles + model.n_rogues || particles.rows() != Model::size) {
-                particles.resize(Model::size, model.n_particles + model.n_rogues);
-                weights.resize(model.n_particles + model.n_rogues);
-            }
+            allocate();
 
             // Setup our multivariate normal distribution so we can initialise the particles
             MultivariateNormal<Scalar, Model::size> multivariate(mean, covariance);
 
             // Sample a random vector from the multivariate distribution for each particle
             for (int i = 0; i < model.n_particles; ++i) {
-                particles.col(i) = multivariate.sample();
+                particles.col(i) = multivariate.sample(gen);
             }
 
             // Get the model to give us some rogues
@@ -223,7 +345,7 @@ namespace utility::math::filter {
             }
 
             // Start all weights at 1
-            std::fill(weights.begin(), weights.end(), Scalar(1));
+            std::fill(log_weights.begin(), log_weights.end(), Scalar(0));
         }
 
         /**
@@ -239,10 +361,7 @@ namespace utility::math::filter {
          */
         void init(const std::vector<std::pair<StateVec, StateMat>>& hypotheses) {
             // Make sure our particle list has the right shape
-            if (particles.cols() != model.n_particles + model.n_rogues || particles.rows() != Model::size) {
-                particles.resize(Model::size, model.n_particles + model.n_rogues);
-                weights.resize(model.n_particles + model.n_rogues);
-            }
+            allocate();
 
             // We want to evenly distribute the particles across all hypotheses
             // If the distribution is not even then the remaining particles will be treated as extra rogues
@@ -256,7 +375,7 @@ namespace utility::math::filter {
 
                 const int start_col = hypothesis * particles_per_state;
                 for (int i = 0; i < particles_per_state; ++i) {
-                    particles.col(start_col + i) = multivariate.sample();
+                    particles.col(start_col + i) = multivariate.sample(gen);
                 }
             }
 
@@ -268,43 +387,54 @@ namespace utility::math::filter {
             }
 
             // Start all weights at 1
-            std::fill(weights.begin(), weights.end(), Scalar(1));
+            std::fill(log_weights.begin(), log_weights.end(), Scalar(0));
         }
 
         /**
          * @brief Use the chosen resample and residual method to resample the particles in the filter based on their
-         * weights.
+         * normalised weights. The indices of the chosen particles are written to indices.
+         *
+         * @param count The number of particles to resample
          */
-        std::vector<int> resample_particles() {
+        void resample_particles(const int& count) {
+            namespace resample = stats::resample;
+
+            indices.clear();
 
             // Select the resampling method to use
             if (use_residual_resampling) {
                 // The residual method uses a secondary method when it resamples the residual particles
                 switch (resample_method) {
                     case ResampleMethod::MULTINOMIAL:
-                        return stats::resample::residual(model.n_particles,
-                                                         weights.begin(),
-                                                         weights.end(),
-                                                         stats::resample::multinomial<decltype(weights.begin())>);
+                        return resample::residual(count,
+                                                  weights.begin(),
+                                                  weights.end(),
+                                                  gen,
+                                                  indices,
+                                                  [](auto&&... args) { resample::multinomial(args...); });
                     case ResampleMethod::STRATIFIED:
-                        return stats::resample::residual(model.n_particles,
-                                                         weights.begin(),
-                                                         weights.end(),
-                                                         stats::resample::stratified<decltype(weights.begin())>);
+                        return resample::residual(count,
+                                                  weights.begin(),
+                                                  weights.end(),
+                                                  gen,
+                                                  indices,
+                                                  [](auto&&... args) { resample::stratified(args...); });
                     case ResampleMethod::SYSTEMATIC:
-                        return stats::resample::residual(model.n_particles,
-                                                         weights.begin(),
-                                                         weights.end(),
-                                                         stats::resample::systematic<decltype(weights.begin())>);
+                        return resample::residual(count,
+                                                  weights.begin(),
+                                                  weights.end(),
+                                                  gen,
+                                                  indices,
+                                                  [](auto&&... args) { resample::systematic(args...); });
                 }
             }
             switch (resample_method) {
                 case ResampleMethod::MULTINOMIAL:
-                    return stats::resample::multinomial(model.n_particles, weights.begin(), weights.end());
+                    return resample::multinomial(count, weights.begin(), weights.end(), gen, indices);
                 case ResampleMethod::STRATIFIED:
-                    return stats::resample::stratified(model.n_particles, weights.begin(), weights.end());
+                    return resample::stratified(count, weights.begin(), weights.end(), gen, indices);
                 case ResampleMethod::SYSTEMATIC:
-                    return stats::resample::systematic(model.n_particles, weights.begin(), weights.end());
+                    return resample::systematic(count, weights.begin(), weights.end(), gen, indices);
             }
             // This shouldn't happen unless a new enum element is added and the switches aren't updated
             throw std::runtime_error("Invalid setting for resample method.");
@@ -320,33 +450,60 @@ namespace utility::math::filter {
 
             // Get indexes to the particles that are being resampled
             // Some particles may be resampled multiple times
-            std::vector<int> idx = resample_particles();
-
-            // Resample the particles
-            // For each index get the corresponding particle and perturb it with the model's process noise
-            ParticleList resampled_particles(Model::size, particles.cols());
-            for (int i = 0; i < int(idx.size()); ++i) {
-                // Create a new particle by using the selected particle as the mean + value from process noise
-                resampled_particles.col(i) = particles.col(idx[i]);
+            reserve();
+            normalise_weights();
+            int n_resampled = 0;
+            if (kld.enabled) {
+                resample_particles(kld.max_particles);
+
+                // Take the resampled particles in a random order, so any prefix of them is also a fair sample, until
+                // there are enough for the number of bins they occupy
+                std::shuffle(indices.begin(), indices.end(), gen);
+                bins.clear();
+                for (const int& idx : indices) {
+                    resampled.col(n_resampled++) = particles.col(idx);
+                    bins.insert(kld_bin(particles.col(idx)));
+                    if (n_resampled >= kld_particles(int(bins.size()))) {
+                        break;
+                    }
+                }
+            }
+            else {
+                // Resample the particles into the spare buffer
+                resample_particles(model.n_particles);
+                for (const int& idx : indices) {
+                    resampled.col(n_resampled++) = particles.col(idx);
+                }
             }
 
             // Get the model to give us some rogue particles
             for (int i = 0; i < model.n_rogues; ++i) {
-                resampled_particles.col(model.n_particles + i) = model.get_rogue();
+                resampled.col(n_resampled + i) = model.get_rogue();
             }
 
-            // Update our particles with our resampled particles
-            for (int i = 0; i < particles.cols(); i++) {
-                particles.col(i) = resampled_particles.col(i);
-            }
+            // Swap the buffers so our particles are the resampled particles, this only swaps the pointers
+            particles.swap(resampled);
+            n_live = n_resampled;
+            log_weights.resize(n_live + model.n_rogues);
+            weights.resize(n_live + model.n_rogues);
 
             // Reset all weights to 1
-            std::fill(weights.begin(), weights.end(), Scalar(1));
+            std::fill(log_weights.begin(), log_weights.end(), Scalar(0));
+        }
+
+        /**
+         * @brief Calculates the effective sample size of the particle weights, 1 / \sum w_i^2 for the normalised
+         * weights w_i. This is the number of particles when all weights are equal and 1 when one particle has all of
+         * the weight.
+         */
+        [[nodiscard]] Scalar effective_sample_size() {
+            return normalise_weights();
         }
 
         /**
-         * @brief Resample all particles in the filter and set their weights back to 1. The model is asked to give a
-         * prediction on what happens to each particle after dt time has elapsed (using model::time).
+         * @brief Resample all particles in the filter and set their weights back to 1, if the effective sample size has
+         * fallen below resample_threshold. The model is asked to give a prediction on what happens to each particle
+         * after dt time has elapsed (using model::time).
          *
          * @tparam Args the types of any extra arguments that are provided to the model's time update function.
          *
@@ -356,17 +513,20 @@ namespace utility::math::filter {
         template <typename... Args>
         void time(const Scalar& dt, Args&&... params) {
 
-            // Resample our particles
-            resample();
+            // Resample our particles once the weights have degenerated enough
+            if (resample_threshold >= Scalar(1)
+                || effective_sample_size() < resample_threshold * Scalar(particle_count())) {
+                resample();
+            }
 
             // Make a multivariate normal distribution with zero mean and the model's process noise as the covariance
             // This will be used to perturb the resampled particles
             MultivariateNormal<Scalar, Model::size> multivariate(model.noise(dt));
 
             // Perturb each particle and get the model to apply a time update. Then limit particle to ensure it is valid
-            for (int i = 0; i < particles.cols(); ++i) {
+            for (int i = 0; i < particle_count(); ++i) {
                 particles.col(i) = model.limit(
-                    model.time(particles.col(i) + multivariate.sample(), dt, std::forward<Args>(params)...));
+                    model.time(particles.col(i) + multivariate.sample(gen), dt, std::forward<Args>(params)...));
             }
         }
 
@@ -394,8 +554,8 @@ namespace utility::math::filter {
 
             // Get the model to make a prediction for each particle
             // Also get the model to tell us how much a prediction deviates from the observed measurement
-            Eigen::Matrix<MeasurementScalar, S, Eigen::Dynamic> differences(S, particles.cols());
-            for (int i = 0; i < particles.cols(); ++i) {
+            Eigen::Matrix<MeasurementScalar, S, Eigen::Dynamic> differences(S, particle_count());
+            for (int i = 0; i < particle_count(); ++i) {
                 differences.col(i) =
                     model.difference(model.predict(particles.col(i), std::forward<Args>(params)...), measurement);
             }
@@ -404,16 +564,15 @@ namespace utility::math::filter {
             // The weight update factor comes from the density function of a zero mean, measurement_covariance
             // covariance multivariate normal distribution
             MultivariateNormal<Scalar, S> multivariate(measurement_covariance);
-            for (int i = 0; i < particles.cols(); ++i) {
-                weights[i] *= multivariate.density(differences.col(i));
+            const Eigen::Matrix<Scalar, Eigen::Dynamic, 1> log_densities = multivariate.log_density(differences);
+            for (int i = 0; i < particle_count(); ++i) {
+                log_weights[i] += log_densities[i];
             }
 
-            // Calculate log probabilities
-            Eigen::Matrix<MeasurementScalar, Eigen::Dynamic, 1> logits =
-                -differences.cwiseProduct(measurement_covariance.inverse() * differences).colwise().sum();
-
+            // Calculate log probabilities, which are twice the log densities once the normalising constant cancels out
             // Subtract the max log probability for numerical stability and then exponentiate
-            logits = Eigen::exp(logits.array() - logits.maxCoeff());
+            Eigen::Matrix<MeasurementScalar, Eigen::Dynamic, 1> logits =
+                Eigen::exp(Scalar(2) * (log_densities.array() - log_densities.maxCoeff()));
 
             // Return the mean log probability
             Scalar sum(0);
@@ -427,22 +586,38 @@ namespace utility::math::filter {
          * @brief Manually set a particles weight.
          */
         void set_particle_weight(const Scalar& weight, const int& idx) {
-            weights[idx] = weight;
+            log_weights[idx] = std::log(weight);
+        }
+
+        /**
+         * @brief Multiply a particles weight by the likelihood of a measurement. This is done in the log domain, so
+         * the likelihoods of many measurements can be accumulated between resamples without underflowing.
+         */
+        void update_particle_weight(const Scalar& likelihood, const int& idx) {
+            log_weights[idx] += std::log(likelihood);
         }
 
         /**
-         * @brief Calculates and returns the mean of all particles.
+         * @brief Calculates and returns the weighted mean of all particles. Weights carry over between resamples when
+         * resample_threshold is below 1, so the measurements since the last resample are taken into account.
          */
-        [[nodiscard]] StateVec get_state() const {
-            return particles.rowwise().mean();
+        [[nodiscard]] StateVec get_state() {
+            normalise_weights();
+            return get_particles() * Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>>(weights.data(),
+                                                                                               particle_count());
         }
 
         /**
-         * @brief Calculates and returns the covariance of the particles.
+         * @brief Calculates and returns the weighted covariance of the particles. This is the unbiased estimate for
+         * normalised weights, which is the usual sample covariance when all the weights are equal.
          */
-        [[nodiscard]] StateMat get_covariance() const {
-            auto mean_centered = particles.transpose().rowwise() - particles.transpose().colwise().mean();
-            return (mean_centered.transpose() * mean_centered) / (particles.transpose().rows() - 1);
+        [[nodiscard]] StateMat get_covariance() {
+            const Scalar ess = normalise_weights();
+            const Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>> w(weights.data(), particle_count());
+            const ParticleList mean_centered = get_particles().colwise() - StateVec(get_particles() * w);
+            const StateMat covariance        = mean_centered * w.asDiagonal() * mean_centered.transpose();
+            // 1 - \sum w_i^2 is zero when a single particle holds all the weight, so don't correct the bias then
+            return ess > Scalar(1) ? StateMat(covariance / (Scalar(1) - Scalar(1) / ess)) : covariance;
         }
 
         /**
@@ -453,10 +628,18 @@ namespace utility::math::filter {
         }
 
         /**
-         * @brief Returns the underlying particle list.
+         * @brief Returns the number of particles in the filter, including rogues. This changes with each resample when
+         * KLD-sampling is enabled.
          */
-        [[nodiscard]] const ParticleList& get_particles() const {
-            return particles;
+        [[nodiscard]] int particle_count() const {
+            return int(log_weights.size());
+        }
+
+        /**
+         * @brief Returns the particles in use in the underlying particle list.
+         */
+        [[nodiscard]] auto get_particles() const {
+            return particles.leftCols(particle_count());
         }
 
         /**
@@ -464,18 +647,29 @@ namespace utility::math::filter {
          */
         [[nodiscard]] std::vector<Eigen::Matrix<Scalar, Model::size, 1>> get_particles_as_vector() const {
             std::vector<Eigen::Matrix<Scalar, Model::size, 1>> vec;
-            vec.reserve(particles.cols());
-            for (int i = 0; i < particles.cols(); ++i) {
+            vec.reserve(particle_count());
+            for (int i = 0; i < particle_count(); ++i) {
                 vec.emplace_back(particles.col(i));
             }
             return vec;
         }
 
         /**
-         * @brief Returns the underlying particle weights.
+         * @brief Returns the particle weights.
+         */
+        [[nodiscard]] ParticleWeights get_particle_weights() const {
+            ParticleWeights linear(log_weights.size());
+            std::transform(log_weights.begin(), log_weights.end(), linear.begin(), [](const Scalar& w) {
+                return std::exp(w);
+            });
+            return linear;
+        }
+
+        /**
+         * @brief Returns the log of the particle weights.
          */
-        [[nodiscard]] const ParticleWeights& get_particle_weights() const {
-            return weights;
+        [[nodiscard]] const ParticleWeights& get_particle_log_weights() const {
+            return log_weights;
         }
     };
 }  // namespace utility::math::filter
@@ -0,0 +1,342 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef UTILITY_MATH_FILTER_SQUAREROOTUKF_HPP
+#define UTILITY_MATH_FILTER_SQUAREROOTUKF_HPP
+
+#include <Eigen/Cholesky>
+#include <Eigen/Core>
+#include <Eigen/Eigenvalues>
+#include <Eigen/QR>
+#include <cmath>
+
+#include "utility/support/LazyEvaluation.hpp"
+
+namespace utility::math::filter {
+
+    /**
+     * @brief A square-root unscented Kalman filter.
+     *
+     * Has the same interface and model requirements as UKF, but carries the lower Cholesky factor S of the covariance
+     * (P = S S^T) instead of P itself. Sigma points are read straight off S, the time update refactorises with a QR
+     * decomposition followed by a rank-1 update/downdate for the central sigma point, and each independent measurement
+     * component is absorbed as a scalar update and a rank-1 downdate of S. No Cholesky factorisation of the full
+     * covariance and no matrix inversion is ever performed, and S stays triangular with a positive diagonal.
+     *
+     * See R. van der Merwe and E. Wan, "The square-root unscented Kalman filter for state and parameter-estimation",
+     * ICASSP 2001.
+     */
+    template <typename Scalar, template <typename> class FilterModel>
+    class SquareRootUKF {
+
+    public:
+        // The model
+        using Model = FilterModel<Scalar>;
+        Model model;
+
+        // Dimension types for vectors and square matrices
+        using StateVec = Eigen::Matrix<Scalar, Model::size, 1>;
+        using StateMat = Eigen::Matrix<Scalar, Model::size, Model::size>;
+
+        static constexpr Scalar ALPHA_DEFAULT = Scalar(0.1);
+        static constexpr Scalar KAPPA_DEFAULT = Scalar(0.0);
+        static constexpr Scalar BETA_DEFAULT  = Scalar(2.0);
+
+    private:
+        // The number of sigma points
+        static constexpr unsigned int NUM_SIGMA_POINTS = (Model::size * 2) + 1;
+
+        using SigmaVec = Eigen::Matrix<Scalar, NUM_SIGMA_POINTS, 1>;
+        using SigmaMat = Eigen::Matrix<Scalar, Model::size, NUM_SIGMA_POINTS>;
+        /// The weighted, centred outer sigma points stacked on top of the square root process noise
+        using CompoundMat = Eigen::Matrix<Scalar, 3 * Model::size, Model::size>;
+
+        /// Our estimate
+        StateVec mean;
+        /// Lower triangular Cholesky factor of our covariance
+        StateMat sqrt_covariance;
+
+        /// Our sigma points, generated from mean and sqrt_covariance before each update
+        SigmaMat sigma_points;
+
+        // The mean and covariance weights
+        SigmaVec mean_weights;
+        SigmaVec covariance_weights;
+
+        /// The distance of the sigma points from the mean in units of the columns of sqrt_covariance, sqrt(n + lambda)
+        Scalar sigma_scale;
+
+        /**
+         * @brief Generate new sigma points from our mean and the columns of our Cholesky factor.
+         */
+        void generate_sigma_points() {
+            // Our first column is always the mean
+            sigma_points.col(0) = mean;
+            for (unsigned int i = 1; i < Model::size + 1; ++i) {
+                sigma_points.col(i)               = mean + sigma_scale * sqrt_covariance.col(i - 1);
+                sigma_points.col(i + Model::size) = mean - sigma_scale * sqrt_covariance.col(i - 1);
+            }
+        }
+
+        /**
+         * @brief Find a square root A of a symmetric positive semi-definite matrix such that A A^T = matrix.
+         *
+         * Diagonal matrices (the usual process noise) are square rooted element wise. Otherwise we use the Cholesky
+         * factor when the matrix is positive definite, and the eigen decomposition when it is only semi-definite so
+         * that noise models with noiseless components are still accepted.
+         */
+        [[nodiscard]] static StateMat matrix_sqrt(const StateMat& matrix) {
+            if (matrix.isDiagonal(Scalar(0))) {
+                return matrix.diagonal().cwiseMax(Scalar(0)).cwiseSqrt().asDiagonal();
+            }
+            Eigen::LLT<StateMat> cholesky(matrix);
+            if (cholesky.info() == Eigen::Success) {
+                return cholesky.matrixL();
+            }
+            Eigen::SelfAdjointEigenSolver<StateMat> eigen(matrix);
+            return eigen.eigenvectors() * eigen.eigenvalues().cwiseMax(Scalar(0)).cwiseSqrt().asDiagonal();
+        }
+
+        /**
+         * @brief Rank-1 update or downdate of a lower triangular Cholesky factor, so that L L^T becomes
+         *        L L^T + sign * v v^T.
+         *
+         * @param L     the Cholesky factor to modify, left untouched on failure
+         * @param v     the vector to add or remove
+         * @param sign  positive for an update, negative for a downdate
+         *
+         * @return Eigen::NumericalIssue if the result would not be positive definite
+         */
+        [[nodiscard]] static Eigen::ComputationInfo rank_update(StateMat& L, StateVec v, const Scalar& sign) {
+            StateMat result = L;
+            for (int k = 0; k < int(Model::size); ++k) {
+                const Scalar l  = result(k, k);
+                const Scalar r2 = l * l + sign * v[k] * v[k];
+                if (!(l > Scalar(0)) || !(r2 > Scalar(0))) {
+                    return Eigen::NumericalIssue;
+                }
+                const Scalar r = std::sqrt(r2);
+                const Scalar c = r / l;
+                const Scalar s = v[k] / l;
+                result(k, k)   = r;
+
+                const int tail           = int(Model::size) - k - 1;
+                result.col(k).tail(tail) = (result.col(k).tail(tail) + sign * s * v.tail(tail)) / c;
+                v.tail(tail)             = c * v.tail(tail) - s * result.col(k).tail(tail);
+            }
+            L = result;
+            return Eigen::Success;
+        }
+
+    public:
+        SquareRootUKF(StateVec initial_mean       = StateVec::Zero(),
+                      StateMat initial_covariance = StateMat::Identity() * 0.1,
+                      Scalar alpha                = ALPHA_DEFAULT,
+                      Scalar kappa                = KAPPA_DEFAULT,
+                      Scalar beta                 = BETA_DEFAULT)
+            : model()
+            , mean(initial_mean)
+            , sqrt_covariance(StateMat::Identity())
+            , sigma_points(SigmaMat::Zero())
+            , mean_weights(SigmaVec::Zero())
+            , covariance_weights(SigmaVec::Zero())
+            , sigma_scale(0.0) {
+
+            reset(initial_mean, initial_covariance, alpha, kappa, beta);
+        }
+
+        Eigen::ComputationInfo reset(StateVec initial_mean,
+                                     StateMat initial_covariance,
+                                     Scalar alpha = ALPHA_DEFAULT,
+                                     Scalar kappa = KAPPA_DEFAULT,
+                                     Scalar beta  = BETA_DEFAULT) {
+
+            Scalar lambda = alpha * alpha * (Model::size + kappa) - Model::size;
+
+            Scalar covariance_sigma_weight = Model::size + lambda;
+            sigma_scale                    = std::sqrt(covariance_sigma_weight);
+
+            mean_weights.fill(1.0 / (2.0 * covariance_sigma_weight));
+            mean_weights[0] = lambda / covariance_sigma_weight;
+
+            covariance_weights.fill(1.0 / (2.0 * covariance_sigma_weight));
+            covariance_weights[0] = lambda / covariance_sigma_weight + (1.0 - (alpha * alpha) + beta);
+
+            return set_state(initial_mean, initial_covariance);
+        }
+
+        Eigen::ComputationInfo set_state(StateVec initial_mean, StateMat initial_covariance) {
+            Eigen::LLT<StateMat> cholesky(initial_covariance);
+            if (cholesky.info() == Eigen::Success) {
+                mean            = initial_mean;
+                sqrt_covariance = cholesky.matrixL();
+            }
+            return cholesky.info();
+        }
+
+        template <typename... Args>
+        Eigen::ComputationInfo time(const Scalar& dt, const Args&... params) {
+            // Propagate the sigma points through the process model
+            generate_sigma_points();
+            for (unsigned int i = 0; i < NUM_SIGMA_POINTS; ++i) {
+                sigma_points.col(i) = model.time(sigma_points.col(i), dt, params...);
+            }
+            const StateVec predicted_mean = model.limit(StateVec(sigma_points * mean_weights));
+            const SigmaMat centred        = sigma_points.colwise() - predicted_mean;
+
+            // The outer sigma points all share a positive weight, so together with the process noise they form a
+            // square root of the covariance that QR reduces to triangular form. R^T R = A^T A so R^T is our new factor
+            CompoundMat compound;
+            compound.template topRows<2 * Model::size>() =
+                std::sqrt(covariance_weights[1]) * centred.template rightCols<2 * Model::size>().transpose();
+            compound.template bottomRows<Model::size>() = matrix_sqrt(model.noise(dt)).transpose();
+
+            Eigen::HouseholderQR<CompoundMat> qr(compound);
+            StateMat predicted_sqrt =
+                qr.matrixQR().template topRows<Model::size>().template triangularView<Eigen::Upper>();
+            predicted_sqrt.transposeInPlace();
+
+            // Householder QR does not fix the signs, so flip columns until the diagonal is positive
+            for (unsigned int i = 0; i < Model::size; ++i) {
+                if (predicted_sqrt(i, i) < Scalar(0)) {
+                    predicted_sqrt.col(i) = -predicted_sqrt.col(i);
+                }
+            }
+
+            // The central point is added as a rank-1 update, or removed as a downdate when its weight is negative (as
+            // it is for small alpha). If that would make the covariance indefinite we leave the term out, which keeps
+            // the covariance positive definite at the cost of being slightly conservative
+            const Scalar w0                   = covariance_weights[0];
+            const Eigen::ComputationInfo info = rank_update(predicted_sqrt,
+                                                            std::sqrt(std::abs(w0)) * centred.col(0),
+                                                            w0 < Scalar(0) ? Scalar(-1) : Scalar(1));
+            if (info != Eigen::Success && w0 > Scalar(0)) {
+                return info;
+            }
+
+            mean            = predicted_mean;
+            sqrt_covariance = predicted_sqrt;
+            return Eigen::Success;
+        }
+
+        /**
+         * @brief Perform a measurement update using the given measurement and covariance.
+         *
+         * The measurement is decorrelated with the Cholesky factor of its variance (just a scaling when the variance
+         * is diagonal) and each of its components is then processed sequentially as a scalar update. The measurement
+         * variance must be positive definite.
+         */
+        template <typename MeasurementScalar, int S, int... VArgs, int... MArgs, typename... Args>
+        utility::support::LazyEvaluation<MeasurementScalar> measure(
+            const Eigen::Matrix<MeasurementScalar, S, 1, VArgs...>& measurement,
+            const Eigen::Matrix<MeasurementScalar, S, S, MArgs...>& measurement_variance,
+            const Args&... params) {
+
+            using MeasurementVec = Eigen::Matrix<Scalar, S, 1>;
+            using MeasurementMat = Eigen::Matrix<Scalar, S, S>;
+
+            // Calculate the predicted measurement for each sigma point and their mean
+            generate_sigma_points();
+            Eigen::Matrix<MeasurementScalar, S, NUM_SIGMA_POINTS> predictions;
+            for (unsigned int i = 0; i < NUM_SIGMA_POINTS; ++i) {
+                predictions.col(i) = model.predict(sigma_points.col(i), params...);
+            }
+            const Eigen::Matrix<MeasurementScalar, S, 1> predicted_mean =
+                predictions * mean_weights.template cast<MeasurementScalar>();
+
+            Eigen::Matrix<Scalar, S, NUM_SIGMA_POINTS> centred =
+                (predictions.colwise() - predicted_mean).template cast<Scalar>();
+            MeasurementVec innovation =
+                Eigen::Matrix<MeasurementScalar, S, 1>(model.difference(measurement, predicted_mean))
+                    .template cast<Scalar>();
+
+            // Whiten the measurement so that its noise is the identity and its components are independent
+            const MeasurementMat variance = measurement_variance.template cast<Scalar>();
+            Scalar log_likelihood         = Scalar(0);
+            if (variance.isDiagonal()) {
+                const MeasurementVec deviation = variance.diagonal().cwiseSqrt();
+                centred                        = deviation.cwiseInverse().asDiagonal() * centred;
+                innovation                     = innovation.cwiseQuotient(deviation);
+                log_likelihood -= deviation.array().log().sum();
+            }
+            else {
+                const Eigen::LLT<MeasurementMat> cholesky(variance);
+                cholesky.matrixL().solveInPlace(centred);
+                cholesky.matrixL().solveInPlace(innovation);
+                log_likelihood -= cholesky.matrixLLT().diagonal().array().log().sum();
+            }
+
+            // Cross covariance between state and measurement, and the covariance of the predicted measurement
+            Eigen::Matrix<Scalar, Model::size, S> cross =
+                (sigma_points.colwise() - mean) * covariance_weights.asDiagonal() * centred.transpose();
+            MeasurementMat predicted_covariance = centred * covariance_weights.asDiagonal() * centred.transpose();
+
+            for (int j = 0; j < innovation.size(); ++j) {
+                // Scalar innovation variance, so the gain is a division rather than an inversion
+                const Scalar s            = predicted_covariance(j, j) + Scalar(1);
+                const Scalar e            = innovation[j];
+                const StateVec state_gain = cross.col(j) / s;
+                const MeasurementVec gain = predicted_covariance.col(j) / s;
+
+                mean += state_gain * e;
+                log_likelihood -= Scalar(0.5) * (std::log(s) + e * e / s + std::log(Scalar(2.0 * M_PI)));
+
+                // P -= K s K^T. Should rounding make this indefinite we keep the larger covariance
+                (void) rank_update(sqrt_covariance, StateVec(cross.col(j) / std::sqrt(s)), Scalar(-1));
+
+                // Condition the remaining components on this one
+                const Eigen::Matrix<Scalar, 1, S> row = predicted_covariance.row(j);
+                innovation -= gain * e;
+                cross -= state_gain * row;
+                predicted_covariance -= gain * row;
+            }
+            mean = model.limit(mean);
+
+            // Calculate and return the likelihood of the prior mean and covariance given the new measurement
+            // (i.e. the prior probability density of the measurement). The sequential update has already computed it
+            return utility::support::LazyEvaluation<MeasurementScalar>(
+                [log_likelihood] { return MeasurementScalar(log_likelihood); });
+        }
+
+        [[nodiscard]] const StateVec& get_state() const {
+            return mean;
+        }
+
+        /// @brief The covariance, rebuilt from its Cholesky factor
+        [[nodiscard]] StateMat get_covariance() const {
+            return sqrt_covariance * sqrt_covariance.transpose();
+        }
+
+        /// @brief The lower triangular Cholesky factor of the covariance
+        [[nodiscard]] const StateMat& get_sqrt_covariance() const {
+            return sqrt_covariance;
+        }
+    };
+}  // namespace utility::math::filter
+
+
+#endif
@@ -430,5 +430,245 @@ namespace utility::math::geometry {
         });
     }
 
+    /// @brief Finds the convex hull of a set of points using Andrew's monotone chain algorithm
+    /// The points are sorted by x then y and the upper and lower chains are built in a single pass each, which is
+    /// O(n log n) with no extra allocations once the buffers have grown to size, so the buffers should be kept and
+    /// passed back in each time. Collinear points on the hull are left out.
+    /// @tparam Derived The Eigen matrix type of `points`, only the first two rows (x and y) are used
+    /// @param indices Indices corresponding to points in `points` that we want to use to create a convex hull
+    /// @param points All points in our space, including points not to be used in the convex hull
+    /// @param sorted Scratch buffer used to hold the sorted indices
+    /// @param hull Filled with the indices of the hull in clockwise order starting from the leftmost point, with the
+    /// first point repeated at the end to close it, the same form as `chans_convex_hull`
+    template <typename Derived>
+    void monotone_chain_hull(const std::vector<int>& indices,
+                             const Eigen::MatrixBase<Derived>& points,
+                             std::vector<int>& sorted,
+                             std::vector<int>& hull) {
+        hull.clear();
+        if (indices.size() < 3) {
+            return;
+        }
+
+        sorted.assign(indices.begin(), indices.end());
+        std::sort(sorted.begin(), sorted.end(), [&](int a, int b) {
+            return points(0, a) < points(0, b) || (points(0, a) == points(0, b) && points(1, a) < points(1, b));
+        });
+
+        // Cross product of (b - a) and (c - a), positive when a, b, c turn counterclockwise
+        auto cross = [&](int a, int b, int c) {
+            return (points(0, b) - points(0, a)) * (points(1, c) - points(1, a))
+                   - (points(1, b) - points(1, a)) * (points(0, c) - points(0, a));
+        };
+
+        // Upper chain from left to right, only keeping clockwise turns
+        for (int idx : sorted) {
+            while (hull.size() >= 2 && cross(hull[hull.size() - 2], hull.back(), idx) >= 0) {
+                hull.pop_back();
+            }
+            hull.push_back(idx);
+        }
+
+        // Lower chain from right to left, which finishes back at the first point and closes the hull
+        const size_t upper_size = hull.size();
+        for (auto it = std::next(sorted.rbegin()); it != sorted.rend(); ++it) {
+            while (hull.size() > upper_size && cross(hull[hull.size() - 2], hull.back(), *it) >= 0) {
+                hull.pop_back();
+            }
+            hull.push_back(*it);
+        }
+    }
+
+    /// @brief Finds the convex hull of a set of points using Andrew's monotone chain algorithm
+    /// @tparam Derived The Eigen matrix type of `points`, only the first two rows (x and y) are used
+    /// @param indices Indices corresponding to points in `points` that we want to use to create a convex hull
+    /// @param points All points in our space, including points not to be used in the convex hull
+    /// @return Indices of the hull in clockwise order starting from the leftmost point, closed
+    template <typename Derived>
+    std::vector<int> monotone_chain_hull(const std::vector<int>& indices, const Eigen::MatrixBase<Derived>& points) {
+        std::vector<int> sorted;
+        std::vector<int> hull;
+        monotone_chain_hull(indices, points, sorted, hull);
+        return hull;
+    }
+
+    /**
+     * A convex polygon stored as the half-planes of its edges, for testing many points against the same hull
+     *
+     * Building it from a hull is O(h). A single point is then tested in O(log h) by a binary search over the fan of
+     * triangles from the first vertex, and a whole cluster of points can often be accepted or rejected from its
+     * bounding box alone. Only the x and y of each point are used, and points on the boundary count as inside, the same
+     * as `point_in_convex_hull`.
+     */
+    class ConvexPolygon {
+    public:
+        /// Where a set of points lies relative to the polygon
+        enum class Side { NONE, INSIDE, OUTSIDE, BOTH };
+
+        ConvexPolygon() = default;
+
+        /// @brief Builds the polygon from its hull points, in either winding order, closed or not
+        /// @param hull The points of a convex hull in order around it, such as the green horizon
+        template <typename Vector>
+        explicit ConvexPolygon(const std::vector<Vector>& hull) {
+            vertices.reserve(hull.size());
+            for (const auto& p : hull) {
+                Eigen::Vector2d v(p.x(), p.y());
+                if (vertices.empty() || v != vertices.back()) {
+                    vertices.push_back(v);
+                }
+            }
+            while (vertices.size() > 1 && vertices.front() == vertices.back()) {
+                vertices.pop_back();
+            }
+            if (vertices.size() < 3) {
+                vertices.clear();
+                return;
+            }
+
+            // Make the winding counterclockwise so every edge has the inside on its left
+            double area = 0.0;
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                const Eigen::Vector2d& a = vertices[i];
+                const Eigen::Vector2d& b = vertices[(i + 1) % vertices.size()];
+                area += a.x() * b.y() - a.y() * b.x();
+            }
+            if (area < 0.0) {
+                std::reverse(vertices.begin(), vertices.end());
+            }
+
+            // Each edge from vertex i to i + 1 bounds the half-plane normal.dot(p) <= offset
+            normals.resize(vertices.size());
+            offsets.resize(vertices.size());
+            min = max = vertices.front();
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                const Eigen::Vector2d edge = vertices[(i + 1) % vertices.size()] - vertices[i];
+                normals[i]                 = Eigen::Vector2d(edge.y(), -edge.x());
+                offsets[i]                 = normals[i].dot(vertices[i]);
+                min                        = min.cwiseMin(vertices[i]);
+                max                        = max.cwiseMax(vertices[i]);
+            }
+        }
+
+        /// @brief Whether the polygon has an area, an empty polygon contains nothing
+        [[nodiscard]] bool empty() const {
+            return vertices.empty();
+        }
+
+        /// @brief Determine if a point is inside the polygon in O(log h)
+        /// @param p The point to test, only x and y are used
+        /// @return True if the point is inside or on the boundary of the polygon
+        template <typename Vector>
+        [[nodiscard]] bool contains(const Vector& p) const {
+            if (vertices.empty()) {
+                return false;
+            }
+            const Eigen::Vector2d q(p.x(), p.y());
+            if ((q.array() < min.array()).any() || (q.array() > max.array()).any()) {
+                return false;
+            }
+
+            // Find the triangle of the fan from the first vertex whose wedge holds the point
+            const Eigen::Vector2d d = q - vertices.front();
+            auto side               = [&](size_t i) {
+                const Eigen::Vector2d v = vertices[i] - vertices.front();
+                return v.x() * d.y() - v.y() * d.x();
+            };
+            const size_t n = vertices.size();
+            if (side(1) < 0.0 || side(n - 1) > 0.0) {
+                return false;
+            }
+            size_t lo = 1;
+            size_t hi = n - 1;
+            while (hi - lo > 1) {
+                const size_t mid = (lo + hi) / 2;
+                if (side(mid) >= 0.0) {
+                    lo = mid;
+                }
+                else {
+                    hi = mid;
+                }
+            }
+
+            // Inside the wedge, so it only remains to check the far edge of that triangle. This is measured from the
+            // edge's own vertices rather than using offsets so the hull's own vertices are exactly on the boundary
+            const Eigen::Vector2d edge = vertices[lo + 1] - vertices[lo];
+            const Eigen::Vector2d e    = q - vertices[lo];
+            return edge.x() * e.y() - edge.y() * e.x() >= 0.0;
+        }
+
+        /// @brief Classify a whole cluster of points at once
+        /// The cluster's bounding box is tested first. If all of its corners are inside the polygon, then so is every
+        /// point. If the box lies entirely outside one of the polygon's half-planes, then so does every point. Only
+        /// clusters whose box straddles the boundary are tested point by point, stopping once both sides are seen.
+        /// @tparam Derived The Eigen matrix type of `points`, only the first two rows (x and y) are used
+        /// @param cluster Indices corresponding to points in `points` that make up the cluster
+        /// @param points All points in our space
+        /// @return Whether the cluster is inside, outside, or on both sides of the polygon, or NONE if it is empty
+        template <typename Derived>
+        [[nodiscard]] Side classify(const std::vector<int>& cluster, const Eigen::MatrixBase<Derived>& points) const {
+            if (cluster.empty()) {
+                return Side::NONE;
+            }
+            if (vertices.empty()) {
+                return Side::OUTSIDE;
+            }
+
+            // Bounding box of the cluster
+            Eigen::Vector2d lo(points(0, cluster.front()), points(1, cluster.front()));
+            Eigen::Vector2d hi = lo;
+            for (int idx : cluster) {
+                const Eigen::Vector2d p(points(0, idx), points(1, idx));
+                lo = lo.cwiseMin(p);
+                hi = hi.cwiseMax(p);
+            }
+
+            // Entirely outside the polygon's bounding box or one of its half-planes
+            if ((hi.array() < min.array()).any() || (lo.array() > max.array()).any()) {
+                return Side::OUTSIDE;
+            }
+            for (size_t i = 0; i < normals.size(); ++i) {
+                // The corner of the box furthest into the half-plane
+                const double nearest = normals[i].x() * (normals[i].x() > 0.0 ? lo.x() : hi.x())
+                                       + normals[i].y() * (normals[i].y() > 0.0 ? lo.y() : hi.y());
+                if (nearest > offsets[i]) {
+                    return Side::OUTSIDE;
+                }
+            }
+
+            // A convex polygon holding every corner of the box holds everything in the box
+            if (contains(lo) && contains(hi) && contains(Eigen::Vector2d(lo.x(), hi.y()))
+                && contains(Eigen::Vector2d(hi.x(), lo.y()))) {
+                return Side::INSIDE;
+            }
+
+            bool in  = false;
+            bool out = false;
+            for (int idx : cluster) {
+                if (contains(Eigen::Vector2d(points(0, idx), points(1, idx)))) {
+                    in = true;
+                }
+                else {
+                    out = true;
+                }
+                if (in && out) {
+                    return Side::BOTH;
+                }
+            }
+            return in ? Side::INSIDE : Side::OUTSIDE;
+        }
+
+    private:
+        /// The vertices in counterclockwise order, without the closing repeat
+        std::vector<Eigen::Vector2d> vertices;
+        /// Outward normal of the edge from vertex i to i + 1
+        std::vector<Eigen::Vector2d> normals;
+        /// Offset of the edge from vertex i to i + 1, p is inside that edge when normals[i].dot(p) <= offsets[i]
+        std::vector<double> offsets;
+        /// Bounding box of the polygon
+        Eigen::Vector2d min = Eigen::Vector2d::Zero();
+        Eigen::Vector2d max = Eigen::Vector2d::Zero();
+    };
+
 }  // namespace utility::math::geometry
 #endif  // UTILITY_MATH_GEOMETRY_CONVEXHULL_HPP
@@ -28,12 +28,16 @@
 #ifndef UTILITY_MATH_STATS_MULTIVARIATE_HPP
 #define UTILITY_MATH_STATS_MULTIVARIATE_HPP
 
+#include <Eigen/Cholesky>
 #include <Eigen/Core>
 #include <Eigen/Eigenvalues>
+#include <Eigen/LU>
 #include <cmath>
 #include <random>
 #include <utility>
 
+#include "xoshiro.hpp"
+
 namespace utility::math::stats {
 
     /**
@@ -43,6 +47,9 @@ namespace utility::math::stats {
      * Implementation taken from https://stackoverflow.com/a/40245513/4795763 and
      * https://en.wikipedia.org/wiki/Multivariate_normal_distribution
      *
+     * The factorisation of the covariance, its inverse and the log of the normalising constant are calculated once on
+     * construction so sampling and evaluating the density are cheap enough to do once per particle.
+     *
      * @tparam Scalar The scalar type to use for all calculations.
      * @tparam N The dimensionality of the multivariate distribution
      */
@@ -53,13 +60,16 @@ namespace utility::math::stats {
         MultivariateNormal() = delete;
 
     public:
+        using Vector  = Eigen::Matrix<Scalar, N, 1>;
+        using Matrix  = Eigen::Matrix<Scalar, N, N>;
+        using Samples = Eigen::Matrix<Scalar, N, Eigen::Dynamic>;
+
         /**
          * @brief Construct a multivariate normal distribution of dimension N with zero mean and the provided covariance
          *
          * @param covariance_ The covariance matrix for this zero-mean multivariate normal distribution
          */
-        MultivariateNormal(const Eigen::Matrix<Scalar, N, N>& covariance_)
-            : MultivariateNormal(Eigen::Matrix<Scalar, N, 1>::Zero(), covariance_) {}
+        MultivariateNormal(const Matrix& covariance_) : MultivariateNormal(Vector::Zero(), covariance_) {}
 
         /**
          * @brief Construct a multivariate normal distribution of dimension N with the provided mean and covariance
@@ -67,13 +77,26 @@ namespace utility::math::stats {
          * @param mean_ The mean for this mean multivariate normal distribution
          * @param covariance_ The covariance matrix for this multivariate normal distribution
          */
-        MultivariateNormal(Eigen::Matrix<Scalar, N, 1> mean_, const Eigen::Matrix<Scalar, N, N>& covariance_)
-            : mean(std::move(mean_)), covariance(covariance_), gen(std::random_device()()) {
+        MultivariateNormal(Vector mean_, const Matrix& covariance_) : mean(std::move(mean_)) {
 
-            // Calculate the spectral decomposition of the covariance matrix
-            // This is needed MultivariateNormal::sample
-            Eigen::SelfAdjointEigenSolver<Eigen::Matrix<Scalar, N, N>> solver(covariance_);
-            transform = solver.eigenvectors() * solver.eigenvalues().cwiseSqrt().asDiagonal();
+            // The Cholesky factor is the cheapest matrix A with AA' = \Sigma and gives the inverse and determinant
+            Eigen::LLT<Matrix> llt(covariance_);
+            if (llt.info() == Eigen::Success) {
+                transform            = llt.matrixL();
+                inverse              = llt.solve(Matrix::Identity());
+                const Scalar log_det = Scalar(2) * transform.diagonal().array().log().sum();
+                log_normaliser       = Scalar(-0.5) * (Scalar(N) * std::log(Scalar(2.0 * M_PI)) + log_det);
+            }
+            // Positive semi-definite covariances, such as process noise with some noiseless states, have no Cholesky
+            // factor so fall back to the spectral decomposition
+            else {
+                Eigen::SelfAdjointEigenSolver<Matrix> solver(covariance_);
+                transform = solver.eigenvectors() * solver.eigenvalues().cwiseMax(Scalar(0)).cwiseSqrt().asDiagonal();
+                inverse   = covariance_.inverse();
+                log_normaliser =
+                    Scalar(-0.5)
+                    * (Scalar(N) * std::log(Scalar(2.0 * M_PI)) + std::log(std::abs(covariance_.determinant())));
+            }
         }
 
         /**
@@ -88,9 +111,43 @@ namespace utility::math::stats {
          * 2. Let z be an N dimensional vector whose components are sampled from a standard normal distribution
          * 3. Let x = \mu + Az
          * https://en.wikipedia.org/wiki/Multivariate_normal_distribution#Drawing_values_from_the_distribution
+         *
+         * @param gen The random number generator to draw from. Reusing one generator across many distributions avoids
+         * seeding a new one each time.
+         */
+        template <typename Generator>
+        [[nodiscard]] Vector sample(Generator& gen) {
+            return mean + transform * Vector().NullaryExpr([&]() { return dist(gen); });
+        }
+
+        /**
+         * @brief Samples a N dimensional random vector from this N dimensional multivariate normal distribution, using
+         * the generator for the calling thread
+         */
+        [[nodiscard]] Vector sample() {
+            return sample(thread_generator());
+        }
+
+        /**
+         * @brief Calculate the log of the density of the multivariate normal distribution at the point x
+         *
+         * @details This is more accurate than taking the log of MultivariateNormal::density for points far from the
+         * mean, where the density underflows to zero.
+         */
+        [[nodiscard]] Scalar log_density(const Vector& x) const {
+            const Vector d = x - mean;
+            return log_normaliser - Scalar(0.5) * d.dot(inverse * d);
+        }
+
+        /**
+         * @brief Calculate the log of the density of the multivariate normal distribution at each column of xs
+         *
+         * @param xs The points to evaluate, one per column
+         * @return The log density for each point, in the same order as the columns
          */
-        [[nodiscard]] Eigen::Matrix<Scalar, N, 1> sample() {
-            return mean + transform * Eigen::Matrix<Scalar, N, 1>().NullaryExpr([this]() { return dist(gen); });
+        [[nodiscard]] Eigen::Matrix<Scalar, Eigen::Dynamic, 1> log_density(const Samples& xs) const {
+            const Samples d = xs.colwise() - mean;
+            return (Scalar(-0.5) * d.cwiseProduct(inverse * d).colwise().sum().transpose()).array() + log_normaliser;
         }
 
         /**
@@ -104,21 +161,21 @@ namespace utility::math::stats {
          *
          * This function can be used to determine the relative likelihood that x was sampled from this distribution.
          */
-        [[nodiscard]] Scalar density(const Eigen::Matrix<Scalar, N, 1>& x) {
-            const auto z = Scalar(-0.5) * ((x - mean).transpose() * covariance.inverse() * (x - mean))(0);
-            return std::exp(z) / std::sqrt(std::pow(Scalar(2.0 * M_PI), N) * std::abs(covariance.determinant()));
+        [[nodiscard]] Scalar density(const Vector& x) const {
+            return std::exp(log_density(x));
         }
 
     private:
         /// @brief The mean (\mu) of the multivariate normal distribution
-        Eigen::Matrix<Scalar, N, 1> mean = Eigen::Matrix<Scalar, N, 1>::Zero();
-        /// @brief The covariance (\Sigma) of the multivariate normal distribution
-        Eigen::Matrix<Scalar, N, N> covariance = Eigen::Matrix<Scalar, N, N>::Zero();
-        /// @brief A matrix A such that AA' = \Sigma
-        Eigen::Matrix<Scalar, N, N> transform = Eigen::Matrix<Scalar, N, N>::Zero();
+        Vector mean = Vector::Zero();
+        /// @brief A matrix A such that AA' = \Sigma, the Cholesky factor when \Sigma is positive definite
+        Matrix transform = Matrix::Zero();
+        /// @brief The inverse of the covariance \Sigma^{-1}
+        Matrix inverse = Matrix::Zero();
+        /// @brief The log of the normalising constant, -0.5 * log((2\pi)^N |\Sigma|)
+        Scalar log_normaliser = Scalar(0);
 
         /// @brief Standard normal distribution. Used in MultivariateNormal::sample
-        std::mt19937 gen;
         std::normal_distribution<Scalar> dist;
     };
 
@@ -29,6 +29,7 @@
 #define UTILITY_MATH_STATS_RESAMPLE_MULTINOMIAL_HPP
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <random>
 #include <utility>
@@ -52,24 +53,35 @@ namespace utility::math::stats::resample {
         /**
          * @brief Multinomial resampling weight generator
          *
-         * @param count Number of particles being resampled
+         * @details Multinomial resampling draws count independent uniform resampling weights. The order they are used
+         * in makes no difference to which particles are chosen, so they are drawn already sorted as the order
+         * statistics of count uniforms. The minimum of m uniforms on [a, 1) is 1 - (1 - a)V^{1/m} for a uniform V.
+         *
+         * @param count_ Number of particles being resampled
+         * @param gen_ The random number generator to draw from
          */
-        Multinomial(const int& /*count*/) : gen((std::random_device()())), dist(Scalar(0.0), Scalar(1.0)) {}
+        Multinomial(const int& count_, Xoshiro256PlusPlus& gen_)
+            : gen(gen_), dist(Scalar(0.0), Scalar(1.0)), count(count_) {}
 
         /**
          * @brief Calculate the next resampling weight
          *
          * @param i Particle index being resampling
          */
-        [[nodiscard]] Scalar operator()(const int& /*i*/) {
-            return dist(gen);
+        [[nodiscard]] Scalar operator()(const int& i) {
+            previous = Scalar(1) - (Scalar(1) - previous) * std::pow(dist(gen), Scalar(1) / Scalar(count - i));
+            return previous;
         }
 
     private:
         /// @brief Uniform distribution on the interval [0, 1)
-        std::random_device rd;
-        std::mt19937 gen;
+        Xoshiro256PlusPlus& gen;
         std::uniform_real_distribution<Scalar> dist;
+
+        /// @brief Number of particles being resampled
+        int count;
+        /// @brief The previous resampling weight
+        Scalar previous = Scalar(0);
     };
 
     /**
@@ -84,6 +96,20 @@ namespace utility::math::stats::resample {
         return resample<Multinomial>(count, std::forward<Iterator>(begin), std::forward<Iterator>(end));
     }
 
+    /**
+     * @brief Call the resampler algorithm using the above resampling weight calculation, without allocating
+     *
+     * @param count Number of particles being resampled
+     * @param begin Iterator to the first weight to use for resampling
+     * @param end Iterator to the last weight to use for resampling
+     * @param gen The random number generator to draw from
+     * @param idx The indices of the resampled particles are appended to this list
+     */
+    template <typename Iterator>
+    void multinomial(const int& count, Iterator begin, Iterator end, Xoshiro256PlusPlus& gen, std::vector<int>& idx) {
+        resample<Multinomial>(count, begin, end, gen, idx);
+    }
+
 }  // namespace utility::math::stats::resample
 
 #endif  // UTILITY_MATH_STATS_RESAMPLE_MULTINOMIAL_HPP
@@ -30,10 +30,15 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <iterator>
+#include <numeric>
 #include <random>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "utility/math/stats/xoshiro.hpp"
+
 // Resampling techniques!!!
 // http://users.isy.liu.se/rt/schon/Publications/HolSG2006.pdf
 namespace utility::math::stats::resample {
@@ -42,13 +47,14 @@ namespace utility::math::stats::resample {
      * @brief The core resampling algorithm for multinomial, stratified, and systematic resampling schemes.
      *
      * @details The algorithm takes the following steps
-     *  1. Normalise weights so they sum to 1
-     *  2. Calculate cumulative sum of the normalised weights
-     *  3. For each of the count particles
+     *  1. Sum the weights so they can be normalised to sum to 1
+     *  2. For each of the count particles
      *   a. Get a new resampling weight from the generator
-     *   b. Find the first index in the cumulative sum where the generated resampling weight is >= cumulative sum
+     *   b. Advance along the cumulative sum of the normalised weights until it is >= the resampling weight
      *
-     * The index in step 3b is the index of the particle that should be sampled
+     * The index in step 2b is the index of the particle that should be sampled. The generators produce their
+     * resampling weights in increasing order, so the cumulative sum is walked once and never stored, and no memory is
+     * allocated beyond any growth of idx.
      *
      * @tparam Generator Type of the generator to use for resampling weights
      * @tparam Iterator The iterator type for the weights array
@@ -56,32 +62,53 @@ namespace utility::math::stats::resample {
      * @param count The number of particles being resampled
      * @param begin Iterator to the first weight to use for resampling
      * @param end Iterator to the last weight to use for resampling
+     * @param gen The random number generator to draw the resampling weights from
+     * @param idx The indices of the resampled particles are appended to this list
      */
     template <template <typename> class Generator, typename Iterator>
-    [[nodiscard]] std::vector<int> resample(const int& count, Iterator begin, Iterator end) {
-        using Scalar = std::remove_reference_t<decltype(*begin)>;
+    void resample(const int& count, Iterator begin, Iterator end, Xoshiro256PlusPlus& gen, std::vector<int>& idx) {
+        using Scalar = std::remove_cv_t<std::remove_reference_t<decltype(*begin)>>;
 
-        // Get number of weights
-        const auto n_weights = std::distance(begin, end);
+        if (count <= 0 || begin == end) {
+            return;
+        }
 
         // Create our distribution generator
-        Generator<Scalar> fn(count);
+        Generator<Scalar> fn(count, gen);
 
-        // Normalise the weights
-        std::vector<Scalar> normalised(n_weights, Scalar(0));
+        // Sum the weights so we can normalise them
         const Scalar sum = std::accumulate(begin, end, Scalar(0));
-        std::transform(begin, end, normalised.begin(), [&](const Scalar& w) { return w / sum; });
-
-        // Make a cumulative sum of the weights
-        std::vector<Scalar> cumsum(n_weights, Scalar(0));
-        std::partial_sum(normalised.begin(), normalised.end(), cumsum.begin());
 
-        // Randomly sample from the distribution using our random number generator
-        std::vector<int> idx(count, 0);
+        // Walk the cumulative sum of the normalised weights alongside the increasing resampling weights
+        Iterator current = begin;
+        int index        = 0;
+        Scalar cumsum    = *current / sum;
         for (int i = 0; i < count; ++i) {
-            idx[i] = std::distance(cumsum.begin(), std::lower_bound(cumsum.begin(), cumsum.end(), fn(i)));
+            const Scalar u = fn(i);
+            while (cumsum < u && std::next(current) != end) {
+                current = std::next(current);
+                cumsum += *current / sum;
+                ++index;
+            }
+            idx.push_back(index);
         }
+    }
 
+    /**
+     * @brief The core resampling algorithm, using the generator for the calling thread
+     *
+     * @tparam Generator Type of the generator to use for resampling weights
+     * @tparam Iterator The iterator type for the weights array
+     *
+     * @param count The number of particles being resampled
+     * @param begin Iterator to the first weight to use for resampling
+     * @param end Iterator to the last weight to use for resampling
+     */
+    template <template <typename> class Generator, typename Iterator>
+    [[nodiscard]] std::vector<int> resample(const int& count, Iterator begin, Iterator end) {
+        std::vector<int> idx;
+        idx.reserve(std::max(count, 0));
+        resample<Generator>(count, begin, end, thread_generator(), idx);
         return idx;
     }
 
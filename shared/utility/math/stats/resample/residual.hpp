@@ -29,11 +29,17 @@
 #define UTILITY_MATH_STATS_RESAMPLE_RESIDUAL_HPP
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <iterator>
+#include <numeric>
 #include <random>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "utility/math/stats/xoshiro.hpp"
+
 // Resampling techniques!!!
 // http://users.isy.liu.se/rt/schon/Publications/HolSG2006.pdf
 namespace utility::math::stats::resample {
@@ -105,6 +111,49 @@ namespace utility::math::stats::resample {
         return idx;
     }
 
+    /**
+     * @brief Residual resampling, appending the resampled indices to idx rather than allocating a new list. The
+     * algorithm is the same as above.
+     *
+     * @tparam Iterator The iterator type for the weights array
+     * @tparam ResidualSampler The type of the sampler to use for sampling the residual particles
+     *
+     * @param count Number of particles being resampled
+     * @param begin Iterator to the first weight to use for resampling
+     * @param end Iterator to the last weight to use for resampling
+     * @param gen The random number generator to draw from
+     * @param idx The indices of the resampled particles are appended to this list
+     * @param residual_sampler The sampler to use when resampling the residual particles, called with the arguments
+     * (count, begin, end, gen, idx) like the allocation free overloads of the other methods
+     */
+    template <typename Iterator, typename ResidualSampler>
+    void residual(const int& count,
+                  Iterator begin,
+                  Iterator end,
+                  Xoshiro256PlusPlus& gen,
+                  std::vector<int>& idx,
+                  ResidualSampler&& residual_sampler) {
+        using Scalar = std::remove_cv_t<std::remove_reference_t<decltype(*begin)>>;
+
+        // The fractional parts of the scaled weights are kept between calls so they don't need reallocating
+        thread_local std::vector<Scalar> residuals;
+        residuals.resize(std::distance(begin, end));
+
+        // Normalise the weights and multiply out by our count, replicating each particle by the integer part
+        const Scalar factor = Scalar(count) / std::accumulate(begin, end, Scalar(0));
+        const auto first    = idx.size();
+        int i               = 0;
+        for (Iterator it = begin; it != end; it = std::next(it), ++i) {
+            const Scalar w = *it * factor;
+            idx.insert(idx.end(), int(w), i);
+            residuals[i] = w - std::floor(w);
+        }
+
+        // Sample the residual particles
+        const int residual_count = count - int(idx.size() - first);
+        residual_sampler(residual_count, residuals.begin(), residuals.end(), gen, idx);
+    }
+
 }  // namespace utility::math::stats::resample
 
 #endif  // UTILITY_MATH_STATS_RESAMPLE_RESIDUAL_HPP
@@ -53,8 +53,10 @@ namespace utility::math::stats::resample {
          * @brief Stratified resampling weight generator
          *
          * @param count_ Number of particles being resampled
+         * @param gen_ The random number generator to draw from
          */
-        Stratified(const int& count_) : gen((std::random_device()())), dist(Scalar(0.0), Scalar(1.0)), count(count_) {}
+        Stratified(const int& count_, Xoshiro256PlusPlus& gen_)
+            : gen(gen_), dist(Scalar(0.0), Scalar(1.0)), count(count_) {}
 
         /**
          * @brief Calculate the next resampling weight
@@ -67,8 +69,7 @@ namespace utility::math::stats::resample {
 
     private:
         /// @brief Uniform distribution on the interval [0, 1)
-        std::random_device rd;
-        std::mt19937 gen;
+        Xoshiro256PlusPlus& gen;
         std::uniform_real_distribution<Scalar> dist;
 
         /// @brief Number of particles being resampled
@@ -87,6 +88,20 @@ namespace utility::math::stats::resample {
         return resample<Stratified>(count, std::forward<Iterator>(begin), std::forward<Iterator>(end));
     }
 
+    /**
+     * @brief Call the resampler algorithm using the above resampling weight calculation, without allocating
+     *
+     * @param count Number of particles being resampled
+     * @param begin Iterator to the first weight to use for resampling
+     * @param end Iterator to the last weight to use for resampling
+     * @param gen The random number generator to draw from
+     * @param idx The indices of the resampled particles are appended to this list
+     */
+    template <typename Iterator>
+    void stratified(const int& count, Iterator begin, Iterator end, Xoshiro256PlusPlus& gen, std::vector<int>& idx) {
+        resample<Stratified>(count, begin, end, gen, idx);
+    }
+
 }  // namespace utility::math::stats::resample
 
 #endif  // UTILITY_MATH_STATS_RESAMPLE_STRATIFED_HPP
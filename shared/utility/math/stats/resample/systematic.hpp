@@ -53,9 +53,10 @@ namespace utility::math::stats::resample {
          * @brief Systematic resampling weight generator
          *
          * @param count_ Number of particles being resampled
+         * @param gen The random number generator to draw the offset from
          */
-        Systematic(const int& count_)
-            : gen((std::random_device()())), dist(Scalar(0.0), Scalar(1.0)), count(count_), rng(dist(gen)) {}
+        Systematic(const int& count_, Xoshiro256PlusPlus& gen)
+            : count(count_), rng(std::uniform_real_distribution<Scalar>(Scalar(0.0), Scalar(1.0))(gen)) {}
 
         /**
          * @brief Calculate the next resampling weight
@@ -67,10 +68,6 @@ namespace utility::math::stats::resample {
         }
 
     private:
-        /// @brief Uniform distribution on the interval [0, 1)
-        std::mt19937 gen;
-        std::uniform_real_distribution<Scalar> dist;
-
         /// @brief Number of particles being resampled
         Scalar count;
         /// @brief Systematic resampling uses a static weight offset
@@ -89,6 +86,20 @@ namespace utility::math::stats::resample {
         return resample<Systematic>(count, std::forward<Iterator>(begin), std::forward<Iterator>(end));
     }
 
+    /**
+     * @brief Call the resampler algorithm using the above resampling weight calculation, without allocating
+     *
+     * @param count Number of particles being resampled
+     * @param begin Iterator to the first weight to use for resampling
+     * @param end Iterator to the last weight to use for resampling
+     * @param gen The random number generator to draw from
+     * @param idx The indices of the resampled particles are appended to this list
+     */
+    template <typename Iterator>
+    void systematic(const int& count, Iterator begin, Iterator end, Xoshiro256PlusPlus& gen, std::vector<int>& idx) {
+        resample<Systematic>(count, begin, end, gen, idx);
+    }
+
 }  // namespace utility::math::stats::resample
 
 #endif  // UTILITY_MATH_FILTER_RESAMPLE_SYSTEMATIC_HPP
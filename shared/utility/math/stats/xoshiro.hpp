@@ -0,0 +1,117 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef UTILITY_MATH_STATS_XOSHIRO_HPP
+#define UTILITY_MATH_STATS_XOSHIRO_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace utility::math::stats {
+
+    /**
+     * @brief The xoshiro256++ pseudo random number generator
+     *
+     * @details A small and fast generator with 256 bits of state and good statistical quality, see
+     * https://prng.di.unimi.it/. It meets the requirements of UniformRandomBitGenerator so it can be used with the
+     * standard library distributions in place of std::mt19937, which has 5 KB of state that must be initialised on
+     * construction.
+     */
+    class Xoshiro256PlusPlus {
+    public:
+        using result_type = uint64_t;
+
+        /**
+         * @brief Construct the generator with the given seed
+         *
+         * @param seed The seed is expanded into the full state using splitmix64, so any value including zero is valid
+         */
+        explicit Xoshiro256PlusPlus(const uint64_t& seed = 0x9E3779B97F4A7C15ULL) {
+            this->seed(seed);
+        }
+
+        /// @brief Reseed the generator, expanding the seed into the full state using splitmix64
+        void seed(uint64_t seed) {
+            for (auto& s : state) {
+                seed += 0x9E3779B97F4A7C15ULL;
+                uint64_t z = seed;
+                z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z          = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                s          = z ^ (z >> 31);
+            }
+        }
+
+        static constexpr result_type min() {
+            return std::numeric_limits<result_type>::min();
+        }
+
+        static constexpr result_type max() {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        result_type operator()() {
+            const uint64_t result = rotl(state[0] + state[3], 23) + state[0];
+            const uint64_t t      = state[1] << 17;
+
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = rotl(state[3], 45);
+
+            return result;
+        }
+
+    private:
+        static constexpr uint64_t rotl(const uint64_t& x, const int& k) {
+            return (x << k) | (x >> (64 - k));
+        }
+
+        /// @brief The 256 bits of generator state
+        std::array<uint64_t, 4> state{};
+    };
+
+    /**
+     * @brief A generator for the calling thread, seeded from std::random_device the first time it is used
+     *
+     * @details This lets short lived objects that need random numbers share one generator rather than paying for a
+     * random_device read and a generator initialisation every time one is constructed
+     */
+    inline Xoshiro256PlusPlus& thread_generator() {
+        thread_local Xoshiro256PlusPlus gen([] {
+            std::random_device rd;
+            return (uint64_t(rd()) << 32) | uint64_t(rd());
+        }());
+        return gen;
+    }
+
+}  // namespace utility::math::stats
+
+#endif  // UTILITY_MATH_STATS_XOSHIRO_HPP
@@ -30,11 +30,11 @@
 #include <filesystem>
 #include <functional>
 #include <map>
-#include <mio/mmap.hpp>
 #include <nuclear>
 #include <numeric>
 #include <vector>
 
+#include "Frame.hpp"
 #include "Index.hpp"
 
 namespace utility::nbs {
@@ -44,10 +44,9 @@ namespace utility::nbs {
         const std::function<void(const std::filesystem::path&, const uint64_t&, const uint64_t&)>& progress)
         : index(paths, progress) {
 
-        // Memory map all the files so we can access the data
+        // Open all the files so we can access the data
         for (const auto& path : paths) {
-            // Memory map the file into ram
-            mmaps.emplace_back(path.string());
+            readers.emplace_back(path);
         }
     }
 
@@ -61,10 +60,10 @@ namespace utility::nbs {
 
         // Work out the total number of bytes to be handled from all the files
         uint64_t total_bytes =
-            std::accumulate(mmaps.begin(),
-                            mmaps.end(),
+            std::accumulate(readers.begin(),
+                            readers.end(),
                             uint64_t(0),
-                            [&](const uint64_t& a, const mio::ummap_source& b) { return a + b.size(); });
+                            [&](const uint64_t& a, const FrameReader& b) { return a + b.size(); });
         uint64_t total_messages = std::distance(index.begin(), index.end());
 
         // Loop through the index
@@ -74,8 +73,8 @@ namespace utility::nbs {
 
             // Skip decoding packets that we don't have a callback for
             if (callbacks.count(i.type) != 0) {
-                // Where our data is in mapped memory
-                const uint8_t* data = &mmaps[i.fileno][i.offset];
+                // Where our data is in mapped memory, or in the frame it was decompressed into
+                const uint8_t* data = readers[i.fileno].at(i.offset);
 
                 // Read out the length from the packet
                 uint32_t length    = *reinterpret_cast<const uint32_t*>(data + 3);
@@ -30,10 +30,10 @@
 #include <filesystem>
 #include <functional>
 #include <map>
-#include <mio/mmap.hpp>
 #include <nuclear>
 #include <vector>
 
+#include "Frame.hpp"
 #include "Index.hpp"
 
 namespace utility::nbs {
@@ -61,9 +61,10 @@ namespace utility::nbs {
          *      NUClear::clock::time_point The timestamp that was provided from the nbs index, this will be the
          *      timestamp that was stored in the message, or if unavailable the timestamp from the nbs file's emit time
          *
-         *      const uint8_t* the pointer to the memory mapped location where the packet begins
+         *      const uint8_t* the pointer to where the payload begins, either in the memory mapped file or in the
+         *      decompressed frame of a block compressed file
          *
-         *      const uint32_t& the length of the packet that is stored in that memory mapped location
+         *      const uint32_t& the length of the payload
          *
          * @tparam MessageType the message type to set the callback for
          *
@@ -130,8 +131,8 @@ namespace utility::nbs {
     private:
         /// The index that has been constructed from the loaded nbs files
         Index index;
-        /// The memory mapped IO nbs files
-        std::vector<mio::ummap_source> mmaps;
+        /// Readers for the plain or block compressed nbs files
+        std::vector<FrameReader> readers;
         /// The map of callbacks that will be executed when a message of the appropriate hash type is found
         std::map<uint64_t,
                  std::function<void(const NUClear::clock::time_point&,
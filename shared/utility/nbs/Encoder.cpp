@@ -26,12 +26,98 @@
  */
 #include "Encoder.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fmt/format.h>
+#include <stdexcept>
+#include <zstd.h>
+
 namespace utility::nbs {
 
-    Encoder::Encoder(std::filesystem::path path) : output_file(path), index_file(path += ".idx") {}
+    Encoder::Encoder(std::filesystem::path path, const uint32_t& frame_size)
+        : output_file(path), index_file(path += ".idx"), frame_size(frame_size) {}
+
+    Encoder::Encoder(const std::filesystem::path& path,
+                     const std::filesystem::path& index_path,
+                     const uint32_t& frame_size)
+        : output_file(path), index_file(index_path), frame_size(frame_size) {}
+
+    Encoder::~Encoder() {
+        close();
+    }
+
+    void Encoder::put(const void* data, const size_t& length) {
+        if (frame_size == 0) {
+            output_file.write(reinterpret_cast<const char*>(data), length);
+        }
+        else {
+            const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+            frame_buffer.insert(frame_buffer.end(), bytes, bytes + length);
+        }
+    }
 
-    Encoder::Encoder(const std::filesystem::path& path, const std::filesystem::path& index_path)
-        : output_file(path), index_file(index_path) {}
+    void Encoder::put_index(const IndexItem& entry) {
+        // The fileno is only used in memory so it isn't written to the index file
+        const auto* bytes        = reinterpret_cast<const char*>(&entry);
+        constexpr size_t n_bytes = sizeof(IndexItem) - sizeof(IndexItem::fileno);
+
+        if (frame_size == 0) {
+            index_file.write(bytes, n_bytes);
+        }
+        else {
+            index_buffer.insert(index_buffer.end(), bytes, bytes + n_bytes);
+        }
+    }
+
+    void Encoder::end_packet(const uint64_t& timestamp_us, const uint64_t& hash) {
+        if (frame_size == 0) {
+            return;
+        }
+
+        frame.start = std::min(frame.start, timestamp_us);
+        frame.end   = std::max(frame.end, timestamp_us);
+        frame.types[hash]++;
+
+        if (frame_buffer.size() >= frame_size) {
+            flush_frame();
+        }
+    }
+
+    void Encoder::flush_frame() {
+        if (frame_buffer.empty()) {
+            return;
+        }
+
+        std::vector<char> compressed(ZSTD_compressBound(frame_buffer.size()));
+        size_t n = ZSTD_compress(compressed.data(),
+                                 compressed.size(),
+                                 frame_buffer.data(),
+                                 frame_buffer.size(),
+                                 ZSTD_CLEVEL_DEFAULT);
+        if (ZSTD_isError(n) != 0) {
+            throw std::runtime_error(fmt::format("Failed to compress nbs frame: {}", ZSTD_getErrorName(n)));
+        }
+        output_file.write(compressed.data(), n);
+        output_file.flush();
+
+        // Only now that the packets are in the file can the index point at them, so if recording stops before the
+        // next frame is written the index doesn't point past the end of the file
+        index_file.write(index_buffer.data(), std::streamsize(index_buffer.size()));
+        index_file.flush();
+        index_buffer.clear();
+
+        frame.offset            = file_offset;
+        frame.compressed_size   = n;
+        frame.uncompressed_size = frame_buffer.size();
+        frames.push_back(frame);
+        file_offset += n;
+
+        // The next frame starts where this one ends
+        frame                     = Frame();
+        frame.uncompressed_offset = bytes_written;
+        frame_buffer.clear();
+    }
 
     int Encoder::write(const NUClear::clock::time_point& timestamp,
                        const uint64_t& message_timestamp,
@@ -56,22 +142,23 @@ namespace utility::nbs {
         uint32_t size = data.size() + sizeof(hash) + sizeof(timestamp_us);
 
         // Write radiation symbol
-        output_file.put(char(0xE2));
-        output_file.put(char(0x98));
-        output_file.put(char(0xA2));
+        const std::array<uint8_t, HEADER_SIZE> header = {0xE2, 0x98, 0xA2};
+        put(header.data(), header.size());
 
         // Write the size of the packet
-        output_file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        put(&size, sizeof(size));
 
         // Write the timestamp
-        output_file.write(reinterpret_cast<const char*>(&timestamp_us), sizeof(timestamp_us));
+        put(&timestamp_us, sizeof(timestamp_us));
 
         // Write the hash
-        output_file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+        put(&hash, sizeof(hash));
 
-        // Write the actual packet data
-        output_file.write(reinterpret_cast<const char*>(data.data()), data.size());
-        output_file.flush();
+        // Write the actual packet data, a block compressed file is flushed once the whole frame is written instead
+        put(data.data(), data.size());
+        if (frame_size == 0) {
+            output_file.flush();
+        }
 
         // NBS Index File Format
         // Name      | Type               |  Description
@@ -85,15 +172,35 @@ namespace utility::nbs {
         // Calculate the NBS Packets full size
         uint32_t full_size = HEADER_SIZE + sizeof(size) + size;
 
-        index_file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
-        index_file.write(reinterpret_cast<const char*>(&id), sizeof(id));
-        index_file.write(reinterpret_cast<const char*>(&message_timestamp), sizeof(message_timestamp));
-        index_file.write(reinterpret_cast<const char*>(&bytes_written), sizeof(bytes_written));
-        index_file.write(reinterpret_cast<const char*>(&full_size), sizeof(full_size));
-        index_file.flush();
+        put_index(IndexItem{hash, id, message_timestamp, bytes_written, full_size, 0});
+        if (frame_size == 0) {
+            index_file.flush();
+        }
 
         // Update the number of bytes we have written to the nbs file
         bytes_written += full_size;
+        end_packet(timestamp_us, hash);
+
+        return bytes_written;
+    }
+
+    int Encoder::write(const IndexItem& item, const uint8_t* packet) {
+        // The packet already has its header, timestamp and hash so it goes straight into the file
+        put(packet, item.length);
+
+        // Same index format as above, only the offset changes
+        IndexItem entry = item;
+        entry.offset    = bytes_written;
+        put_index(entry);
+
+        bytes_written += item.length;
+
+        // The emit timestamp and hash come after the header and length
+        uint64_t timestamp_us = 0;
+        uint64_t hash         = 0;
+        std::memcpy(&timestamp_us, packet + HEADER_SIZE + sizeof(uint32_t), sizeof(timestamp_us));
+        std::memcpy(&hash, packet + HEADER_SIZE + sizeof(uint32_t) + sizeof(timestamp_us), sizeof(hash));
+        end_packet(timestamp_us, hash);
 
         return bytes_written;
     }
@@ -104,6 +211,11 @@ namespace utility::nbs {
 
     void Encoder::close() {
         if (output_file.is_open()) {
+            if (frame_size != 0) {
+                flush_frame();
+                write_frame_table(output_file, frames, file_offset);
+                frames.clear();
+            }
             output_file.close();
         }
         if (index_file.is_open()) {
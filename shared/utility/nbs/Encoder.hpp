@@ -32,6 +32,11 @@
 #include <nuclear>
 #include <zstr.hpp>
 
+#include "Frame.hpp"
+#include "Index.hpp"
+#include "get_id.hpp"
+#include "get_timestamp.hpp"
+
 namespace utility::nbs {
 
     class Encoder {
@@ -42,21 +47,62 @@ namespace utility::nbs {
         std::ofstream output_file{};
         /// The file we are outputting our index to currently
         zstr::ofstream index_file{};
-        /// The number of bytes written to the nbs file
+        /// The number of bytes written to the nbs file, for a block compressed file this is before compression
         uint64_t bytes_written = 0;
+        /// The uncompressed size each frame is filled to before it is compressed, 0 for a plain nbs file
+        uint32_t frame_size = 0;
+        /// Packets waiting to be compressed into the next frame
+        std::vector<uint8_t> frame_buffer{};
+        /// The details of the frame that is being filled
+        Frame frame{};
+        /// The frames that have been written to the file so far
+        std::vector<Frame> frames{};
+        /// Index entries for the packets in the frame being filled, only written once their frame is in the file
+        std::vector<char> index_buffer{};
+        /// The number of compressed bytes written to the nbs file
+        uint64_t file_offset = 0;
+
+        /// @brief Writes raw bytes to the file, or to the frame buffer if compressing
+        void put(const void* data, const size_t& length);
+
+        /// @brief Writes an index entry to the index file, or holds it until its frame is written if compressing
+        void put_index(const IndexItem& entry);
+
+        /// @brief Records a packet in the current frame and compresses the frame once it is full
+        void end_packet(const uint64_t& timestamp_us, const uint64_t& hash);
+
+        /// @brief Compresses the frame buffer and writes it to the file
+        void flush_frame();
 
     public:
         Encoder() = default;
 
-        Encoder(std::filesystem::path path);
+        /**
+         * @brief Opens an nbs file for writing along with its index file at path.idx
+         *
+         * @param path       the path to the nbs file
+         * @param frame_size if not 0 the file is block compressed, with packets gathered into zstd frames of about
+         *                   this many uncompressed bytes
+         */
+        Encoder(std::filesystem::path path, const uint32_t& frame_size = 0);
 
-        Encoder(const std::filesystem::path& path, const std::filesystem::path& index_path);
+        Encoder(const std::filesystem::path& path,
+                const std::filesystem::path& index_path,
+                const uint32_t& frame_size = 0);
+
+        Encoder(const Encoder&)            = delete;
+        Encoder(Encoder&&)                 = delete;
+        Encoder& operator=(const Encoder&) = delete;
+        Encoder& operator=(Encoder&&)      = delete;
+
+        /// @brief Closes the file, which writes the last frame and the frame table of a block compressed file
+        ~Encoder();
 
         /// @brief Write a neutron to the file and returns the number of bytes written
         template <typename T>
         int write(const T& value, const NUClear::clock::time_point& timestamp) {
             return write(timestamp,
-                         get_timestamp(value, timestamp),
+                         get_timestamp(timestamp, value),
                          NUClear::util::serialise::Serialise<T>::hash(),
                          get_id(value),
                          NUClear::util::serialise::Serialise<T>::serialise(value));
@@ -77,10 +123,21 @@ namespace utility::nbs {
                   const uint32_t& id,
                   const std::vector<uint8_t>& data);
 
-        /// @brief Gets the number of bytes written
+        /**
+         * @brief Copies a packet that is already in nbs format, such as one memory mapped from another nbs file
+         *
+         * The packet is copied as is without being decoded. Its index entry is written with the offset it now has in
+         * this file.
+         *
+         * @param item   the index entry for the packet
+         * @param packet the packet starting at its radiation symbol, item.length bytes long
+         */
+        int write(const IndexItem& item, const uint8_t* packet);
+
+        /// @brief Gets the number of bytes written, before compression for a block compressed file
         const uint64_t& get_bytes_written() const;
 
-        /// @brief closes the internal nbs file
+        /// @brief closes the internal nbs file, writing the frame table first if it is block compressed
         void close();
 
         void open(const std::filesystem::path& path);
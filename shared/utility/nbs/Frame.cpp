@@ -0,0 +1,245 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "Frame.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fmt/format.h>
+#include <iterator>
+#include <stdexcept>
+#include <zstd.h>
+
+namespace utility::nbs {
+
+    namespace {
+        /// The first four bytes of every zstd frame
+        constexpr std::array<uint8_t, 4> ZSTD_FRAME_MAGIC = {0x28, 0xB5, 0x2F, 0xFD};
+
+        /// The size of the footer after the frame table
+        constexpr uint64_t FOOTER_SIZE = sizeof(uint64_t) + sizeof(uint64_t) + FRAME_TABLE_MAGIC.size();
+
+        template <typename T>
+        void put(std::ostream& out, const T& value) {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        T get(const uint8_t*& p, const uint8_t* end) {
+            if (p + sizeof(T) > end) {
+                throw std::runtime_error("The nbs frame table is truncated");
+            }
+            T value;
+            std::memcpy(&value, p, sizeof(T));
+            p += sizeof(T);
+            return value;
+        }
+
+        /// Rebuilds the frame table of a file that has no table by walking the zstd frame headers
+        std::vector<Frame> recover_frames(const uint8_t* data, const uint64_t& size) {
+            std::vector<Frame> frames;
+            uint64_t offset              = 0;
+            uint64_t uncompressed_offset = 0;
+            while (offset + ZSTD_FRAME_MAGIC.size() <= size
+                   && std::equal(ZSTD_FRAME_MAGIC.begin(), ZSTD_FRAME_MAGIC.end(), data + offset)) {
+                size_t compressed_size = ZSTD_findFrameCompressedSize(data + offset, size - offset);
+                if (ZSTD_isError(compressed_size) != 0) {
+                    // The last frame was only partly written
+                    break;
+                }
+                uint64_t uncompressed_size = ZSTD_getFrameContentSize(data + offset, compressed_size);
+                if (uncompressed_size == ZSTD_CONTENTSIZE_UNKNOWN || uncompressed_size == ZSTD_CONTENTSIZE_ERROR) {
+                    break;
+                }
+
+                Frame frame;
+                frame.offset              = offset;
+                frame.compressed_size     = compressed_size;
+                frame.uncompressed_offset = uncompressed_offset;
+                frame.uncompressed_size   = uncompressed_size;
+                frames.push_back(frame);
+
+                offset += compressed_size;
+                uncompressed_offset += uncompressed_size;
+            }
+            return frames;
+        }
+    }  // namespace
+
+    void write_frame_table(std::ostream& out, const std::vector<Frame>& frames, const uint64_t& table_at) {
+        // Frame Table Entry Format
+        // Name                | Type                |  Description
+        // ------------------------------------------------------------
+        // offset              | uint64_t            | offset of the compressed frame from the start of the file
+        // compressed_size     | uint32_t            | size of the compressed frame
+        // uncompressed_offset | uint64_t            | offset of the frame in the uncompressed stream
+        // uncompressed_size   | uint32_t            | size of the frame once decompressed
+        // start               | uint64_t            | earliest emit timestamp in the frame in microseconds
+        // end                 | uint64_t            | latest emit timestamp in the frame in microseconds
+        // n_types             | uint32_t            | number of type counts that follow
+        // types               | {uint64_t, uint32_t}| the type hash and the number of packets of that type
+        for (const auto& frame : frames) {
+            put(out, frame.offset);
+            put(out, frame.compressed_size);
+            put(out, frame.uncompressed_offset);
+            put(out, frame.uncompressed_size);
+            put(out, frame.start);
+            put(out, frame.end);
+            put(out, uint32_t(frame.types.size()));
+            for (const auto& [hash, count] : frame.types) {
+                put(out, hash);
+                put(out, count);
+            }
+        }
+        put(out, table_at);
+        put(out, uint64_t(frames.size()));
+        out.write(FRAME_TABLE_MAGIC.data(), FRAME_TABLE_MAGIC.size());
+    }
+
+    std::optional<std::vector<Frame>> read_frame_table(const uint8_t* data, const uint64_t& size) {
+
+        // Without a footer this is either a plain file or a compressed file that was never closed
+        if (size < FOOTER_SIZE
+            || !std::equal(FRAME_TABLE_MAGIC.begin(),
+                           FRAME_TABLE_MAGIC.end(),
+                           reinterpret_cast<const char*>(data + size - FRAME_TABLE_MAGIC.size()))) {
+            if (size >= ZSTD_FRAME_MAGIC.size() && std::equal(ZSTD_FRAME_MAGIC.begin(), ZSTD_FRAME_MAGIC.end(), data)) {
+                return recover_frames(data, size);
+            }
+            return std::nullopt;
+        }
+
+        const uint8_t* footer   = data + size - FOOTER_SIZE;
+        const uint64_t table_at = get<uint64_t>(footer, data + size);
+        const uint64_t n_frames = get<uint64_t>(footer, data + size);
+        if (table_at > size - FOOTER_SIZE) {
+            throw std::runtime_error(fmt::format("The nbs frame table offset {} is past the end of file", table_at));
+        }
+
+        const uint8_t* p   = data + table_at;
+        const uint8_t* end = data + size - FOOTER_SIZE;
+        std::vector<Frame> frames;
+        for (uint64_t i = 0; i < n_frames; ++i) {
+            Frame frame;
+            frame.offset              = get<uint64_t>(p, end);
+            frame.compressed_size     = get<uint32_t>(p, end);
+            frame.uncompressed_offset = get<uint64_t>(p, end);
+            frame.uncompressed_size   = get<uint32_t>(p, end);
+            frame.start               = get<uint64_t>(p, end);
+            frame.end                 = get<uint64_t>(p, end);
+            const auto n_types        = get<uint32_t>(p, end);
+            for (uint32_t j = 0; j < n_types; ++j) {
+                const auto hash   = get<uint64_t>(p, end);
+                frame.types[hash] = get<uint32_t>(p, end);
+            }
+            if (frame.offset + frame.compressed_size > table_at) {
+                throw std::runtime_error(fmt::format("nbs frame {} runs past the start of the frame table", i));
+            }
+            frames.push_back(std::move(frame));
+        }
+        return frames;
+    }
+
+    FrameReader::FrameReader(const std::filesystem::path& path)
+        : mmap(path.string()), table(read_frame_table(mmap.data(), mmap.size())) {}
+
+    bool FrameReader::compressed() const {
+        return table.has_value();
+    }
+
+    uint64_t FrameReader::size() const {
+        if (!table) {
+            return mmap.size();
+        }
+        return table->empty() ? 0 : table->back().uncompressed_offset + table->back().uncompressed_size;
+    }
+
+    const std::vector<Frame>& FrameReader::frames() const {
+        static const std::vector<Frame> none;
+        return table ? *table : none;
+    }
+
+    size_t FrameReader::n_frames() const {
+        return table ? table->size() : 1;
+    }
+
+    std::pair<const uint8_t*, uint64_t> FrameReader::frame(const size_t& i) {
+        if (!table) {
+            return {mmap.data(), mmap.size()};
+        }
+
+        const Frame& f = table->at(i);
+
+        // Move the frame to the front if we already have it
+        auto it = std::find_if(cache.begin(), cache.end(), [&](const auto& c) { return c.first == i; });
+        if (it != cache.end()) {
+            cache.splice(cache.begin(), cache, it);
+            return {cache.front().second.data(), f.uncompressed_size};
+        }
+
+        // Reuse the buffer of the least recently used frame once the cache is full
+        if (cache.size() < CACHED_FRAMES) {
+            cache.emplace_front();
+        }
+        else {
+            cache.splice(cache.begin(), cache, std::prev(cache.end()));
+        }
+        auto& [index, buffer] = cache.front();
+
+        buffer.resize(f.uncompressed_size);
+        size_t n = ZSTD_decompress(buffer.data(), buffer.size(), mmap.data() + f.offset, f.compressed_size);
+        if (ZSTD_isError(n) != 0 || n != f.uncompressed_size) {
+            cache.pop_front();
+            throw std::runtime_error(fmt::format("Failed to decompress nbs frame {}: {}",
+                                                 i,
+                                                 ZSTD_isError(n) != 0 ? ZSTD_getErrorName(n) : "wrong size"));
+        }
+        index = i;
+        return {buffer.data(), f.uncompressed_size};
+    }
+
+    const uint8_t* FrameReader::at(const uint64_t& offset) {
+        if (!table) {
+            return mmap.data() + offset;
+        }
+
+        // Find the last frame that starts at or before this offset
+        auto it = std::upper_bound(table->begin(),
+                                   table->end(),
+                                   offset,
+                                   [](const uint64_t& o, const Frame& f) { return o < f.uncompressed_offset; });
+        if (it == table->begin()) {
+            throw std::out_of_range(fmt::format("Offset {} is not in any nbs frame", offset));
+        }
+        --it;
+        if (offset >= it->uncompressed_offset + it->uncompressed_size) {
+            throw std::out_of_range(fmt::format("Offset {} is not in any nbs frame", offset));
+        }
+
+        return frame(std::distance(table->begin(), it)).first + (offset - it->uncompressed_offset);
+    }
+
+}  // namespace utility::nbs
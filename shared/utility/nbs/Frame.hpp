@@ -0,0 +1,162 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UTILITY_NBS_FRAME_HPP
+#define UTILITY_NBS_FRAME_HPP
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <list>
+#include <map>
+#include <mio/mmap.hpp>
+#include <optional>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace utility::nbs {
+
+    /**
+     * A block compressed nbs file is a series of independently compressed zstd frames followed by a frame table.
+     * Every frame holds whole nbs packets, so decompressing all the frames in order gives back a plain nbs file.
+     * Offsets in the index of a block compressed file are offsets into that uncompressed stream.
+     *
+     * Name      | Type       |  Description
+     * ------------------------------------------------------------
+     * frames    | uint8_t[]  | the zstd frames one after another
+     * table     | Frame[]    | one entry per frame, see write_frame_table
+     * table_at  | uint64_t   | offset of the frame table from the start of the file
+     * n_frames  | uint64_t   | the number of entries in the frame table
+     * magic     | char[8]    | FRAME_TABLE_MAGIC
+     */
+    constexpr std::array<char, 8> FRAME_TABLE_MAGIC = {'N', 'B', 'S', 'F', 'R', 'A', 'M', 'E'};
+
+    /// The default number of uncompressed bytes that are gathered before a frame is compressed
+    constexpr uint32_t DEFAULT_FRAME_SIZE = 2 * 1024 * 1024;
+
+    struct Frame {
+        /// Offset of the compressed frame from the start of the file
+        uint64_t offset = 0;
+        /// The size of the compressed frame
+        uint32_t compressed_size = 0;
+        /// Offset of the first packet of this frame in the uncompressed stream
+        uint64_t uncompressed_offset = 0;
+        /// The size of the frame once it has been decompressed
+        uint32_t uncompressed_size = 0;
+        /// The earliest emit timestamp of a packet in this frame in microseconds
+        uint64_t start = std::numeric_limits<uint64_t>::max();
+        /// The latest emit timestamp of a packet in this frame in microseconds
+        uint64_t end = 0;
+        /// The number of packets of each type hash that are in this frame
+        std::map<uint64_t, uint32_t> types;
+    };
+
+    /**
+     * @brief Writes the frame table and the footer that marks a file as block compressed
+     *
+     * @param out       the stream to write to, positioned directly after the last frame
+     * @param frames    the frames that have been written to the file
+     * @param table_at  the offset in the file that the table is being written at
+     */
+    void write_frame_table(std::ostream& out, const std::vector<Frame>& frames, const uint64_t& table_at);
+
+    /**
+     * @brief Reads the frame table of a block compressed nbs file
+     *
+     * If the file starts with a zstd frame but has no table, for example because the recording was not closed
+     * cleanly, the frames are recovered by walking the zstd frame headers. Frames recovered this way have no time
+     * range or type counts.
+     *
+     * @param data the contents of the file
+     * @param size the size of the file in bytes
+     *
+     * @return the frames in the file, or nullopt if this is a plain nbs file
+     */
+    std::optional<std::vector<Frame>> read_frame_table(const uint8_t* data, const uint64_t& size);
+
+    /**
+     * @brief Gives access to the packets of a plain or block compressed nbs file by their uncompressed offset
+     *
+     * Plain files are read straight from the memory map. For block compressed files only the frame holding the
+     * requested offset is decompressed. The most recently used frames are kept, so reading packets in order only
+     * decompresses each frame once, and reads that move back and forth between a few frames don't decompress them
+     * again each time.
+     */
+    class FrameReader {
+    public:
+        explicit FrameReader(const std::filesystem::path& path);
+
+        /// @brief If this file is block compressed
+        [[nodiscard]] bool compressed() const;
+
+        /// @brief The size of the file once it has been decompressed
+        [[nodiscard]] uint64_t size() const;
+
+        /// @brief The frames of this file, empty for plain nbs files
+        [[nodiscard]] const std::vector<Frame>& frames() const;
+
+        /**
+         * @brief Gets the packet data at an offset in the uncompressed stream
+         *
+         * Packets never cross a frame boundary so the whole packet starting at offset is available. The returned
+         * pointer is valid until the next call to at or frame.
+         *
+         * @param offset the offset of the data in the uncompressed stream
+         *
+         * @return a pointer to the data at that offset
+         */
+        const uint8_t* at(const uint64_t& offset);
+
+        /**
+         * @brief Gets the whole decompressed contents of a frame
+         *
+         * A plain nbs file is treated as a single frame holding the whole file.
+         *
+         * @param i the index of the frame
+         *
+         * @return a pointer to the start of the frame and its uncompressed size
+         */
+        std::pair<const uint8_t*, uint64_t> frame(const size_t& i);
+
+        /// @brief The number of frames that can be read with frame, 1 for a plain nbs file
+        [[nodiscard]] size_t n_frames() const;
+
+    private:
+        /// The memory mapped nbs file
+        mio::ummap_source mmap;
+        /// The frame table if this file is block compressed
+        std::optional<std::vector<Frame>> table;
+        /// The most decompressed frames that are kept at once
+        static constexpr size_t CACHED_FRAMES = 4;
+        /// The index and decompressed contents of recently used frames, most recently used first
+        std::list<std::pair<size_t, std::vector<uint8_t>>> cache;
+    };
+
+}  // namespace utility::nbs
+
+#endif  // UTILITY_NBS_FRAME_HPP
@@ -29,9 +29,9 @@
 #include <algorithm>
 #include <fmt/format.h>
 #include <fstream>
-#include <mio/mmap.hpp>
 #include <zstr.hpp>
 
+#include "Frame.hpp"
 #include "message/reflection.hpp"
 
 namespace utility::nbs {
@@ -115,58 +115,65 @@ namespace utility::nbs {
         // timestamp | uint64_t           | Timestamp the data was emitted in microseconds
         // hash      | uint64_t           | the 64bit hash for the payload type
         // payload   | char[length - 16]  | the data payload
-        mio::ummap_source nbs(nbs_path.string());
+        FrameReader nbs(nbs_path);
         zstr::ofstream idx(idx_path);
 
-        enum State { INITIAL, HEADER_1, HEADER_2, PAYLOAD } state = INITIAL;
-
-        for (uint64_t p = 0; p < nbs.size();) {
-
-            switch (state) {
-                case INITIAL: state = nbs[p++] == 0xE2 ? HEADER_1 : INITIAL; break;
-                case HEADER_1: state = nbs[p++] == 0x98 ? HEADER_2 : INITIAL; break;
-                case HEADER_2: state = nbs[p++] == 0xA2 ? PAYLOAD : INITIAL; break;
-                case PAYLOAD: {
-                    // We always go back to initial after a payload
-                    state = INITIAL;
-
-                    // Where this packet starts
-                    uint64_t offset = p - 3;
-
-                    // Read the header of the packet
-                    uint32_t size = *reinterpret_cast<uint32_t*>(&nbs[p]);
-                    p += sizeof(size);
-                    uint64_t timestamp = *reinterpret_cast<uint64_t*>(&nbs[p]);
-                    p += sizeof(timestamp);
-                    uint64_t hash = *reinterpret_cast<uint64_t*>(&nbs[p]);
-                    p += sizeof(hash);
-
-                    // Payload data
-                    const uint8_t* payload  = &nbs[p];
-                    uint32_t payload_length = size - sizeof(timestamp) - sizeof(hash);
-                    p += payload_length;
-
-                    // Use reflection to extract the id from messages that have them
-                    auto sr     = message::reflection::from_hash<IdReflector>(hash);
-                    uint32_t id = sr->id(payload, payload_length);
-
-                    // Use reflection to extract the timestamp from messages that have them or just return the timestamp
-                    // from the nbs file if the message type doesn't have one
-                    auto tr   = message::reflection::from_hash<TimestampReflector>(hash);
-                    timestamp = tr->timestamp(timestamp, payload, payload_length);
-
-                    // Write the data to the index file
-                    idx.write(reinterpret_cast<char*>(&hash), sizeof(hash));
-                    idx.write(reinterpret_cast<char*>(&id), sizeof(id));
-                    idx.write(reinterpret_cast<char*>(&timestamp), sizeof(timestamp));
-                    idx.write(reinterpret_cast<char*>(&offset), sizeof(offset));
-
-                    // We add 3 onto the size field for the length to include the header
-                    uint32_t length = size + 3 + sizeof(uint32_t);
-                    idx.write(reinterpret_cast<char*>(&length), sizeof(length));
-
-                    if (progress) {
-                        progress(nbs_path, p, nbs.size());
+        // A plain file is indexed as one frame, a block compressed file is indexed one decompressed frame at a time
+        // with offsets into the uncompressed stream
+        for (size_t f = 0; f < nbs.n_frames(); ++f) {
+            const uint64_t base    = nbs.compressed() ? nbs.frames()[f].uncompressed_offset : 0;
+            const auto [data, end] = nbs.frame(f);
+
+            enum State { INITIAL, HEADER_1, HEADER_2, PAYLOAD } state = INITIAL;
+
+            for (uint64_t p = 0; p < end;) {
+
+                switch (state) {
+                    case INITIAL: state = data[p++] == 0xE2 ? HEADER_1 : INITIAL; break;
+                    case HEADER_1: state = data[p++] == 0x98 ? HEADER_2 : INITIAL; break;
+                    case HEADER_2: state = data[p++] == 0xA2 ? PAYLOAD : INITIAL; break;
+                    case PAYLOAD: {
+                        // We always go back to initial after a payload
+                        state = INITIAL;
+
+                        // Where this packet starts
+                        uint64_t offset = base + p - 3;
+
+                        // Read the header of the packet
+                        uint32_t size = *reinterpret_cast<const uint32_t*>(&data[p]);
+                        p += sizeof(size);
+                        uint64_t timestamp = *reinterpret_cast<const uint64_t*>(&data[p]);
+                        p += sizeof(timestamp);
+                        uint64_t hash = *reinterpret_cast<const uint64_t*>(&data[p]);
+                        p += sizeof(hash);
+
+                        // Payload data
+                        const uint8_t* payload  = &data[p];
+                        uint32_t payload_length = size - sizeof(timestamp) - sizeof(hash);
+                        p += payload_length;
+
+                        // Use reflection to extract the id from messages that have them
+                        uint32_t id = message::reflection::from_hash<IdReflector>(hash).id(payload, payload_length);
+
+                        // Use reflection to extract the timestamp from messages that have them or just return the
+                        // timestamp from the nbs file if the message type doesn't have one
+                        timestamp = message::reflection::from_hash<TimestampReflector>(hash).timestamp(timestamp,
+                                                                                                       payload,
+                                                                                                       payload_length);
+
+                        // Write the data to the index file
+                        idx.write(reinterpret_cast<char*>(&hash), sizeof(hash));
+                        idx.write(reinterpret_cast<char*>(&id), sizeof(id));
+                        idx.write(reinterpret_cast<char*>(&timestamp), sizeof(timestamp));
+                        idx.write(reinterpret_cast<char*>(&offset), sizeof(offset));
+
+                        // We add 3 onto the size field for the length to include the header
+                        uint32_t length = size + 3 + sizeof(uint32_t);
+                        idx.write(reinterpret_cast<char*>(&length), sizeof(length));
+
+                        if (progress) {
+                            progress(nbs_path, base + p, nbs.size());
+                        }
                     }
                 }
             }
@@ -190,12 +197,17 @@ namespace utility::nbs {
                 build_index(path, idx_path, progress);
             }
 
+            // A recording that was cut off can have index entries for packets that never made it into the file
+            const uint64_t size = FrameReader(path).size();
+
             // Load the index file
             zstr::ifstream input(idx_path);
-            while (input.good()) {
-                idx.emplace_back();
-                input.read(reinterpret_cast<char*>(&idx.back()), sizeof(IndexItem) - sizeof(IndexItem::fileno));
-                idx.back().fileno = i;
+            IndexItem item{};
+            item.fileno = i;
+            while (input.read(reinterpret_cast<char*>(&item), sizeof(IndexItem) - sizeof(IndexItem::fileno))) {
+                if (item.offset + item.length <= size) {
+                    idx.push_back(item);
+                }
             }
         }
 
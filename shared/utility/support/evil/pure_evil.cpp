@@ -29,17 +29,22 @@
 
 #if !defined(NDEBUG) and !defined(__APPLE__)
 
+    #include <array>
     #include <backtrace.h>
     #include <dlfcn.h>
     #include <iostream>
     #include <nuclear>
+    #include <typeinfo>
 
 namespace utility::support::evil {
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-    thread_local std::vector<utility::support::evil::StackFrame> stack =
-        std::vector<utility::support::evil::StackFrame>();
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-    thread_local std::string exception_name = std::string();
+    namespace {
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+        thread_local std::array<uintptr_t, MAX_FRAMES> pcs{};
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+        thread_local int n_pcs = 0;
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+        thread_local const std::type_info* exception_type = nullptr;
+    }  // namespace
 
 }  // namespace utility::support::evil
 
@@ -100,8 +105,21 @@ int add_backtrace_info_to_vector(void* data, uintptr_t pc, const char* filename,
 }
 
 /**
- * This symbol is here to intercept all exception throwing and extract the
- * stack trace when it happens.
+ * Add the program counter to the buffer for the current exception
+ *
+ * @param pc the program counter
+ *
+ * @return 0 if we should continue, 1 once the buffer is full
+ */
+int add_pc_to_buffer(void* /*data*/, uintptr_t pc) {
+    utility::support::evil::pcs[utility::support::evil::n_pcs++] = pc;
+    return utility::support::evil::n_pcs == utility::support::evil::MAX_FRAMES ? 1 : 0;
+}
+
+/**
+ * This symbol is here to intercept all exception throwing and capture the
+ * stack when it happens. Only the program counters are stored, they are
+ * symbolised later if someone asks for the stack trace.
  *
  * @param ex the exception object
  * @param info the typeinfo of the exception
@@ -111,16 +129,31 @@ int add_backtrace_info_to_vector(void* data, uintptr_t pc, const char* filename,
 // NOLINTNEXTLINE(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
 void __cxa_throw(void* ex, void* info, void (*dest)(void*)) {
 
-    // Demangle our exception name
-    utility::support::evil::exception_name =
-        NUClear::util::demangle(reinterpret_cast<const std::type_info*>(info)->name());
+    // Remember our exception type so we can demangle it if it's needed
+    utility::support::evil::exception_type = reinterpret_cast<const std::type_info*>(info);
 
-    // Perform our full stack backtrace
-    utility::support::evil::stack.clear();
-    backtrace_full(state, 1, add_backtrace_info_to_vector, error_callback, &utility::support::evil::stack);
+    // Unwind the stack to get the program counters
+    utility::support::evil::n_pcs = 0;
+    backtrace_simple(state, 1, add_pc_to_buffer, error_callback, nullptr);
 
     rethrow(ex, info, dest);
 }
 }  // extern "C"
 
+namespace utility::support::evil {
+
+    std::vector<StackFrame> stack() {
+        std::vector<StackFrame> frames;
+        for (int i = 0; i < n_pcs; ++i) {
+            backtrace_pcinfo(state, pcs[i], add_backtrace_info_to_vector, error_callback, &frames);
+        }
+        return frames;
+    }
+
+    std::string exception_name() {
+        return exception_type == nullptr ? std::string() : NUClear::util::demangle(exception_type->name());
+    }
+
+}  // namespace utility::support::evil
+
 #endif  // !defined(NDEBUG) and !defined(__APPLE__)
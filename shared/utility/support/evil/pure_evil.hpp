@@ -50,8 +50,25 @@ namespace utility::support::evil {
         std::string function;
     };
 
-    extern thread_local std::vector<StackFrame> stack;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
-    extern thread_local std::string exception_name;     // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    /// The most frames that are captured when an exception is thrown
+    constexpr int MAX_FRAMES = 64;
+
+    /**
+     * @brief Gets the stack trace of the last exception thrown on this thread
+     *
+     * Only the program counters are captured when the exception is thrown. They are resolved to files, lines and
+     * functions here, so only exceptions that someone looks at pay for it.
+     *
+     * @return the frames of the stack trace that have file and function information
+     */
+    std::vector<StackFrame> stack();
+
+    /**
+     * @brief Gets the demangled type name of the last exception thrown on this thread
+     *
+     * @return the name of the exception type, or an empty string if nothing has been thrown yet
+     */
+    std::string exception_name();
 
 }  // namespace utility::support::evil
 
@@ -24,42 +24,179 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
-#ifndef UTILITY_SUPPORT_MATH_STRING_HPP
-#define UTILITY_SUPPORT_MATH_STRING_HPP
+
+#include "math_string.hpp"
 
 #include <fmt/format.h>
 #include <limits>
+#include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
+#include <unordered_map>
 
 #include "exprtk.hpp"
 
 namespace utility::support {
 
+    namespace {
+
+        /**
+         * Holds the state that is shared between all expression evaluations in the process.
+         *
+         * Our expressions can only reference constants, so once an expression has been compiled its value never
+         * changes and we can store the value rather than the compiled expression object. This also means evaluation
+         * never touches any exprtk state, which is not safe to share between threads.
+         */
+        struct ExpressionCache {
+            ExpressionCache() {
+                // Add constants to the symbol table
+                table.add_constants();
+                table.add_constant("auto", std::numeric_limits<double>::infinity());
+
+                // File size constants
+                table.add_constant("KiB", 1024);        // 2^10
+                table.add_constant("MiB", 1048576);     // 2^20
+                table.add_constant("GiB", 1073741824);  // 2^30
+            }
+
+            /// Guards the symbol table and parser, which are not thread safe
+            std::mutex compile_mutex;
+            /// Constants table shared by every expression that is compiled
+            exprtk::symbol_table<double> table;
+            /// Parser that is reused for every compilation
+            exprtk::parser<double> parser;
+
+            /// Guards the cache of values
+            std::shared_mutex values_mutex;
+            /// The value that each expression string we have seen resolves to
+            std::unordered_map<std::string, double> values;
+        };
+
+        ExpressionCache& cache() {
+            static ExpressionCache instance;
+            return instance;
+        }
+
+        /// Compiles and evaluates a single expression, must be called holding the compile mutex
+        double compile(ExpressionCache& c, const std::string& str) {
+            exprtk::expression<double> expression;
+            expression.register_symbol_table(c.table);
+
+            if (!c.parser.compile(str, expression)) {
+                throw std::invalid_argument(fmt::format("ExprTk failed to parse expression '{}'", str));
+            }
+
+            return expression.value();
+        }
+
+        /// Compiles all the passed expressions as a single expression returning a list of values, must be called
+        /// holding the compile mutex. Falls back to compiling each expression alone if the combined one fails so the
+        /// error message can identify the expression that was at fault
+        std::vector<double> compile(ExpressionCache& c, const std::vector<std::string>& strs) {
+            if (strs.size() == 1) {
+                return {compile(c, strs.front())};
+            }
+
+            std::string combined = "return [";
+            for (size_t i = 0; i < strs.size(); ++i) {
+                combined += fmt::format("{}({})", i == 0 ? "" : ", ", strs[i]);
+            }
+            combined += "];";
+
+            exprtk::expression<double> expression;
+            expression.register_symbol_table(c.table);
+
+            if (c.parser.compile(combined, expression)) {
+                expression.value();
+                auto results = expression.results();
+
+                if (expression.return_invoked() && results.count() == strs.size()) {
+                    std::vector<double> values;
+                    values.reserve(strs.size());
+                    for (size_t i = 0; i < results.count(); ++i) {
+                        using type_t = exprtk::results_context<double>::type_store_t;
+                        if (results[i].type != type_t::e_scalar) {
+                            break;
+                        }
+                        values.push_back(type_t::scalar_view(results[i])());
+                    }
+                    if (values.size() == strs.size()) {
+                        return values;
+                    }
+                }
+            }
+
+            // Something about the combined expression didn't work, do them one at a time
+            std::vector<double> values;
+            values.reserve(strs.size());
+            for (const auto& str : strs) {
+                values.push_back(compile(c, str));
+            }
+            return values;
+        }
+
+    }  // namespace
+
     double parse_to_double(const std::string& str) {
+        auto& c = cache();
 
-        // Add constants to the symbol table
-        exprtk::symbol_table<double> table;
-        table.add_constants();
-        table.add_constant("auto", std::numeric_limits<double>::infinity());
+        /* Mutex Scope */ {
+            std::shared_lock<std::shared_mutex> lock(c.values_mutex);
+            auto it = c.values.find(str);
+            if (it != c.values.end()) {
+                return it->second;
+            }
+        }
+
+        double value = 0.0;
+        /* Mutex Scope */ {
+            std::lock_guard<std::mutex> lock(c.compile_mutex);
+            value = compile(c, str);
+        }
 
-        // File size constants
-        table.add_constant("KiB", 1024);        // 2^10
-        table.add_constant("MiB", 1048576);     // 2^20
-        table.add_constant("GiB", 1073741824);  // 2^30
+        std::lock_guard<std::shared_mutex> lock(c.values_mutex);
+        c.values.emplace(str, value);
+        return value;
+    }
 
-        // Add table to expression
-        exprtk::expression<double> expression;
-        expression.register_symbol_table(table);
+    std::vector<double> parse_to_doubles(const std::vector<std::string>& strs) {
+        auto& c = cache();
 
-        // Add expression to parser and parse
-        exprtk::parser<double> parser;
-        if (!parser.compile(str, expression)) {
-            throw std::invalid_argument(fmt::format("ExprTk failed to parse expression '{}'", str));
+        std::vector<double> result(strs.size());
+
+        // Find the values we already know and the expressions we still need to compile
+        std::vector<std::string> missing;
+        std::vector<size_t> missing_index;
+        /* Mutex Scope */ {
+            std::shared_lock<std::shared_mutex> lock(c.values_mutex);
+            for (size_t i = 0; i < strs.size(); ++i) {
+                auto it = c.values.find(strs[i]);
+                if (it != c.values.end()) {
+                    result[i] = it->second;
+                }
+                else {
+                    missing.push_back(strs[i]);
+                    missing_index.push_back(i);
+                }
+            }
+        }
+
+        if (missing.empty()) {
+            return result;
         }
 
-        return expression.value();
+        std::vector<double> values;
+        /* Mutex Scope */ {
+            std::lock_guard<std::mutex> lock(c.compile_mutex);
+            values = compile(c, missing);
+        }
+
+        std::lock_guard<std::shared_mutex> lock(c.values_mutex);
+        for (size_t i = 0; i < missing.size(); ++i) {
+            result[missing_index[i]] = values[i];
+            c.values.emplace(missing[i], values[i]);
+        }
+        return result;
     }
 
 }  // namespace utility::support
-
-#endif  // UTILITY_SUPPORT_MATH_STRING_HPP
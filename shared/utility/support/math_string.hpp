@@ -28,11 +28,38 @@
 #define UTILITY_SUPPORT_MATH_STRING_HPP
 
 #include <string>
+#include <vector>
 
 namespace utility::support {
 
+    /**
+     * @brief Evaluate a math expression to a double.
+     *
+     * Compiled results are kept in a process wide cache keyed by the expression string, so evaluating the same
+     * expression again (e.g. when a configuration file is reloaded) does not reconstruct the parser.
+     *
+     * @param str the string that represents the mathematical expression
+     *
+     * @return the double that this expression resolves to
+     *
+     * @throws std::invalid_argument if the expression could not be parsed
+     */
     double parse_to_double(const std::string& str);
 
+    /**
+     * @brief Evaluate a list of math expressions to doubles.
+     *
+     * Any expressions that are not already cached are compiled together as a single expression rather than one at a
+     * time, which is useful when loading vectors and matrices.
+     *
+     * @param strs the strings that represent the mathematical expressions
+     *
+     * @return the doubles that each of the expressions resolves to, in the same order as strs
+     *
+     * @throws std::invalid_argument if any of the expressions could not be parsed
+     */
+    std::vector<double> parse_to_doubles(const std::vector<std::string>& strs);
+
     /**
      * @brief Take a math expression as a string and convert it to a Scalar.
      *
@@ -45,6 +72,23 @@ namespace utility::support {
         return Scalar(parse_to_double(str));
     }
 
+    /**
+     * @brief Take a list of math expressions as strings and convert them to Scalars.
+     *
+     * @param strs the strings that represent the mathematical expressions
+     *
+     * @return the values that each of the expressions resolves to, in the same order as strs
+     */
+    template <typename Scalar>
+    std::vector<Scalar> parse_math_strings(const std::vector<std::string>& strs) {
+        std::vector<Scalar> result;
+        result.reserve(strs.size());
+        for (const auto& v : parse_to_doubles(strs)) {
+            result.push_back(Scalar(v));
+        }
+        return result;
+    }
+
 }  // namespace utility::support
 
 #endif  // UTILITY_SUPPORT_MATH_STRING_HPP
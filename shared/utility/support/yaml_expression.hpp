@@ -31,7 +31,9 @@
 #include <Eigen/Core>
 #include <fmt/format.h>
 #include <limits>
+#include <string>
 #include <system_error>
+#include <vector>
 #include <yaml-cpp/yaml.h>
 
 #include "math_string.hpp"
@@ -87,17 +89,20 @@ namespace utility::support {
                                 T::ColsAtCompileTime));
             }
 
-            T matrix;
-
-            try {
-                for (size_t row = 0; row < rows; row++) {
-                    for (size_t col = 0; col < cols; col++) {
-                        matrix(row, col) = parse_math_string<typename T::Scalar>(node[row][col].as<std::string>());
-                    }
+            std::vector<std::string> elements;
+            elements.reserve(rows * cols);
+            for (size_t row = 0; row < rows; row++) {
+                for (size_t col = 0; col < cols; col++) {
+                    elements.push_back(node[row][col].as<std::string>());
                 }
             }
-            catch (const std::invalid_argument& ex) {
-                throw std::invalid_argument(fmt::format("Unable to convert node to arithmetic type.\n{}", ex.what()));
+            const auto values = parse_elements<typename T::Scalar>(elements);
+
+            T matrix;
+            for (size_t row = 0; row < rows; row++) {
+                for (size_t col = 0; col < cols; col++) {
+                    matrix(row, col) = values[row * cols + col];
+                }
             }
 
             return matrix;
@@ -118,15 +123,16 @@ namespace utility::support {
                                 T::RowsAtCompileTime));
             }
 
-            T matrix;
-
-            try {
-                for (size_t i = 0; i < node.size(); i++) {
-                    matrix(i) = parse_math_string<typename T::Scalar>(node[i].as<std::string>());
-                }
+            std::vector<std::string> elements;
+            elements.reserve(node.size());
+            for (size_t i = 0; i < node.size(); i++) {
+                elements.push_back(node[i].as<std::string>());
             }
-            catch (const std::invalid_argument& ex) {
-                throw std::invalid_argument(fmt::format("Unable to convert node to arithmetic type.\n{}", ex.what()));
+            const auto values = parse_elements<typename T::Scalar>(elements);
+
+            T matrix;
+            for (size_t i = 0; i < node.size(); i++) {
+                matrix(i) = values[i];
             }
 
             return matrix;
@@ -160,17 +166,20 @@ namespace utility::support {
             }
 
 
-            T matrix;
-
-            try {
-                for (size_t row = 0; row < rows; row++) {
-                    for (size_t col = 0; col < cols; col++) {
-                        matrix(col, row) = parse_math_string<typename T::Scalar>(node[row][col].as<std::string>());
-                    }
+            std::vector<std::string> elements;
+            elements.reserve(rows * cols);
+            for (size_t row = 0; row < rows; row++) {
+                for (size_t col = 0; col < cols; col++) {
+                    elements.push_back(node[row][col].as<std::string>());
                 }
             }
-            catch (const std::invalid_argument& ex) {
-                throw std::invalid_argument(fmt::format("Unable to convert node to arithmetic type.\n{}", ex.what()));
+            const auto values = parse_elements<typename T::Scalar>(elements);
+
+            T matrix;
+            for (size_t row = 0; row < rows; row++) {
+                for (size_t col = 0; col < cols; col++) {
+                    matrix(col, row) = values[row * cols + col];
+                }
             }
 
             return matrix;
@@ -195,17 +204,20 @@ namespace utility::support {
                 }
             }
 
-            T matrix(rows, cols);
-
-            try {
-                for (size_t row = 0; row < rows; row++) {
-                    for (size_t col = 0; col < cols; col++) {
-                        matrix(row, col) = parse_math_string<typename T::Scalar>(node[row][col].as<std::string>());
-                    }
+            std::vector<std::string> elements;
+            elements.reserve(rows * cols);
+            for (size_t row = 0; row < rows; row++) {
+                for (size_t col = 0; col < cols; col++) {
+                    elements.push_back(node[row][col].as<std::string>());
                 }
             }
-            catch (const std::invalid_argument& ex) {
-                throw std::invalid_argument(fmt::format("Unable to convert node to arithmetic type.\n{}", ex.what()));
+            const auto values = parse_elements<typename T::Scalar>(elements);
+
+            T matrix(rows, cols);
+            for (size_t row = 0; row < rows; row++) {
+                for (size_t col = 0; col < cols; col++) {
+                    matrix(row, col) = values[row * cols + col];
+                }
             }
 
             return matrix;
@@ -230,15 +242,16 @@ namespace utility::support {
                 }
             }
 
-            T matrix(rows, std::max(cols, size_t(1)));
-
-            try {
-                for (size_t i = 0; i < rows; i++) {
-                    matrix(i) = parse_math_string<typename T::Scalar>(node[i].as<std::string>());
-                }
+            std::vector<std::string> elements;
+            elements.reserve(rows);
+            for (size_t i = 0; i < rows; i++) {
+                elements.push_back(node[i].as<std::string>());
             }
-            catch (const std::invalid_argument& ex) {
-                throw std::invalid_argument(fmt::format("Unable to convert node to arithmetic type.\n{}", ex.what()));
+            const auto values = parse_elements<typename T::Scalar>(elements);
+
+            T matrix(rows, std::max(cols, size_t(1)));
+            for (size_t i = 0; i < rows; i++) {
+                matrix(i) = values[i];
             }
 
             return matrix;
@@ -263,22 +276,40 @@ namespace utility::support {
                 }
             }
 
+            std::vector<std::string> elements;
+            elements.reserve(rows);
+            for (size_t i = 0; i < rows; i++) {
+                elements.push_back(node[i][0].as<std::string>());
+            }
+            const auto values = parse_elements<typename T::Scalar>(elements);
+
             T matrix(cols, rows);
+            for (size_t i = 0; i < rows; i++) {
+                matrix(i) = values[i];
+            }
+
+            return matrix;
+        }
+
 
+    private:
+        /**
+         * Evaluates all of the elements of a vector or matrix in a single pass.
+         *
+         * @param elements the expressions for each element in the order they should be returned
+         *
+         * @return the value of each of the elements
+         */
+        template <typename Scalar>
+        static std::vector<Scalar> parse_elements(const std::vector<std::string>& elements) {
             try {
-                for (size_t i = 0; i < rows; i++) {
-                    matrix(i) = parse_math_string<typename T::Scalar>(node[i][0].as<std::string>());
-                }
+                return parse_math_strings<Scalar>(elements);
             }
             catch (const std::invalid_argument& ex) {
                 throw std::invalid_argument(fmt::format("Unable to convert node to arithmetic type.\n{}", ex.what()));
             }
-
-            return matrix;
         }
 
-
-    private:
         YAML::Node node;
     };
 
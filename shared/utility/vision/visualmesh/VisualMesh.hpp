@@ -150,20 +150,15 @@ namespace utility::vision::visualmesh {
             return false;
         };
 
+        // Build the half-planes of the horizon once so each cluster can be tested against them as a whole
+        using Side = utility::math::geometry::ConvexPolygon::Side;
+        const utility::math::geometry::ConvexPolygon polygon(horizon);
+
         // Move any clusters that don't intersect the green horizon to the end of the list
         // We need to find one point above the green horizon and one below it
         return std::partition(clusters.begin(), clusters.end(), [&](const std::vector<int>& cluster) {
-            bool out = false;
-            bool in  = false;
-
-            for (unsigned int idx = 0; idx < cluster.size(); ++idx) {
-                bool position =
-                    utility::math::geometry::point_in_convex_hull(horizon, Eigen::Vector3d(rays.col(cluster[idx])));
-                // Only set if it is in or out as we want to find across the cluster
-                in  = position ? true : in;
-                out = !position ? true : out;
-            }
-            return success(out, in);
+            const Side side = polygon.classify(cluster, rays);
+            return success(side == Side::OUTSIDE || side == Side::BOTH, side == Side::INSIDE || side == Side::BOTH);
         });
     }
 }  // namespace utility::vision::visualmesh
@@ -0,0 +1,159 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 NUbots
+ *
+ * This file is part of the NUbots codebase.
+ * See https://github.com/NUbots/NUbots for further info.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef UTILITY_VISION_VISUALMESH_MERGE_CLUSTERS_HPP
+#define UTILITY_VISION_VISUALMESH_MERGE_CLUSTERS_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace utility::vision::visualmesh {
+
+    /**
+     * @brief Merges clusters whose ranges of some scalar key overlap, such as the bearing of the points in a goal post
+     *
+     * @details
+     *  Clusters are visited in order and each one absorbs every later cluster whose [min, max] range of the key
+     *  overlaps its own original range. Absorbed clusters are appended in their original order and removed from the
+     *  list. This is the same result as testing every later cluster against each cluster in turn. However the range of
+     *  each cluster is only calculated once, and the overlapping clusters are found by sweeping over the clusters
+     *  sorted by the start of their range, so it takes O(n log n) rather than O(n²) range tests.
+     *
+     * @tparam Func the type of the key function
+     *
+     * @param clusters the clusters of point indices to merge, modified in place
+     * @param key      function from a point index to the value whose range is compared
+     */
+    template <typename Func>
+    void merge_overlapping_clusters(std::vector<std::vector<int>>& clusters, Func&& key) {
+        const int n = int(clusters.size());
+        if (n < 2) {
+            return;
+        }
+
+        // The range of the key over each cluster, empty clusters have an empty range and overlap nothing
+        std::vector<double> lo(n, std::numeric_limits<double>::infinity());
+        std::vector<double> hi(n, -std::numeric_limits<double>::infinity());
+        for (int i = 0; i < n; ++i) {
+            for (const int& idx : clusters[i]) {
+                const double k = key(idx);
+                lo[i]          = std::min(lo[i], k);
+                hi[i]          = std::max(hi[i], k);
+            }
+        }
+
+        // Order the clusters by the start of their range
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](const int& a, const int& b) { return lo[a] < lo[b]; });
+        std::vector<int> position(n);
+        for (int p = 0; p < n; ++p) {
+            position[order[p]] = p;
+        }
+
+        // A max tree over the end of the range of every cluster that has not yet been visited or merged, in the same
+        // order as the sorted clusters
+        int size = 1;
+        while (size < n) {
+            size <<= 1;
+        }
+        std::vector<double> tree(2 * size, -std::numeric_limits<double>::infinity());
+        for (int p = 0; p < n; ++p) {
+            tree[size + p] = hi[order[p]];
+        }
+        for (int t = size - 1; t > 0; --t) {
+            tree[t] = std::max(tree[2 * t], tree[2 * t + 1]);
+        }
+        auto remove = [&](int p) {
+            int t   = size + p;
+            tree[t] = -std::numeric_limits<double>::infinity();
+            for (t /= 2; t > 0; t /= 2) {
+                tree[t] = std::max(tree[2 * t], tree[2 * t + 1]);
+            }
+        };
+
+        // The first sorted position before end whose range reaches at least as far as value, or -1 if there is none
+        auto first_reaching = [&](auto&& self, int node, int node_lo, int node_hi, int end, double value) -> int {
+            if (node_lo >= end || tree[node] < value) {
+                return -1;
+            }
+            if (node_hi - node_lo == 1) {
+                return node_lo;
+            }
+            const int mid  = (node_lo + node_hi) / 2;
+            const int left = self(self, 2 * node, node_lo, mid, end, value);
+            return left >= 0 ? left : self(self, 2 * node + 1, mid, node_hi, end, value);
+        };
+
+        std::vector<bool> merged(n, false);
+        std::vector<int> absorbed;
+        for (int i = 0; i < n; ++i) {
+            if (merged[i]) {
+                continue;
+            }
+            // Every cluster before this one that survived didn't overlap it, so only later clusters remain in the tree
+            remove(position[i]);
+
+            // Clusters that start after this one ends can't overlap it, of those before that we need the ones that
+            // end after this one starts
+            auto starts_after = [&](const double& v, const int& c) { return v < lo[c]; };
+            auto last         = std::upper_bound(order.begin(), order.end(), hi[i], starts_after);
+            const int end     = int(std::distance(order.begin(), last));
+            absorbed.clear();
+            for (int p = first_reaching(first_reaching, 1, 0, size, end, lo[i]); p >= 0;
+                 p     = first_reaching(first_reaching, 1, 0, size, end, lo[i])) {
+                absorbed.push_back(order[p]);
+                merged[order[p]] = true;
+                remove(p);
+            }
+
+            // Append the absorbed clusters in the order they were originally in
+            std::sort(absorbed.begin(), absorbed.end());
+            for (const int& j : absorbed) {
+                clusters[i].insert(clusters[i].end(), clusters[j].begin(), clusters[j].end());
+            }
+        }
+
+        // Remove the merged clusters, keeping the others in order
+        int out = 0;
+        for (int i = 0; i < n; ++i) {
+            if (!merged[i]) {
+                if (out != i) {
+                    clusters[out] = std::move(clusters[i]);
+                }
+                ++out;
+            }
+        }
+        clusters.resize(out);
+    }
+
+}  // namespace utility::vision::visualmesh
+
+#endif  // UTILITY_VISION_VISUALMESH_MERGE_CLUSTERS_HPP